@@ -1,6 +1,9 @@
 #include "parser.h"
 #include <stdbool.h>
 #include <errno.h>
+#include "../v_str.h"
+/* The JVEC helpers below have their own VEC_append */
+#undef VEC_append
 
 #if SIG_SPRT == 1
 #include <signal.h>
@@ -93,6 +96,7 @@ typedef struct {
     uint8_t indent_width;
     uint8_t sorted;
     uint8_t raw;
+    VEC_str *out; /* if not NULL, dumpbf appends to *out instead of printing */
 } printfmt;
 
 /* obj stack */
@@ -792,7 +796,7 @@ __NONNULL__ static __inline__ void *lexer(JsonObject obj, JsonString bf, ssize_t
  * __dump__
  */
 __NONNULL__ static ssize_t dump(JsonObject self, ...) {
-    printfmt fmt;
+    printfmt fmt = {' ', 4, 0, 0, NULL};
 #if !defined( NOBJ_BUFFERING)
     dumpbf(self, &fmt);
 #else
@@ -800,42 +804,33 @@ __NONNULL__ static ssize_t dump(JsonObject self, ...) {
 }
 
 __NONNULL__ ssize_t dumpbf(JsonObject self, printfmt *fmt) {
-    JsonString buf;
+    VEC_str out;
     JsonData data;
-    size_t szbuf, sztbe;
-
-    szbuf = self->__szbuf;
-    if (!self->__buf && !(self->__buf = malloc((szbuf = sizeof(JsonChar) * 1024)))) {
-	throwError(ENOMEM, NULL);
-	return -1;
+    size_t bkt, len;
+    uint8_t w;
+
+    out = fmt->out ? *fmt->out : VEC_strNew(1024);
+    len = VEC_strLen(out);
+
+    VEC_strCat(&out, "{\n");
+    for (bkt = 0; bkt < self->__hashBkt; bkt++) {
+	for (data = self->__head[bkt]; data; data = data->__nd) {
+	    VEC_strReserve(&out, fmt->indent_width);
+	    for (w = 0; w < fmt->indent_width; w++)
+		VEC_strPutc(&out, fmt->indent_char);
+	    VEC_strAppendf(&out, "%s: %s,\n", data->__key, data->__str);
+	}
     }
-    self->__szbuf = szbuf;
-    buf = self->__buf;
+    VEC_strCat(&out, "}\n");
 
-    *buf++ = JS_CH('{');
-    *buf++ = JS_CH('\n');
-    szbuf -= 2;
-
-    data = self->__head[0];
-    while ((sztbe < self->__hashBkt) || data) {
-	if (data == NULL) {
-	    data = self->__head[sztbe++];
-	    continue;
-	}
-	do {
-	    *buf++ = fmt->indent_char;
-	    szbuf--;
-	} while (--fmt->indent_width);
-	/* TODO: REMOVE ASSUMPTIONS: sz is sufficient and no error */
-	buf += snprintf(buf, szbuf - 2, "%s: %s,\n", data->__key, data->__str);
-	data = data->__nd;
-    }
-    *buf++ = JS_CH('}');
-    *buf++ = JS_CH('\n');
-    *buf = 0;
-
-    szbuf = fprintf(stdout, "%s", (JsonString)self->__buf);
-    return szbuf;
+    len = VEC_strLen(out) - len;
+    if (fmt->out) {
+	*fmt->out = out;
+	return len;
+    }
+    len = fwrite(out, 1, len, stdout);
+    VEC_strDestroy(out);
+    return len;
 }
 __NONNULL__ void JsonMemcpy(void *dest, void *src, ssize_t sz) {
     ssize_t chk;
@@ -0,0 +1,42 @@
+/* DTOA HEADER FILE
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef MVPG_DTOA
+#define MVPG_DTOA
+
+#include "include.h"
+
+
+/***********************************************************************
+
+* SHORTEST ROUND-TRIP FLOATING POINT TO DECIMAL
+
+***********************************************************************/
+
+/* mvpgDtoa(F, BF, FMT), mvpgFtoa(F, BF, FMT): write the double (float) F at BF, with the fewest significant digits that read back
+ * (strtod, strtof) as F; of those, the closest to F. Returns the length, the '\0' (written) excluded.
+ * FMT:
+ * 'g' - "%g" form at that precision: exponent form if the decimal exponent X < -4 or X >= digits, else fixed ("0.001", "1e+20")
+ * 'e' - exponent form: d[.ddd]e(+|-)XX
+ * 'f' - fixed form, never an exponent ("100000000000000000000", "0.0000001")
+ * Infinities and NaNs are written "inf", "nan" (sign first if set), as printf does.
+ *
+ * MVPG_DTOA_LEN (MVPG_FTOA_LEN) is the longest 'g' or 'e' output, MVPG_DTOA_FLEN (MVPG_FTOA_FLEN) the longest 'f' output
+ * (the '\0' excluded).
+ */
+#define MVPG_DTOA_LEN  24  /* -d.dddddddddddddddde-XXX */
+#define MVPG_DTOA_FLEN 343 /* -0.<323 zeros><17 digits> */
+#define MVPG_FTOA_LEN  15  /* -d.dddddddde-XX */
+#define MVPG_FTOA_FLEN 56  /* -0.<44 zeros><9 digits> */
+
+__NONNULL__ unsigned int mvpgDtoa(double f, char *bf, char fmt);
+__NONNULL__ unsigned int mvpgFtoa(float f, char *bf, char fmt);
+
+#endif
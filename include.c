@@ -10,15 +10,13 @@ You should have received a copy of the GNU General Public License along with thi
 */
 
 #include "include.h"
+#include <stdatomic.h>
+#if !__WINDOWS__
+    #include <pthread.h>
+    #include <unistd.h>
+#endif
 
 #define BOOL(n)        !!(n)
-#define TO_CHAR(n) ((n) | 0x30)
-
-#ifndef __ARM_CPU__
-    #define MACR_DIV10(n) ((n) / 10)
-#else
-    #define MACR_DIV10(n) (((n) * 0x1999999Aull) >> 32)
-#endif
 
 __STATIC_FORCE_INLINE_F void *rotbuf(char *b, size_t i){
   char *e, c;
@@ -30,17 +28,21 @@ __STATIC_FORCE_INLINE_F void *rotbuf(char *b, size_t i){
   }
 }
 
+const char MvpgInclude_Digits2[200] =
+  "00010203040506070809" "10111213141516171819" "20212223242526272829" "30313233343536373839" "40414243444546474849"
+  "50515253545556575859" "60616263646566676869" "70717273747576777879" "80818283848586878889" "90919293949596979899";
+
+const uint64_t MvpgInclude_Pow10[20] =
+  {
+   0, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull, 100000000ull, 1000000000ull,
+   10000000000ull, 100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull,
+   1000000000000000ull, 10000000000000000ull, 100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+  };
+
 __STATIC_FORCE_INLINE_F uintmax_t strDec(uintmax_t n, char *bf){
-  register uintmax_t quot, i;
+  const uintmax_t i = MvpgInclude_Utoa10(n, bf);
 
-  for (i = 0; n > 0; i++){
-    quot  = MACR_DIV10(n);
-    bf[i] = TO_CHAR(n - (quot * 10));
-    n     = quot;
-  }
-  rotbuf(bf, i);
   bf[i] = 0;
-
   return i;
 }
 
@@ -51,27 +53,129 @@ __STATIC_FORCE_INLINE_F uintmax_t strHex(uintmax_t n, char *bf){
   bf[1] = 'x';
   bf += 2;
 
-  for (i = 0; n > 0; i++) {
-    quot  = n >> 4;
-    bf[i] = "0123456789abcdef"[(n & 0x0f)];
-    n     = quot;
-  }
+  i = 0;
+  do {
+    quot    = n >> 4;
+    bf[i++] = "0123456789abcdef"[(n & 0x0f)];
+    n       = quot;
+  } while (n > 0);
   rotbuf(bf, i);
   bf[i] = 0;
 
-  return i;
+  return i + 2;
 }
 
 /* INTEGER TO STRING */
 uintmax_t MvpgInclude_Itoa(uintmax_t n, char *bf, uint8_t base, uint8_t lt){
 
   if ( lt ) {
-    n = -(intmax_t)n;
+    n = -n;
     *bf++ = '-';
   }
   return (base == 16 ? strHex : strDec)(n, bf) + !!lt;
 }
 
+/* HASH */
+#define HASH_M64 0xc6a4a7935bd1e995ull
+#define HASH_R64 47
+
+uint64_t MvpgInclude_Hash64(const void *key, size_t n, uint64_t seed) {
+  /* MurmurHash64A: mixes 8 bytes per step; words are read with memcpy, so key need not be aligned */
+
+  const unsigned char *p = key, *e = p + (n & ~(size_t)7);
+  uint64_t h, k;
+
+  for (h = seed ^ (n * HASH_M64); p != e; p += 8) {
+    memcpy(&k, p, 8);
+    k *= HASH_M64;
+    k ^= k >> HASH_R64;
+    k *= HASH_M64;
+    h ^= k;
+    h *= HASH_M64;
+  }
+
+  switch (n & 7) {
+  case 7: h ^= (uint64_t)p[6] << 48; /* fallthrough */
+  case 6: h ^= (uint64_t)p[5] << 40; /* fallthrough */
+  case 5: h ^= (uint64_t)p[4] << 32; /* fallthrough */
+  case 4: h ^= (uint64_t)p[3] << 24; /* fallthrough */
+  case 3: h ^= (uint64_t)p[2] << 16; /* fallthrough */
+  case 2: h ^= (uint64_t)p[1] << 8;  /* fallthrough */
+  case 1: h ^= (uint64_t)p[0];
+    h *= HASH_M64;
+  }
+  h ^= h >> HASH_R64;
+  h *= HASH_M64;
+  h ^= h >> HASH_R64;
+
+  return h;
+}
+
+/* THREADS */
+size_t MvpgInclude_Ncpu(void) {
+  /* Concurrent first calls store the same count */
+  static _Atomic size_t ncpu;
+  size_t c;
+  long n;
+
+  if (! (c = atomic_load_explicit(&ncpu, memory_order_relaxed))) {
+    n = -1;
+#if defined(_SC_NPROCESSORS_ONLN)
+    n = sysconf(_SC_NPROCESSORS_ONLN);
+#endif
+    c = n > 0 ? (size_t)n : 1;
+    atomic_store_explicit(&ncpu, c, memory_order_relaxed);
+  }
+  return c;
+}
+
+#if !__WINDOWS__
+typedef struct {
+  void  (*fn)(void *, size_t);
+  void   *arg;
+  size_t  i;
+} ParallelTask;
+
+static void *parallelStart(void *a) {
+  ParallelTask *t = a;
+
+  t->fn(t->arg, t->i);
+  return NULL;
+}
+#endif
+
+void MvpgInclude_Parallel(void (*fn)(void *, size_t), void *arg, size_t n) {
+  /* Task 0 runs on the caller; a task whose thread can't be created runs on the caller too */
+#if !__WINDOWS__
+  pthread_t    tid[MVPG_MAXTHREADS];
+  ParallelTask task[MVPG_MAXTHREADS];
+  bool         started[MVPG_MAXTHREADS];
+  size_t       i;
+
+  debugAssert(n <= MVPG_MAXTHREADS, "MvpgInclude_Parallel: too many tasks");
+
+  for (i = 1; i < n; i++) {
+    task[i].fn  = fn;
+    task[i].arg = arg;
+    task[i].i   = i;
+    started[i]  = pthread_create(tid + i, NULL, parallelStart, task + i) == 0;
+  }
+  if (n)
+    fn(arg, 0);
+  for (i = 1; i < n; i++) {
+    if (started[i])
+      pthread_join(tid[i], NULL);
+    else
+      fn(arg, i);
+  }
+#else
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    fn(arg, i);
+#endif
+}
+
 /* STRINGS */
 size_t MvpgInclude_strlcpy(char **dest, char *src, size_t n) {
   debugAssert(0, "MvpgInclude_strlcpy: uimplemented");
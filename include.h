@@ -71,6 +71,44 @@ You should have received a copy of the GNU General Public License along with thi
 
 #define __STATIC_FORCE_INLINE_F static __inline__ __FORCE_INLINE__
 
+/* Software prefetch of address P for reading (RW == 0) or writing (RW == 1) */
+#if __GNUC_LLVM__
+    #define PREFETCH(P, RW) __builtin_prefetch(P, RW)
+#else
+    #define PREFETCH(P, RW) PASS
+#endif
+
+/* Population count and count of trailing (leading) zeros (X != 0) of a 64-bit word */
+#if __GNUC_LLVM__
+    #define POPCNT64(X) __builtin_popcountll(X)
+    #define CTZ64(X)    __builtin_ctzll(X)
+    #define CLZ64(X)    __builtin_clzll(X)
+#else
+__STATIC_FORCE_INLINE_F int POPCNT64(uint64_t x) {
+  int c;
+
+  for (c = 0; x; c++)
+    x &= x - 1;
+  return c;
+}
+
+__STATIC_FORCE_INLINE_F int CTZ64(uint64_t x) {
+  int c;
+
+  for (c = 0; !(x & 1); c++)
+    x >>= 1;
+  return c;
+}
+
+__STATIC_FORCE_INLINE_F int CLZ64(uint64_t x) {
+  int c;
+
+  for (c = 0; !(x >> 63); c++)
+    x <<= 1;
+  return c;
+}
+#endif
+
 
 /***********************************************************************
 
@@ -155,9 +193,51 @@ void _debugAssert(const char *, const unsigned long int, const char *, const cha
 /* Copy n bytes from src to dest; deviates from strlcpy in that dest is updated to dest + n, on return  */
 size_t MvpgInclude_strlcpy(char **, char *, size_t);
 
-/* Convert integer to string */;
+/* Convert integer to string (base 10 or 16, 0x prefixed); a '-' first if the last argument is set. Returns the length, the '\0' excluded */
 uintmax_t MvpgInclude_Itoa(uintmax_t, char *, uint8_t, uint8_t);
 
+/* Decimal digits: "00" "01" ... "99", and 0 followed by the powers of 10 up to 10^19 */
+extern const char     MvpgInclude_Digits2[200];
+extern const uint64_t MvpgInclude_Pow10[20];
+
+__STATIC_FORCE_INLINE_F unsigned int MvpgInclude_DecLen(uint64_t n) {
+  /* Count of decimal digits of n: floor(log10(2) * bits) (1233 / 4096 ~ log10(2)), plus one if n reaches the next power of 10 */
+  const unsigned int t = ((64 - CLZ64(n | 1)) * 1233) >> 12;
+
+  return t + (n >= MvpgInclude_Pow10[t]);
+}
+
+__STATIC_FORCE_INLINE_F unsigned int MvpgInclude_Utoa10(uint64_t n, char *bf) {
+  /* Write the decimal digits of n at bf (no '\0'), two at a time from the last, to their final place; returns their count */
+  const unsigned int len = MvpgInclude_DecLen(n);
+  char *e = bf + len;
+  uint64_t q;
+
+  while (n >= 100) {
+    q = n / 100;
+    e -= 2;
+    memcpy(e, MvpgInclude_Digits2 + 2 * (n - q * 100), 2);
+    n = q;
+  }
+  if (n >= 10)
+    memcpy(e - 2, MvpgInclude_Digits2 + 2 * n, 2);
+  else
+    e[-1] = (char)('0' + n);
+  return len;
+}
+
+/* 64-bit hash of n bytes (word at a time) */
+uint64_t MvpgInclude_Hash64(const void *, size_t, uint64_t);
+
+/* Online processors (1 if unknown) */
+size_t MvpgInclude_Ncpu(void);
+
+/* Run fn(arg, i) for i < n (n <= MVPG_MAXTHREADS) on n threads, the caller being one; returns once all are done */
+#ifndef MVPG_MAXTHREADS
+    #define MVPG_MAXTHREADS 64
+#endif
+void MvpgInclude_Parallel(void (*)(void *, size_t), void *, size_t);
+
  /***********************************************************************
 
 * DEBUG
@@ -166,7 +246,7 @@ uintmax_t MvpgInclude_Itoa(uintmax_t, char *, uint8_t, uint8_t);
 #define PASS (void)0
 
 #ifdef MVPG_NDEBUG
-    #define debugAssert(...)
+    #define debugAssert(...) PASS
 #else
     #define debugAssert(expr, ...) (\
  (expr) || (_debugAssert(__FILE__, __LINE__, __FUNCTION__, #expr, MvpgMacro_Select((__VA_ARGS__), "", __VA_ARGS__)), 1) \
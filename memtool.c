@@ -10,6 +10,25 @@ You should have received a copy of the GNU General Public License along with thi
 
 #include "memtool.h"
 
+#if !__WINDOWS__
+    #include <unistd.h>
+    #include <pthread.h>
+#else
+    #include <stdatomic.h>
+#endif
+#if defined(__x86_64__) && __GNUC_LLVM__
+    #include <cpuid.h>
+    #define COPY_X86 1
+#endif
+#if !defined(MVPG_COPY_NOSIMD) && defined(COPY_X86)
+    /* Compiled for AVX whatever the target, run only if copyProbe finds it */
+    #include <immintrin.h>
+    #define COPY_STREAM 1
+#endif
+
+#define COPY_PAGE 4096
+#define COPY_LLC  (1ul << 23) /* Last level cache, when unknown */
+
 /***********************************************************
 
  * ALLOCATOR
@@ -31,15 +50,18 @@ You should have received a copy of the GNU General Public License along with thi
 #if (_POSIX_C_SOURCE >= 200112L) || (_DEFAULT_SOURCE || _BSD_SOURCE || (XOPEN_SOURCE >= 500))
 #define MvpgMalloc(memptr, size) posix_memalign((void *)&memptr, MVPG_ALLOC_MEMALIGN, size)
     #define MvpgDeallocate(memptr)   free(memptr)
+    #define MvpgReallocate(memptr, size) realloc(memptr, size) /* Alignment is checked by mvpgRealloc */
 /* C11 introduced a standard aligned_alloc function */
 #elif __STDC__GTEQ_11__
     #if __WINDOWS__
 #define MvpgMalloc(memptr, size) !(*memptr && (memptr = _aligned_malloc(MVPG_ALLOC_MEMALIGN, size))) /* requires malloc.h */
         #define MvpgDeallocate(memptr) _aligned_free(memptr) /* memory can’t be freed with malloc’s free() */
+        #define MvpgReallocate(memptr, size) _aligned_realloc(memptr, size, MVPG_ALLOC_MEMALIGN)
     #else
 /*__clang__ and __GNUC__ */
         #define MvpgMalloc(memptr, size) !(*memptr && (memptr = aligned_alloc(MVPG_ALLOC_MEMALIGN, size))) /* TODO: size must be multiple of alignment  */
         #define MvpgDeallocate(memptr) free(memptr)
+        #define MvpgReallocate(memptr, size) realloc(memptr, size)
     #endif
 #else
     /* MANUAL MEMALIGN */
@@ -84,11 +106,30 @@ __NONNULL__ static void NativeAlignedFree(void *ptr) {
   free(MV2_INIT_ALLOC(ptr));
 }
 
+__WARN_UNUSED__ __NONNULL__ static void *NativeAlignedRealloc(void *ptr, size_t size) {
+  /**
+     Realloc the unaligned block; if the block moved, the data is moved to the block’s new aligned address
+   */
+  void *nalignedPtr, *alignedPtr;
+  const offset_t offset = MEM_OFFSET_LOC(ptr)[0];
+
+  if (! (nalignedPtr = realloc(MV2_INIT_ALLOC(ptr), size + MAX_ALIGN_OFFSET_SZ)) )
+    return NULL;
+
+  alignedPtr = (void *)ALIGN_UP_MEMALIGN((uintptr_t)nalignedPtr + MAX_ALIGN_OFFSET_SZ);
+  if ((uintptr_t)alignedPtr - (uintptr_t)nalignedPtr != offset)
+    memmove(alignedPtr, (char *)nalignedPtr + offset, size);
+  MEM_OFFSET_LOC(alignedPtr)[0] = (uintptr_t)alignedPtr - (uintptr_t)nalignedPtr;
+
+  return alignedPtr;
+}
+
 /******************************************************************************************/
 
     /* Define manual implementation as fallback */
     #define MvpgMalloc(memptr, size) NativeAlignedAlloc(&memptr, MVPG_ALLOC_MEMALIGN, size)
     #define MvpgDeallocate(memptr)   NativeAlignedFree(memptr)
+    #define MvpgReallocate(memptr, size) NativeAlignedRealloc(memptr, size)
 
 #endif
 
@@ -107,12 +148,27 @@ __NONNULL__ void *mvpgAlloc(const size_t size, const size_t offset) {
   return memAllocPtr;
 }
 
-__WARN_UNUSED__ __NONNULL__ void *mvpgRealloc(void *memptr __MB_UNUSED__, size_t newsize __MB_UNUSED__) {
+__WARN_UNUSED__ __NONNULL__ void *mvpgRealloc(void *memptr, size_t newsize) {
+  /* Resize Block (memptr is the block returned by mvpgAlloc, less its offset).
+   * A shrinking block is released in place by the system allocator (mremap for page-backed blocks).
+   * If the resized block lost its alignment, it is copied to a new aligned block.
+   */
+
+  char *memAllocPtr, *alignedPtr;
 
-  /* NOT IMPLEMENTED */
-  assert( ("MVPGREALLOC: NOT IMPLEMENTED", 0) );
+  assert( newsize != 0 );
+  memAllocPtr = MvpgReallocate(memptr, newsize);
+  assert( memAllocPtr != NULL );
 
-  return NULL;
+  if ( MOD2((uintptr_t)memAllocPtr, MVPG_ALLOC_MEMALIGN) ) {
+    alignedPtr = NULL;
+    MvpgMalloc(alignedPtr, newsize);
+    assert( alignedPtr != NULL );
+    mvpgMemcpy(alignedPtr, memAllocPtr, newsize);
+    MvpgDeallocate(memAllocPtr);
+    memAllocPtr = alignedPtr;
+  }
+  return memAllocPtr;
 }
 
 
@@ -121,3 +177,141 @@ void mvpgDealloc(void *memptr) {
 
   MvpgDeallocate(memptr);
 }
+
+
+/***********************************************************
+
+ * LARGE COPY
+
+************************************************************/
+
+static struct {
+  size_t  nt;   /* Non-temporal copy threshold */
+  uint8_t erms; /* Enhanced rep movsb */
+  uint8_t avx;  /* AVX, enabled by the OS */
+#if __WINDOWS__
+  _Atomic uint8_t init; /* 0: not probed, 1: probing, 2: probed (the fields are published with release) */
+#endif
+} copyCpu;
+
+static void copyProbe(void) {
+  long llc = -1;
+
+#ifdef COPY_X86
+  unsigned int a, b, c, d;
+
+  if (__get_cpuid_count(7, 0, &a, &b, &c, &d))
+    copyCpu.erms = (b >> 9) & 1;
+  if (__get_cpuid(1, &a, &b, &c, &d) && ((c >> 27) & 1) && ((c >> 28) & 1)) {
+    /* OSXSAVE and AVX: the OS must also save the YMM state (XCR0 bits 1, 2) */
+    __asm__ ("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+    copyCpu.avx = (a & 6) == 6;
+  }
+#endif
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+  llc = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+  copyCpu.nt   = MVPG_COPY_NT ? MVPG_COPY_NT : (llc > 0 ? (size_t)llc : COPY_LLC) / 2;
+}
+
+#ifdef COPY_STREAM
+__attribute__((target("avx"))) __NONNULL__ static void copyStream(char *d, const char *s, size_t n) {
+  /* Up to a 32 bytes aligned destination, then 128 bytes per step of streaming stores (the source read 1KB ahead), then the tail.
+   * A copy shorter than the alignment prefix and one step is a plain memcpy */
+  const size_t h = -(uintptr_t)d & 31;
+  __m256i a, b, c, e;
+
+  if (n < h + 128) {
+    memcpy(d, s, n);
+    return;
+  }
+  memcpy(d, s, h);
+  for (d += h, s += h, n -= h; n >= 128; n -= 128, d += 128, s += 128) {
+    PREFETCH(s + 1024, 0);
+    a = _mm256_loadu_si256((const __m256i *)s);
+    b = _mm256_loadu_si256((const __m256i *)s + 1);
+    c = _mm256_loadu_si256((const __m256i *)s + 2);
+    e = _mm256_loadu_si256((const __m256i *)s + 3);
+    _mm256_stream_si256((__m256i *)d, a);
+    _mm256_stream_si256((__m256i *)d + 1, b);
+    _mm256_stream_si256((__m256i *)d + 2, c);
+    _mm256_stream_si256((__m256i *)d + 3, e);
+  }
+  _mm_sfence();
+  memcpy(d, s, n);
+}
+#endif
+
+__NONNULL__ static void copyRun(char *d, const char *s, size_t n, bool stream) {
+#ifdef COPY_STREAM
+  if (stream) {
+    copyStream(d, s, n);
+    return;
+  }
+#else
+  MvpgMacro_Ignore(stream);
+#endif
+#ifdef COPY_X86
+  if (copyCpu.erms) {
+    __asm__ __volatile__ ("rep movsb" : "+D" (d), "+S" (s), "+c" (n) : : "memory");
+    return;
+  }
+#endif
+  memcpy(d, s, n);
+}
+
+typedef struct {
+  char       *d;
+  const char *s;
+  size_t      n, part, nparts;
+  bool        stream;
+} CopyTask;
+
+static void copyPart(void *arg, size_t i) {
+  /* Parts of t->part bytes; the last takes the remainder */
+  CopyTask *t = arg;
+  const size_t b = i * t->part, e = t->n - b > t->part ? b + t->part : t->n;
+
+  copyRun(t->d + b, t->s + b, e - b, t->stream);
+}
+
+__NONNULL__ void *mvpgCopy(void *dest, const void *src, const size_t n) {
+  size_t max, nt;
+  CopyTask t;
+
+#if !__WINDOWS__
+  static pthread_once_t once = PTHREAD_ONCE_INIT;
+
+  pthread_once(&once, copyProbe);
+#else
+  uint8_t st = 0;
+
+  if (atomic_load_explicit(&copyCpu.init, memory_order_acquire) != 2) {
+    if (atomic_compare_exchange_strong(&copyCpu.init, &st, 1)) {
+      copyProbe();
+      atomic_store_explicit(&copyCpu.init, 2, memory_order_release);
+    }
+    while (atomic_load_explicit(&copyCpu.init, memory_order_acquire) != 2)
+      PASS;
+  }
+#endif
+
+  t.d      = dest;
+  t.s      = src;
+  t.n      = n;
+  t.stream = copyCpu.avx && (n >= copyCpu.nt);
+
+  max = MVPG_COPY_THREADS ? MVPG_COPY_THREADS : MvpgInclude_Ncpu();
+  max = max > MVPG_MAXTHREADS ? MVPG_MAXTHREADS : max;
+  nt  = n / MVPG_COPY_PARMIN;
+  nt  = nt > max ? max : nt;
+
+  if (nt < 2) {
+    copyRun(t.d, t.s, n, t.stream);
+    return dest;
+  }
+  t.part   = NXTMUL((n + nt - 1) / nt, COPY_PAGE);
+  t.nparts = (n + t.part - 1) / t.part;
+  MvpgInclude_Parallel(copyPart, &t, t.nparts);
+  return dest;
+}
@@ -27,10 +27,50 @@ You should have received a copy of the GNU General Public License along with thi
 /* Allocate Memory Block Aligned to MVPG_ALLOC_MEMALIGN */
 __NONNULL__ __WARN_UNUSED__ void *mvpgAlloc(const size_t size, const size_t offset);
 
-/* Reallocate Memory Block returned by mvpgAlloc, keep alignment */
+/* Reallocate Memory Block returned by mvpgAlloc (less its offset), keep alignment. Grown memory is not cleared */
 __NONNULL__ __WARN_UNUSED__ void *mvpgRealloc(void *memptr, const size_t size);
 
 /* Free Allocated Block */
 void mvpgDealloc(void *memptr);
 
+
+/***********************************************************************
+
+* LARGE COPY
+
+***********************************************************************/
+
+/* Copies of MVPG_COPY_LARGE bytes or more go to mvpgCopy, which chooses by size and a CPU probe (run once):
+ * - below MVPG_COPY_NT bytes (0: half the last level cache), rep movsb if the CPU has ERMS, else memcpy;
+ * - from MVPG_COPY_NT, AVX non-temporal stores, so that a copy larger than the cache does not evict it;
+ * - from 2 * MVPG_COPY_PARMIN, page aligned parts of at least MVPG_COPY_PARMIN bytes on up to MVPG_COPY_THREADS threads (0: one per processor).
+ * MVPG_COPY_NOSIMD disables the non-temporal stores.
+ */
+#ifndef MVPG_COPY_LARGE
+    #define MVPG_COPY_LARGE (1ul << 12)
+#endif
+#ifndef MVPG_COPY_NT
+    #define MVPG_COPY_NT 0
+#endif
+#ifndef MVPG_COPY_PARMIN
+    #define MVPG_COPY_PARMIN (1ul << 24)
+#endif
+#ifndef MVPG_COPY_THREADS
+    #define MVPG_COPY_THREADS 0
+#endif
+
+/* Copy n bytes from src to dest (which do not overlap) */
+__NONNULL__ void *mvpgCopy(void *dest, const void *src, const size_t n);
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void *mvpgMemcpy(void *dest, const void *src, const size_t n) {
+  return n < MVPG_COPY_LARGE ? memcpy(dest, src, n) : mvpgCopy(dest, src, n);
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void *mvpgMemmove(void *dest, const void *src, const size_t n) {
+  /* Overlapping regions are left to memmove */
+  const bool overlap = ((char *)dest < (const char *)src + n) && ((const char *)src < (char *)dest + n);
+
+  return (n < MVPG_COPY_LARGE) || overlap ? memmove(dest, src, n) : mvpgCopy(dest, src, n);
+}
+
 #endif
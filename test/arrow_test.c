@@ -0,0 +1,209 @@
+/* Arrow C data interface against the exported vectors and pools: every kind, with and without a validity bit vector, borrowed
+ * (the buffers are the vector items) and owned (handed back without copy), and sliced by the consumer (offset, validity shifted);
+ * string pools through Utf8View ("vu"), and "u" / "U" arrays built here, at an offset, imported into a pool.
+ * Build: cc -O2 arrow_test.c ../v_arrow.c ../v_strpool.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+
+#include "../v_arrow.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static const char *const formats[] = {"c", "C", "s", "S", "i", "I", "l", "L", "f", "g"};
+
+/* Bit i of the bit vector m (NULL: all set) */
+static bool bit(const uint64_t *m, vsize_t i) {
+  return m == NULL || ((m[i / 64] >> (i % 64)) & 1);
+}
+
+static uint64_t *randomMask(vsize_t n) {
+  uint64_t *m = VEC_new(n / 64 + 1, uint64_t);
+  vsize_t i;
+
+  for (i = 0; i <= n / 64; i++)
+    m[i] = next() & next(); /* A quarter of the bits set */
+  VEC_vusedSet(m, n / 64 + 1);
+  return m;
+}
+
+static void primitive(VEC_kind k, vsize_t n, bool masked) {
+  const vsize_t dt = VEC_kindSize(k);
+  char *v = VEC_newFrmSize(n | !n, dt), *w;
+  uint64_t *m = masked ? randomMask(n) : NULL, *mw;
+  struct ArrowArray arr;
+  struct ArrowSchema sch;
+  vsize_t i, o, nulls;
+
+  for (i = 0; i < n * dt; i++)
+    v[i] = (char)next();
+  VEC_vusedSet(v, n);
+  for (i = nulls = 0; i < n; i++)
+    nulls += !bit(m, i);
+
+  /* Borrowed: the buffers are v and m */
+  VEC_toArrow(&arr, &sch, v, k, m, 0);
+  CHECK(!strcmp(sch.format, formats[k]) && (sch.release != NULL) && (!(sch.flags & ARROW_FLAG_NULLABLE) == !masked));
+  CHECK((arr.length == (int64_t)n) && (arr.offset == 0) && (arr.null_count == (int64_t)nulls) && (arr.n_buffers == 2));
+  CHECK((arr.buffers[1] == v) && (arr.buffers[0] == m));
+  CHECK(((uintptr_t)v % 8) == 0);
+
+  /* Sliced by the consumer: a copy, from the offset */
+  o = n ? next() % n : 0;
+  arr.offset  = (int64_t)o;
+  arr.length -= (int64_t)o;
+  w = VEC_fromArrow(&arr, &sch, &mw);
+  CHECK((arr.release == NULL) && (VEC_used(w) == n - o) && (w != v));
+  CHECK(!memcmp(w, v + o * dt, (n - o) * dt));
+  for (i = 0; i < n - o; i++)
+    CHECK(bit(mw, i) == bit(m, o + i));
+  sch.release(&sch);
+  VEC_destroy(w);
+  VEC_destroy(mw);
+
+  /* Owned: handed back as they are */
+  w = VEC_newFrmSize(n | !n, dt);
+  memcpy(w, v, n * dt);
+  VEC_vusedSet(w, n);
+  VEC_toArrow(&arr, &sch, w, k, m, VEC_ARROW_OWN);
+  CHECK(VEC_fromArrow(&arr, &sch, &mw) == w);
+  CHECK((mw == m) && (arr.release == NULL) && (VEC_used(w) == n) && !memcmp(w, v, n * dt));
+  sch.release(&sch);
+
+  VEC_destroy(w);
+  VEC_destroy(m);
+  VEC_destroy(v);
+}
+
+/* "u" and "U" arrays of our own: their release callback only counts its calls */
+static unsigned released;
+
+static void countRelease(struct ArrowArray *arr) {
+  released++;
+  arr->release = NULL;
+}
+
+static void noRelease(struct ArrowSchema *sch) {
+  sch->release = NULL;
+}
+
+static void strings(vsize_t n, bool intern) {
+  VEC_strpool sp, back;
+  char b[64], *data = VEC_new(n * 40 + 1, char);
+  int32_t *o32 = VEC_new(n + 1, int32_t);
+  int64_t *o64 = VEC_new(n + 1, int64_t);
+  const void *bufs[3];
+  struct ArrowArray arr;
+  struct ArrowSchema sch = {0};
+  uint64_t *m = randomMask(n), *mw;
+  const char *s, *t;
+  size_t l, lt;
+  vsize_t i, j, o, len;
+
+  /* Short (inline in the view) and long strings, repeated */
+  VEC_strpoolInit(&sp, 1, 1, intern ? VEC_STRPOOL_INTERN : 0);
+  for (i = 0; i < n; i++) {
+    len = next() % 40;
+    for (j = 0; j < len; j++)
+      b[j] = (char)('a' + next() % ((i % 3) ? 26 : 2));
+    VEC_strpoolPush(&sp, b, len);
+  }
+
+  VEC_strpoolToArrow(&arr, &sch, &sp, m, 0);
+  CHECK(!strcmp(sch.format, "vu") && (arr.length == (int64_t)n) && (arr.n_buffers == 4) && (arr.buffers[2] == sp.sp_bytes));
+  VEC_strpoolInit(&back, 1, 1, 0);
+  VEC_strpoolFromArrow(&back, &arr, &sch, &mw);
+  CHECK((arr.release == NULL) && (VEC_strpoolSize(&back) == n));
+  for (i = 0; i < n; i++) {
+    s = VEC_strpoolGet(&sp, i, &l);
+    t = VEC_strpoolGet(&back, i, &lt);
+    CHECK((l == lt) && !memcmp(s, t, l) && (bit(mw, i) == bit(m, i)));
+  }
+  sch.release(&sch);
+  VEC_strpoolDestroy(&back);
+  VEC_destroy(mw);
+
+  /* Owned: the pool is moved into the array, and freed by its release */
+  VEC_strpoolToArrow(&arr, &sch, &sp, NULL, VEC_ARROW_OWN);
+  CHECK((sp.sp_bytes == NULL) && (sp.sp_offs == NULL));
+  arr.release(&arr);
+  sch.release(&sch);
+
+  /* "u" and "U" from a concatenation, at an offset */
+  o32[0] = 0;
+  o64[0] = 0;
+  for (i = 0; i < n; i++) {
+    len = next() % 40;
+    for (j = 0; j < len; j++)
+      data[o32[i] + j] = (char)('A' + next() % 26);
+    o32[i + 1] = o32[i] + (int32_t)len;
+    o64[i + 1] = o32[i + 1];
+  }
+  for (j = 0; j < 2; j++) {
+    o = n ? next() % n : 0;
+    bufs[0]      = m;
+    bufs[1]      = j ? (const void *)o64 : (const void *)o32;
+    bufs[2]      = data;
+    memset(&arr, 0, sizeof arr);
+    arr.length     = (int64_t)(n - o);
+    arr.offset     = (int64_t)o;
+    arr.null_count = -1;
+    arr.n_buffers  = 3;
+    arr.buffers    = bufs;
+    arr.release    = countRelease;
+    sch.format     = j ? "U" : "u";
+    sch.release    = noRelease;
+
+    released = 0;
+    VEC_strpoolInit(&back, 1, 1, 0);
+    VEC_strpoolFromArrow(&back, &arr, &sch, &mw);
+    CHECK((released == 1) && (VEC_strpoolSize(&back) == n - o));
+    for (i = 0; i < n - o; i++) {
+      t = VEC_strpoolGet(&back, i, &lt);
+      CHECK((lt == (size_t)(o32[o + i + 1] - o32[o + i])) && !memcmp(t, data + o32[o + i], lt) && !t[lt]);
+      CHECK(bit(mw, i) == bit(m, o + i));
+    }
+    VEC_strpoolDestroy(&back);
+    VEC_destroy(mw);
+  }
+
+  VEC_destroy(m);
+  VEC_destroy(data);
+  VEC_destroy(o32);
+  VEC_destroy(o64);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 63, 64, 65, 1000};
+  unsigned k, i;
+
+  for (k = VEC_I8; k <= VEC_F64; k++)
+    for (i = 0; i < sizeof lens / sizeof *lens; i++) {
+      primitive((VEC_kind)k, lens[i], false);
+      primitive((VEC_kind)k, lens[i], true);
+    }
+  for (i = 1; i < sizeof lens / sizeof *lens; i++) {
+    strings(lens[i], false);
+    strings(lens[i], true);
+  }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,90 @@
+/* VEC_newBatch against separately kept arrays: the vectors are laid out in equal, aligned slots of one block; pushed past their
+ * capacity, some move to their own block (and are no longer batch vectors) while the others stay; the contents match, and
+ * VEC_batchDestroy frees each moved vector and the block once (run under AddressSanitizer for leaks and double frees).
+ * Build: cc -O2 batch_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -DVEC_COMPACT_HEADER)
+ */
+
+#include <stdio.h>
+
+#include "../v_base.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+#define NVEC 200
+#define MAXN 100
+
+static void run(vsize_t count, vsize_t cap) {
+  static int64_t ref[NVEC][MAXN];
+  static vsize_t len[NVEC];
+  int64_t *out[NVEC], *at[NVEC];
+  char *blk = VEC_newBatch(count, cap, int64_t, out);
+  vsize_t i, j, slot = 0;
+
+  for (i = 0; i < count; i++) {
+    CHECK((VEC_isbatch(out[i]) != 0) && (VEC_vsize(out[i]) == cap) && (VEC_used(out[i]) == 0) && (VEC_vdtype(out[i]) == sizeof(int64_t)));
+    CHECK(((uintptr_t)out[i] % 8) == 0);
+    at[i] = out[i];
+    if (i == 1)
+      slot = (vsize_t)((char *)out[1] - (char *)out[0]);
+    if (i > 0)
+      CHECK((vsize_t)((char *)out[i] - (char *)out[i - 1]) == slot);
+  }
+  CHECK((count < 2) || ((slot % MVPG_ALLOC_MEMALIGN == 0) && (slot >= cap * sizeof(int64_t))));
+  CHECK((char *)out[0] > blk);
+
+  /* Fill the vectors in turn, past the capacity of some */
+  for (i = 0; i < count; i++)
+    len[i] = next() % (next() % 4 ? cap + 1 : MAXN);
+  for (j = 0; j < MAXN; j++)
+    for (i = 0; i < count; i++)
+      if (j < len[i]) {
+	ref[i][j] = (int64_t)next();
+	VEC_push(out[i], ref[i][j]);
+      }
+
+  for (i = 0; i < count; i++) {
+    CHECK((VEC_used(out[i]) == len[i]) && !memcmp(out[i], ref[i], len[i] * sizeof(int64_t)));
+    /* In its slot while it fits */
+    CHECK(!VEC_isbatch(out[i]) == (len[i] > cap));
+    CHECK((out[i] == at[i]) == (len[i] <= cap));
+  }
+
+  /* Dropped before the batch: a slot is left to the block, a moved vector is freed */
+  i = next() % count;
+  VEC_destroy(out[i]);
+  CHECK(out[i] == NULL);
+
+  VEC_batchDestroy(blk, out, count);
+  CHECK(blk == NULL);
+  for (i = 0; i < count; i++)
+    CHECK(out[i] == NULL);
+}
+
+int main(void) {
+  run(1, 1);
+  run(2, 3);
+  run(7, 16);
+  run(NVEC, 5);
+  run(NVEC, 64);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
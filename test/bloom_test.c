@@ -0,0 +1,120 @@
+/* VEC_bloom against the set of keys it was given: no false negatives (Has, HasAll, after AddAll, Union, Intersect and a
+ * Dump / Load round trip), a false positive rate near the documented one, and VEC_bloomLoad rejecting every truncated dump
+ * and a foreign header.
+ * Build: cc -O2 bloom_test.c ../v_bloom.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -mavx2 for the SIMD blocks)
+ */
+
+#include <stdio.h>
+
+#include "../v_bloom.h"
+#include "../v_filter.h" /* VEC_maskCount */
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+#define NKEYS 20000
+
+/* Keys: 0 .. NKEYS - 1 are added to a, NKEYS / 2 .. 3 * NKEYS / 2 - 1 to b; keys from 4 * NKEYS are never added */
+static void fill(uint64_t *v, uint64_t first, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i < n; i++)
+    v[i] = (first + i) * 0x9E3779B97F4A7C15ull;
+  VEC_vusedSet(v, n);
+}
+
+static void noFalseNegative(const VEC_bloom *f, const uint64_t *keys) {
+  uint64_t *m;
+  vsize_t i, miss;
+
+  for (i = miss = 0; i < VEC_used(keys); i++)
+    miss += !VEC_bloomHas(f, keys + i, sizeof *keys);
+  CHECK(miss == 0);
+
+  m = VEC_bloomHasAll(NULL, f, keys);
+  CHECK(VEC_maskCount(m) == VEC_used(keys));
+  VEC_destroy(m);
+}
+
+static double positives(const VEC_bloom *f, const uint64_t *keys) {
+  vsize_t i, p;
+
+  for (i = p = 0; i < VEC_used(keys); i++)
+    p += VEC_bloomHas(f, keys + i, sizeof *keys);
+  return (double)p / VEC_used(keys);
+}
+
+int main(void) {
+  uint64_t *ka = VEC_new(NKEYS, uint64_t), *kb = VEC_new(NKEYS, uint64_t), *kn = VEC_new(NKEYS, uint64_t), *m;
+  VEC_bloom a = VEC_bloomNew(NKEYS * 2, 12, 7), b = VEC_bloomNew(NKEYS * 2, 12, 7), u, x, l;
+  uint8_t *d = NULL;
+  vsize_t i;
+
+  fill(ka, 0, NKEYS);
+  fill(kb, NKEYS / 2, NKEYS);
+  fill(kn, 4 * NKEYS, NKEYS);
+
+  /* One by one, and in a batch */
+  for (i = 0; i < NKEYS; i++)
+    VEC_bloomAdd(&a, ka + i, sizeof *ka);
+  VEC_bloomAddAll(&b, kb);
+  noFalseNegative(&a, ka);
+  noFalseNegative(&b, kb);
+  CHECK(positives(&a, kn) < 0.02); /* About 0.2% at 24 bits per key */
+
+  /* HasAll agrees with Has, item by item */
+  m = VEC_bloomHasAll(NULL, &a, kn);
+  for (i = 0; i < NKEYS; i++)
+    CHECK(((m[i / 64] >> (i % 64)) & 1) == (uint64_t)VEC_bloomHas(&a, kn + i, sizeof *kn));
+  VEC_destroy(m);
+
+  /* Union: every key of both; intersection: at least the keys of both */
+  d = VEC_bloomDump(d, &a);
+  u = VEC_bloomLoad(d, VEC_used(d));
+  x = VEC_bloomLoad(d, VEC_used(d));
+  VEC_bloomUnion(&u, &b);
+  VEC_bloomIntersect(&x, &b);
+  noFalseNegative(&u, ka);
+  noFalseNegative(&u, kb);
+  for (i = NKEYS / 2; i < NKEYS; i++)
+    CHECK(VEC_bloomHas(&x, ka + i, sizeof *ka));
+
+  /* Round trip: the same blocks, seed and answers */
+  l = VEC_bloomLoad(d, VEC_used(d));
+  CHECK((l.bf_vec != NULL) && (l.bf_nblocks == a.bf_nblocks) && (l.bf_seed == a.bf_seed));
+  CHECK((l.bf_vec != NULL) && !memcmp(l.bf_blocks, a.bf_blocks, a.bf_nblocks * 32));
+  noFalseNegative(&l, ka);
+  VEC_bloomDestroy(&l);
+
+  /* Truncated, at every length short of the dump, and foreign bytes: rejected */
+  for (i = 0; i < VEC_used(d); i += (i < 64) ? 1 : 97) {
+    l = VEC_bloomLoad(d, i);
+    CHECK(l.bf_vec == NULL);
+    VEC_bloomDestroy(&l);
+  }
+  l = VEC_bloomLoad(d, VEC_used(d) - 1);
+  CHECK(l.bf_vec == NULL);
+  d[0] ^= 1;
+  l = VEC_bloomLoad(d, VEC_used(d));
+  CHECK(l.bf_vec == NULL);
+
+  VEC_bloomDestroy(&a);
+  VEC_bloomDestroy(&b);
+  VEC_bloomDestroy(&u);
+  VEC_bloomDestroy(&x);
+  VEC_destroy(d);
+  VEC_destroy(ka);
+  VEC_destroy(kb);
+  VEC_destroy(kn);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
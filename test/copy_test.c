@@ -0,0 +1,120 @@
+/* mvpgCopy, mvpgMemcpy and mvpgMemmove against memcmp with the source (and memmove for overlaps): every misalignment of source
+ * and destination modulo 64, sizes around MVPG_COPY_LARGE, the non-temporal threshold and the multiples of the parallel parts
+ * (where a part may be short or the last one empty), with guard bytes around the destination that must be left as they are.
+ * Build: cc -O2 copy_test.c ../memtool.c ../include.c -lpthread
+ *        (-DMVPG_COPY_PARMIN=4096 -DMVPG_COPY_NT=1 -DMVPG_COPY_THREADS=64 for small non-temporal and parallel copies,
+ *        and with -DMVPG_COPY_NOSIMD)
+ */
+
+#include <stdio.h>
+
+#include "../memtool.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+#define GUARD 64
+#define GBYTE ((char)0xA5)
+
+static bool guarded(const char *d, size_t n) {
+  size_t i;
+
+  for (i = 0; i < GUARD; i++)
+    if ((d[-1 - (ptrdiff_t)i] != GBYTE) || (d[n + i] != GBYTE))
+      return false;
+  return true;
+}
+
+static void copy(size_t n, size_t so, size_t dof) {
+  char *s = malloc(n + 64), *b = malloc(n + 64 + 2 * GUARD), *d = b + GUARD + dof;
+  size_t i;
+
+  for (i = 0; i < n + 64; i++)
+    s[i] = (char)next();
+  memset(b, GBYTE, n + 64 + 2 * GUARD);
+
+  CHECK(mvpgCopy(d, s + so, n) == d);
+  CHECK(!memcmp(d, s + so, n) && guarded(d, n));
+
+  memset(b, GBYTE, n + 64 + 2 * GUARD);
+  CHECK(mvpgMemcpy(d, s + so, n) == d);
+  CHECK(!memcmp(d, s + so, n) && guarded(d, n));
+
+  memset(b, GBYTE, n + 64 + 2 * GUARD);
+  CHECK(mvpgMemmove(d, s + so, n) == d);
+  CHECK(!memcmp(d, s + so, n) && guarded(d, n));
+
+  free(s);
+  free(b);
+}
+
+/* Within one block, by a shift of k bytes either way: as memmove */
+static void overlap(size_t n, size_t k) {
+  char *a = malloc(n + k), *r = malloc(n + k);
+  size_t i;
+
+  for (i = 0; i < n + k; i++)
+    a[i] = r[i] = (char)next();
+  mvpgMemmove(a + k, a, n);
+  memmove(r + k, r, n);
+  CHECK(!memcmp(a, r, n + k));
+  mvpgMemmove(a, a + k, n);
+  memmove(r, r + k, n);
+  CHECK(!memcmp(a, r, n + k));
+
+  free(a);
+  free(r);
+}
+
+int main(void) {
+  static const size_t parts[] = {1, 2, 3, 7, 63, 64, 65, 127, 128, 129};
+  static const ptrdiff_t near[] = {-4096, -1, 0, 1, 4095};
+  size_t n, so, dof, i, j;
+
+  /* Below and around MVPG_COPY_LARGE, every misalignment */
+  for (so = 0; so < 64; so++)
+    for (dof = 0; dof < 64; dof += 7) {
+      copy(so + dof, so, dof);
+      copy(MVPG_COPY_LARGE - 1, so, dof);
+      copy(MVPG_COPY_LARGE + so * 3, so, dof);
+    }
+
+  /* Around multiples of the page and of the parts: k pages of parts (pages) on each thread */
+  for (i = 0; i < sizeof parts / sizeof *parts; i++)
+    for (j = 0; j < sizeof near / sizeof *near; j++) {
+      n = parts[i] * 64 * 4096 / 8 + (size_t)near[j];
+      copy(n, next() % 64, next() % 64);
+      n = parts[i] * 2 * MVPG_COPY_PARMIN + (size_t)near[j];
+      if (n < (1ul << 26))
+	copy(n, next() % 64, next() % 64);
+    }
+
+  /* Random sizes */
+  for (i = 0; i < 200; i++)
+    copy(next() % (1ul << (next() % 22)), next() % 64, next() % 64);
+
+  for (n = 1; n < (1ul << 22); n = n * 3 + 1) {
+    overlap(n, 1);
+    overlap(n, n / 2 + 1);
+    overlap(n, n + 5);
+  }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
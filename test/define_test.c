@@ -0,0 +1,189 @@
+/* VEC_DEFINE vectors against qsort and plain arrays: push (from a capacity of 1), pop, get, resize and map; sort, nth, select,
+ * quantiles and topk on random, sorted, reversed, constant and few-valued inputs, of an arithmetic type (VEC_DEFINE) and of a
+ * struct with its own order (VEC_DEFINE_CMP), whose ties must keep the items whole.
+ * Build: cc -O2 define_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+
+#include "../v_define.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Ordered by key only; tag tells the items apart */
+struct pt {
+  int32_t key;
+  uint32_t tag;
+};
+
+#define PT_LT(a, b) ((a).key < (b).key)
+
+VEC_DEFINE(ivec, int64_t);
+VEC_DEFINE_CMP(pvec, struct pt, PT_LT);
+
+static int cmpI(const void *a, const void *b) {
+  const int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+
+  return (x > y) - (x < y);
+}
+
+static int cmpP(const void *a, const void *b) {
+  const struct pt *x = a, *y = b;
+
+  return (x->key > y->key) - (x->key < y->key);
+}
+
+static int64_t twice(int64_t x) {
+  return 2 * x;
+}
+
+/* Inputs: random, sorted, reversed, constant, few values, organ pipe */
+static int64_t value(unsigned shape, vsize_t i, vsize_t n) {
+  switch (shape) {
+  case 0:  return (int64_t)next() >> (1 + next() % 63); /* Doubled by map */
+  case 1:  return (int64_t)i;
+  case 2:  return (int64_t)(n - i);
+  case 3:  return 7;
+  case 4:  return (int64_t)(next() % 3);
+  default: return (int64_t)(i < n / 2 ? i : n - i);
+  }
+}
+
+static void arith(vsize_t n, unsigned shape) {
+  static const double q[] = {0, 0.25, 0.5, 0.9, 1};
+  int64_t *r = malloc((n | !n) * sizeof *r), out[5];
+  ivec_t v = ivec_new(1), w, t;
+  vsize_t i, j, k, ks[4];
+
+  for (i = 0; i < n; i++) {
+    r[i] = value(shape, i, n);
+    ivec_push(&v, r[i]);
+  }
+  CHECK(VEC_used(v) == n);
+  CHECK(!n || ((ivec_get(v, 0) == r[0]) && (ivec_get(v, -1) == r[n - 1]) && (ivec_get(v, (long)(n / 2)) == r[n / 2])));
+
+  /* Sorted copies */
+  w = ivec_new(n | !n);
+  memcpy(w, v, n * sizeof *r);
+  VEC_vusedSet(w, n);
+  qsort(r, n, sizeof *r, cmpI);
+  ivec_sort(w);
+  CHECK(!memcmp(w, r, n * sizeof *r));
+
+  if (n) {
+    for (j = 0; j < 4; j++) {
+      k = j == 0 ? 0 : j == 1 ? n - 1 : next() % n;
+      memcpy(w, v, n * sizeof *r);
+      ivec_nth(w, k);
+      CHECK(w[k] == r[k]);
+      for (i = 0; i < n; i++)
+	CHECK(i < k ? w[i] <= w[k] : w[i] >= w[k]);
+    }
+
+    /* Ascending ranks */
+    for (i = 0; i < 4; i++)
+      ks[i] = next() % n;
+    for (i = 1; i < 4; i++)
+      for (j = i; j && (ks[j] < ks[j - 1]); j--)
+	k = ks[j], ks[j] = ks[j - 1], ks[j - 1] = k;
+    memcpy(w, v, n * sizeof *r);
+    ivec_select(w, ks, 4);
+    for (i = 0; i < 4; i++)
+      CHECK(w[ks[i]] == r[ks[i]]);
+
+    memcpy(w, v, n * sizeof *r);
+    ivec_quantiles(w, q, 5, out);
+    for (i = 0; i < 5; i++)
+      CHECK(out[i] == r[(vsize_t)(q[i] * (n - 1) + 0.5)]);
+  }
+
+  k = next() % (n + 2);
+  t = ivec_topk(v, k);
+  CHECK(VEC_used(t) == (k < n ? k : n));
+  for (i = 0; i < VEC_used(t); i++)
+    CHECK(t[i] == r[n - 1 - i]);
+  VEC_destroy(t);
+
+  /* map, resize (room for more, nothing lost), pop back to empty */
+  ivec_map(v, twice);
+  ivec_resize(&v, 1000);
+  CHECK((VEC_vsize(v) - VEC_used(v) >= 1000) && (VEC_used(v) == n));
+  qsort(v, n, sizeof *r, cmpI);
+  for (i = 0; i < n; i++)
+    CHECK(v[i] == 2 * r[i]);
+  for (i = n; i-- > 0; )
+    CHECK(ivec_pop(v) == 2 * r[i]);
+  CHECK(VEC_used(v) == 0);
+
+  VEC_destroy(v);
+  VEC_destroy(w);
+  free(r);
+}
+
+static void structs(vsize_t n, unsigned shape) {
+  struct pt *r = malloc((n | !n) * sizeof *r), x;
+  pvec_t v = pvec_new(1), t;
+  uint64_t tags = 0;
+  vsize_t i, k;
+
+  for (i = 0; i < n; i++) {
+    x.key = (int32_t)value(shape, i, n);
+    x.tag = (uint32_t)i * 2654435761u;
+    r[i] = x;
+    pvec_push(&v, x);
+  }
+  t = pvec_topk(v, n / 3);
+
+  /* Keys in order, and the same items (tags) */
+  pvec_sort(v);
+  qsort(r, n, sizeof *r, cmpP);
+  for (i = 0; i < n; i++) {
+    CHECK(v[i].key == r[i].key);
+    tags += (uint64_t)v[i].tag - (uint64_t)r[i].tag;
+  }
+  CHECK(tags == 0);
+
+  for (i = 0; i < VEC_used(t); i++)
+    CHECK(t[i].key == r[n - 1 - i].key);
+
+  if (n) {
+    k = next() % n;
+    pvec_nth(v, k);
+    CHECK(v[k].key == r[k].key);
+  }
+
+  VEC_destroy(t);
+  VEC_destroy(v);
+  free(r);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 2, 3, 16, 17, 100, 1000, 50000};
+  unsigned i, s;
+
+  for (i = 0; i < sizeof lens / sizeof *lens; i++)
+    for (s = 0; s < 6; s++) {
+      arith(lens[i], s);
+      structs(lens[i], s);
+    }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
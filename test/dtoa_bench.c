@@ -0,0 +1,102 @@
+/* Float formatting throughput: snprintf("%.17g"), the shortest "%.*g" precision that reads back (the former VEC_strAppendFlt loop),
+ * and mvpgDtoa / mvpgFtoa ('g'), on 1M values: random bit patterns (finite), uniform in [0, 1), and small integers.
+ * Build: cc -O2 dtoa_bench.c ../dtoa.c ../include.c -lm
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+
+#include "../include.h"
+#include "../dtoa.h"
+
+#define N (1ul << 20)
+
+static double now(void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static uint64_t rnd(void) {
+  static uint64_t s = 88172645463325252ull;
+
+  s ^= s << 13;
+  s ^= s >> 7;
+  s ^= s << 17;
+  return s;
+}
+
+static unsigned int probe(double f, char *p) {
+  int n, prec;
+
+  for (prec = 1; ; prec++) {
+    n = snprintf(p, 32, "%.*g", prec, f);
+    if ((prec >= 17) || (f != f) || (strtod(p, NULL) == f))
+      return n;
+  }
+}
+
+static void run(const char *name, const double *v, const float *w) {
+  static char bf[64];
+  double t[4];
+  size_t i, n;
+
+  t[0] = now();
+  for (i = n = 0; i < N; i++)
+    n += snprintf(bf, sizeof bf, "%.17g", v[i]);
+  t[0] = now() - t[0];
+
+  t[1] = now();
+  for (i = 0; i < N; i++)
+    n += probe(v[i], bf);
+  t[1] = now() - t[1];
+
+  t[2] = now();
+  for (i = 0; i < N; i++)
+    n += mvpgDtoa(v[i], bf, 'g');
+  t[2] = now() - t[2];
+
+  t[3] = now();
+  for (i = 0; i < N; i++)
+    n += mvpgFtoa(w[i], bf, 'g');
+  t[3] = now() - t[3];
+
+  printf("%-10s %10.1f %10.1f %10.1f %10.1f   (%zu)\n", name, t[0] * 1e9 / N, t[1] * 1e9 / N, t[2] * 1e9 / N, t[3] * 1e9 / N, n);
+}
+
+int main(void) {
+  double *v = malloc(N * sizeof *v);
+  float  *w = malloc(N * sizeof *w);
+  uint64_t x;
+  uint32_t y;
+  size_t i;
+
+  printf("%-10s %10s %10s %10s %10s   ns/value\n", "values", "%.17g", "probe", "mvpgDtoa", "mvpgFtoa");
+  for (i = 0; i < N; i++) {
+    do {
+      x = rnd();
+      memcpy(v + i, &x, sizeof x);
+    } while (!isfinite(v[i]));
+    do {
+      y = (uint32_t)rnd();
+      memcpy(w + i, &y, sizeof y);
+    } while (!isfinite(w[i]));
+  }
+  run("bits", v, w);
+
+  for (i = 0; i < N; i++) {
+    v[i] = (rnd() >> 11) * 0x1p-53;
+    w[i] = (float)v[i];
+  }
+  run("[0, 1)", v, w);
+
+  for (i = 0; i < N; i++)
+    w[i] = v[i] = (double)(rnd() % 100000);
+  run("integers", v, w);
+
+  free(v);
+  free(w);
+  return 0;
+}
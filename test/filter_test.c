@@ -0,0 +1,132 @@
+/* VEC_filter, VEC_partition, VEC_filterMask and VEC_select against a scalar reference: every kind and comparison, on random
+ * vectors of lengths around the block (64 items) and SIMD widths. Values are small integers (exact in every kind), so that
+ * the reference compares them as doubles.
+ * Build: cc -O2 filter_test.c ../v_filter.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -mavx2, -mavx512f for the SIMD paths)
+ */
+
+#include <stdio.h>
+
+#include "../v_filter.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static double load(const void *v, VEC_kind k, vsize_t i) {
+  switch (k) {
+  case VEC_I8:  return ((const int8_t *)v)[i];
+  case VEC_U8:  return ((const uint8_t *)v)[i];
+  case VEC_I16: return ((const int16_t *)v)[i];
+  case VEC_U16: return ((const uint16_t *)v)[i];
+  case VEC_I32: return ((const int32_t *)v)[i];
+  case VEC_U32: return ((const uint32_t *)v)[i];
+  case VEC_I64: return (double)((const int64_t *)v)[i];
+  case VEC_U64: return (double)((const uint64_t *)v)[i];
+  case VEC_F32: return ((const float *)v)[i];
+  default:      return ((const double *)v)[i];
+  }
+}
+
+static void store(void *v, VEC_kind k, vsize_t i, int x) {
+  switch (k) {
+  case VEC_I8:  ((int8_t *)v)[i]   = (int8_t)x;   break;
+  case VEC_U8:  ((uint8_t *)v)[i]  = (uint8_t)x;  break;
+  case VEC_I16: ((int16_t *)v)[i]  = (int16_t)x;  break;
+  case VEC_U16: ((uint16_t *)v)[i] = (uint16_t)x; break;
+  case VEC_I32: ((int32_t *)v)[i]  = x;           break;
+  case VEC_U32: ((uint32_t *)v)[i] = (uint32_t)x; break;
+  case VEC_I64: ((int64_t *)v)[i]  = x;           break;
+  case VEC_U64: ((uint64_t *)v)[i] = (uint64_t)x; break;
+  case VEC_F32: ((float *)v)[i]    = (float)x;    break;
+  default:      ((double *)v)[i]   = x;
+  }
+}
+
+static bool match(double x, VEC_cmp op, double lo, double hi) {
+  switch (op) {
+  case VEC_EQ: return x == lo;
+  case VEC_NE: return x != lo;
+  case VEC_LT: return x < lo;
+  case VEC_LE: return x <= lo;
+  case VEC_GT: return x > lo;
+  case VEC_GE: return x >= lo;
+  case VEC_IN: return (x >= lo) && (x <= hi);
+  default:     return (x < lo) || (x > hi);
+  }
+}
+
+static void run(VEC_kind k, VEC_cmp op, vsize_t n) {
+  const vsize_t dt = VEC_kindSize(k);
+  const int base = VEC_kindSigned(k) ? -50 : 0, lo = base + 30, hi = base + 70;
+  const VEC_pred p = VEC_kindFloat(k) ? VEC_predFlt(k, op, lo, hi) : VEC_predInt(k, op, lo, hi);
+  void *v = VEC_newFrmSize(n | !n, dt), *d, *s, *r = VEC_newFrmSize(n | !n, dt);
+  uint64_t *m;
+  vsize_t i, w, nm, nr;
+
+  for (i = 0; i < n; i++)
+    store(v, k, i, base + (int)(next() % 100));
+  VEC_vusedSet(v, n);
+
+  /* Reference: matching items, then the others, in order */
+  for (i = nm = 0; i < n; i++)
+    if (match(load(v, k, i), op, lo, hi))
+      store(r, k, nm++, (int)load(v, k, i));
+  for (i = 0, nr = nm; i < n; i++)
+    if (! match(load(v, k, i), op, lo, hi))
+      store(r, k, nr++, (int)load(v, k, i));
+
+  d = VEC_filter(NULL, v, &p);
+  CHECK(VEC_used(d) == nm);
+  for (i = 0; (i < nm) && (i < VEC_used(d)); i++)
+    CHECK(load(d, k, i) == load(r, k, i));
+
+  m = VEC_filterMask(NULL, v, &p);
+  for (i = 0; i < n; i++)
+    CHECK(((m[i / 64] >> (i % 64)) & 1) == (uint64_t)match(load(v, k, i), op, lo, hi));
+  CHECK(VEC_maskCount(m) == nm);
+
+  s = VEC_select(NULL, v, m);
+  CHECK(VEC_used(s) == nm);
+  for (i = 0; (i < nm) && (i < VEC_used(s)); i++)
+    CHECK(load(s, k, i) == load(r, k, i));
+
+  w = VEC_partition(v, &p);
+  CHECK((w == nm) && (VEC_used(v) == n));
+  for (i = 0; i < n; i++)
+    CHECK(load(v, k, i) == load(r, k, i));
+
+  VEC_destroy(v);
+  VEC_destroy(r);
+  VEC_destroy(d);
+  VEC_destroy(s);
+  VEC_destroy(m);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 7, 8, 31, 63, 64, 65, 200, 1000};
+  unsigned k, op, i;
+
+  for (k = VEC_I8; k <= VEC_F64; k++)
+    for (op = VEC_EQ; op <= VEC_OUT; op++)
+      for (i = 0; i < sizeof lens / sizeof *lens; i++)
+	run((VEC_kind)k, (VEC_cmp)op, lens[i]);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
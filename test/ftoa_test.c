@@ -0,0 +1,63 @@
+/* mvpgFtoa, exhaustively: every float (2^32 patterns, or every STRIDE-th with an argument) in the 'g', 'e' and 'f' forms must read back
+ * (strtof) as itself; every 64th 'g' output is compared with the shortest "%.*g" precision that reads back (the former
+ * VEC_strAppendFlt loop): it must be equal, or shorter. Infinities, NaNs and zeros are checked against printf.
+ * Build: cc -O2 ftoa_test.c ../dtoa.c ../include.c -lm
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "../include.h"
+#include "../dtoa.h"
+
+static int shortest(float f, char *p) {
+  int n, prec;
+
+  for (prec = 1; ; prec++) {
+    n = snprintf(p, 64, "%.*g", prec, f);
+    if ((prec >= 9) || (f != f) || (strtof(p, NULL) == f))
+      return n;
+  }
+}
+
+int main(int argc, char **argv) {
+  const uint64_t stride = argc > 1 ? strtoull(argv[1], NULL, 10) : 1;
+  const char fmts[] = "gef";
+  char a[MVPG_FTOA_FLEN + 1], b[64];
+  uint64_t i, bad = 0;
+  uint32_t x;
+  unsigned int n;
+  float f;
+  int k;
+
+  for (i = 0; i < (1ull << 32); i += stride) {
+    x = (uint32_t)i;
+    memcpy(&f, &x, sizeof f);
+
+    if (!isfinite(f) || (f == 0)) {
+      mvpgFtoa(f, a, 'g');
+      shortest(f, b);
+      if (strcmp(a, b) && (bad++ < 10))
+	printf("%08x: %s, printf %s\n", x, a, b);
+      continue;
+    }
+
+    for (k = 0; k < 3; k++) {
+      n = mvpgFtoa(f, a, fmts[k]);
+      if ((n != strlen(a)) || (n > (k < 2 ? MVPG_FTOA_LEN : MVPG_FTOA_FLEN)) || (strtof(a, NULL) != f)) {
+	if (bad++ < 10)
+	  printf("%08x (%c): %s does not read back\n", x, fmts[k], a);
+      }
+    }
+
+    if (!(x & 63)) {
+      mvpgFtoa(f, a, 'g');
+      shortest(f, b);
+      if (strcmp(a, b) && (strlen(a) >= strlen(b)) && (bad++ < 10))
+	printf("%08x: %s, shortest %s\n", x, a, b);
+    }
+  }
+
+  printf("%s: %llu failures\n", bad ? "FAIL" : "ok", (unsigned long long)bad);
+  return bad != 0;
+}
@@ -0,0 +1,101 @@
+/* VEC_gather and VEC_scatter against the scalar reference D[i] = S[I[i]] and D[I[i]] = S[i]: item sizes 1, 2, 4, 8 and 3 (memcpy),
+ * uint32_t and uint64_t indices, random indices for gather and a random permutation for scatter.
+ * Build: cc -O2 gather_test.c ../v_gather.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (with -DVEC_GATHER_LLC=4096, the bucketed path is taken from a span of 16KB; with -mavx2 or -mavx512f, the SIMD gathers)
+ */
+
+#include <stdio.h>
+
+#include "../v_gather.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static void *indices(vsize_t n, vsize_t span, bool wide, bool perm) {
+  /* n random indices below span, or a permutation of [0, n) */
+  void *idx = wide ? VEC_new(n | !n, uint64_t) : VEC_new(n | !n, uint32_t);
+  vsize_t i, j, t;
+  uint64_t *p = VEC_new(n | !n, uint64_t);
+
+  for (i = 0; i < n; i++)
+    p[i] = perm ? i : next() % span;
+  for (i = n; perm && (i > 1); i--) {
+    j = next() % i;
+    t = p[i - 1], p[i - 1] = p[j], p[j] = t;
+  }
+  for (i = 0; i < n; i++) {
+    if (wide)
+      ((uint64_t *)idx)[i] = p[i];
+    else
+      ((uint32_t *)idx)[i] = (uint32_t)p[i];
+  }
+  VEC_vusedSet(idx, n);
+  VEC_destroy(p);
+  return idx;
+}
+
+static uint64_t at(const void *idx, bool wide, vsize_t i) {
+  return wide ? ((const uint64_t *)idx)[i] : ((const uint32_t *)idx)[i];
+}
+
+static void run(vsize_t dt, vsize_t n, vsize_t span, bool wide) {
+  char *s = VEC_newFrmSize(span, dt), *d, *r;
+  void *idx;
+  vsize_t i;
+
+  for (i = 0; i < span * dt; i++)
+    s[i] = (char)next();
+  VEC_vusedSet(s, span);
+
+  /* Gather */
+  idx = indices(n, span, wide, false);
+  d   = VEC_gather(NULL, s, idx);
+  CHECK(VEC_used(d) == n);
+  for (i = 0; i < n; i++)
+    CHECK(!memcmp(d + i * dt, s + at(idx, wide, i) * dt, dt));
+  VEC_destroy(idx);
+
+  /* Scatter of a permutation into a fresh vector, then into one that is reused */
+  idx = indices(span, span, wide, true);
+  r   = VEC_scatter(NULL, s, idx);
+  CHECK(VEC_used(r) == span);
+  for (i = 0; i < span; i++)
+    CHECK(!memcmp(r + at(idx, wide, i) * dt, s + i * dt, dt));
+  r = VEC_scatter(r, s, idx);
+  for (i = 0; i < span; i++)
+    CHECK(!memcmp(r + at(idx, wide, i) * dt, s + i * dt, dt));
+
+  VEC_destroy(idx);
+  VEC_destroy(r);
+  VEC_destroy(d);
+  VEC_destroy(s);
+}
+
+int main(void) {
+  static const vsize_t dts[] = {1, 2, 3, 4, 8}, lens[] = {1, 15, 16, 17, 1000, 70000};
+  unsigned i, j, w;
+
+  for (i = 0; i < sizeof dts / sizeof *dts; i++)
+    for (j = 0; j < sizeof lens / sizeof *lens; j++)
+      for (w = 0; w < 2; w++)
+	run(dts[i], lens[j], lens[j], w);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,140 @@
+/* VEC_unique and VEC_groupby against a reference: keys are small integers stored in items of 1, 2, 4, 8 and 12 bytes, so that a
+ * table indexed by the integer gives the group of each key, in order of first occurrence. Sums, counts, minima and maxima of
+ * signed, unsigned and float values are compared with loops over the items.
+ * Build: cc -O2 group_test.c ../v_group.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (-DVEC_GROUP_PARTMIN=256 -DVEC_GROUP_PARTITEMS=64 for the partitioned path)
+ */
+
+#include <stdio.h>
+
+#include "../v_group.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+#define MAXKEY 5000
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static uint32_t keyOf(const char *p, vsize_t dt) {
+  uint32_t x = 0;
+
+  memcpy(&x, p, dt < sizeof x ? dt : sizeof x);
+  return x;
+}
+
+static void run(vsize_t dt, vsize_t n, uint32_t range) {
+  static long group[MAXKEY];
+  static int64_t sum[MAXKEY], mn[MAXKEY], mx[MAXKEY];
+  static uint64_t cnt[MAXKEY];
+  static double fsum[MAXKEY];
+  char *k = VEC_newFrmSize(n | !n, dt), *u, *gk = NULL;
+  int32_t *vi = VEC_new(n | !n, int32_t);
+  uint16_t *vu = VEC_new(n | !n, uint16_t);
+  double *vf = VEC_new(n | !n, double);
+  VEC_scalar *ga = NULL;
+  uint32_t order[MAXKEY], x;
+  vsize_t i, g, ng;
+
+  memset(k, 0, n * dt);
+  for (i = ng = 0; i < MAXKEY; i++)
+    group[i] = -1;
+  for (i = 0; i < n; i++) {
+    x = (uint32_t)(next() % range);
+    memcpy(k + i * dt, &x, dt < sizeof x ? dt : sizeof x);
+    vi[i] = (int32_t)(next() % 2001) - 1000;
+    vu[i] = (uint16_t)next();
+    vf[i] = (double)(next() % 64) / 4;
+    if (group[x] < 0) {
+      group[x]    = (long)ng;
+      order[ng++] = x;
+    }
+  }
+  VEC_vusedSet(k, n);
+  VEC_vusedSet(vi, n);
+  VEC_vusedSet(vu, n);
+  VEC_vusedSet(vf, n);
+
+  u = VEC_unique(NULL, k);
+  CHECK(VEC_used(u) == ng);
+  for (g = 0; (g < ng) && (g < VEC_used(u)); g++)
+    CHECK(keyOf(u + g * dt, dt) == order[g]);
+
+  /* Signed values: sum, min, max; unsigned: sum, count; float: sum */
+  for (g = 0; g < ng; g++) {
+    sum[g] = cnt[g] = 0;
+    mn[g]  = INT64_MAX;
+    mx[g]  = INT64_MIN;
+    fsum[g] = 0;
+  }
+  for (i = 0; i < n; i++) {
+    g = group[keyOf(k + i * dt, dt)];
+    sum[g] += vi[i];
+    mn[g]   = vi[i] < mn[g] ? vi[i] : mn[g];
+    mx[g]   = vi[i] > mx[g] ? vi[i] : mx[g];
+    cnt[g]++;
+    fsum[g] += vf[i];
+  }
+
+  CHECK(VEC_groupby((void **)&gk, &ga, k, vi, VEC_I32, VEC_AGG_SUM) == ng);
+  for (g = 0; g < ng; g++)
+    CHECK((keyOf(gk + g * dt, dt) == order[g]) && (ga[g].i == sum[g]));
+  CHECK(VEC_groupby((void **)&gk, &ga, k, vi, VEC_I32, VEC_AGG_MIN) == ng);
+  for (g = 0; g < ng; g++)
+    CHECK(ga[g].i == mn[g]);
+  CHECK(VEC_groupby((void **)&gk, &ga, k, vi, VEC_I32, VEC_AGG_MAX) == ng);
+  for (g = 0; g < ng; g++)
+    CHECK(ga[g].i == mx[g]);
+  CHECK(VEC_groupby((void **)&gk, &ga, k, NULL, VEC_U16, VEC_AGG_COUNT) == ng);
+  for (g = 0; g < ng; g++)
+    CHECK(ga[g].u == cnt[g]);
+  CHECK(VEC_groupby((void **)&gk, &ga, k, vf, VEC_F64, VEC_AGG_SUM) == ng);
+  for (g = 0; g < ng; g++)
+    CHECK(ga[g].f == fsum[g]); /* Quarters: exact */
+
+  /* Unsigned sums, against a second pass */
+  CHECK(VEC_groupby((void **)&gk, &ga, k, vu, VEC_U16, VEC_AGG_SUM) == ng);
+  for (g = 0; g < ng; g++)
+    cnt[g] = 0;
+  for (i = 0; i < n; i++)
+    cnt[group[keyOf(k + i * dt, dt)]] += vu[i];
+  for (g = 0; g < ng; g++)
+    CHECK(ga[g].u == cnt[g]);
+
+  VEC_destroy(k);
+  VEC_destroy(u);
+  VEC_destroy(gk);
+  VEC_destroy(ga);
+  VEC_destroy(vi);
+  VEC_destroy(vu);
+  VEC_destroy(vf);
+}
+
+int main(void) {
+  static const vsize_t dts[] = {1, 2, 4, 8, 12};
+  unsigned i;
+
+  for (i = 0; i < sizeof dts / sizeof *dts; i++) {
+    run(dts[i], 0, 1);
+    run(dts[i], 1, 1);
+    run(dts[i], 1000, dts[i] == 1 ? 200 : 50);
+    run(dts[i], 50000, dts[i] == 1 ? 256 : MAXKEY);
+  }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
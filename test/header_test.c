@@ -0,0 +1,111 @@
+/* Vector headers against plain arrays, with and without VEC_COMPACT_HEADER: the header size before the items (the 8 bytes tag up
+ * to VEC_COMPACT_CAPMAX, the full header above it), 8 bytes aligned items, and many small vectors pushed past VEC_COMPACT_CAPMAX (promoted
+ * to a full header) and shrunk back, whose items, counts and item size must be those of the arrays.
+ * Build: cc -O2 header_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -DVEC_COMPACT_HEADER)
+ */
+
+#include <stdio.h>
+
+#include "../v_base.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Header bytes expected before the items of a new vector of capacity cap */
+static vsize_t header(vsize_t cap) {
+#ifdef VEC_COMPACT_HEADER
+  return cap <= VEC_COMPACT_CAPMAX ? VEC_cmetadtsz : VEC_metadtsz;
+#else
+  MvpgMacro_Ignore(cap);
+  return VEC_metadtsz;
+#endif
+}
+
+static void layout(vsize_t cap) {
+  uint16_t *v = VEC_new(cap, uint16_t);
+
+  CHECK((vsize_t)((char *)v - (char *)VEC_peekblkst(v)) == header(cap));
+  /* The block is aligned, and either header is a multiple of 8 bytes */
+  CHECK((((uintptr_t)VEC_peekblkst(v) % MVPG_ALLOC_MEMALIGN) == 0) && (((uintptr_t)v % 8) == 0));
+  CHECK((VEC_vsize(v) == cap) && (VEC_used(v) == 0) && (VEC_vdtype(v) == sizeof(uint16_t)));
+#ifdef VEC_COMPACT_HEADER
+  CHECK(!VEC_iscompact(v) == (cap > VEC_COMPACT_CAPMAX));
+#endif
+  VEC_destroy(v);
+}
+
+#define NVEC 2000
+#define MAXN 600
+
+static void small(void) {
+  static int32_t *v[NVEC], ref[NVEC][MAXN];
+  static vsize_t len[NVEC];
+  vsize_t i, j, s, step;
+
+  for (i = 0; i < NVEC; i++) {
+    v[i] = VEC_new(1 + next() % 8, int32_t);
+    len[i] = 0;
+  }
+
+  /* Interleaved pushes: most vectors stay small, some cross VEC_COMPACT_CAPMAX */
+  for (step = 0; step < 40; step++)
+    for (i = 0; i < NVEC; i++) {
+      s = (i % 50) ? next() % 6 : next() % 40;
+      for (j = 0; (j < s) && (len[i] < MAXN); j++) {
+	ref[i][len[i]] = (int32_t)next();
+	VEC_push(v[i], ref[i][len[i]]);
+	len[i]++;
+      }
+    }
+
+  for (i = 0; i < NVEC; i++) {
+    CHECK((VEC_used(v[i]) == len[i]) && (VEC_vsize(v[i]) >= len[i]) && (VEC_vdtype(v[i]) == sizeof(int32_t)));
+    CHECK(!memcmp(v[i], ref[i], len[i] * sizeof(int32_t)));
+#ifdef VEC_COMPACT_HEADER
+    CHECK(!VEC_iscompact(v[i]) == (VEC_vsize(v[i]) > VEC_COMPACT_CAPMAX));
+#endif
+
+    /* Shrunk below VEC_COMPACT_CAPMAX: the header is kept, the items up to the new capacity too */
+    s = len[i] / 3;
+    VEC_shrink(v[i], s | !s);
+    s = s | !s;
+    CHECK((VEC_vsize(v[i]) <= s) && (VEC_used(v[i]) == (len[i] < s ? len[i] : s)));
+    CHECK(!memcmp(v[i], ref[i], VEC_used(v[i]) * sizeof(int32_t)));
+    CHECK(VEC_vdtype(v[i]) == sizeof(int32_t));
+
+    /* And grown again */
+    for (j = VEC_used(v[i]); j < len[i]; j++)
+      VEC_push(v[i], ref[i][j]);
+    CHECK((VEC_used(v[i]) == len[i]) && !memcmp(v[i], ref[i], len[i] * sizeof(int32_t)));
+    VEC_destroy(v[i]);
+  }
+}
+
+int main(void) {
+  static const vsize_t caps[] = {1, 2, 7, 8, 100, 254, 255, 256, 257, 1000, 100000};
+  unsigned i;
+
+  for (i = 0; i < sizeof caps / sizeof *caps; i++)
+    layout(caps[i]);
+  small();
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,157 @@
+/* VEC_index against a linear scan of the sorted vector: lower and upper bounds, ranges and batched lookups, for every kind,
+ * with repeated keys, negative keys and infinities (floats), and queries below, between, on and above the keys.
+ * Build: cc -O2 index_test.c ../v_index.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -mavx2 for the SIMD nodes)
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "../v_index.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static double load(const void *v, VEC_kind k, vsize_t i) {
+  switch (k) {
+  case VEC_I8:  return ((const int8_t *)v)[i];
+  case VEC_U8:  return ((const uint8_t *)v)[i];
+  case VEC_I16: return ((const int16_t *)v)[i];
+  case VEC_U16: return ((const uint16_t *)v)[i];
+  case VEC_I32: return ((const int32_t *)v)[i];
+  case VEC_U32: return ((const uint32_t *)v)[i];
+  case VEC_I64: return (double)((const int64_t *)v)[i];
+  case VEC_U64: return (double)((const uint64_t *)v)[i];
+  case VEC_F32: return ((const float *)v)[i];
+  default:      return ((const double *)v)[i];
+  }
+}
+
+static void store(void *v, VEC_kind k, vsize_t i, double x) {
+  switch (k) {
+  case VEC_I8:  ((int8_t *)v)[i]   = (int8_t)x;   break;
+  case VEC_U8:  ((uint8_t *)v)[i]  = (uint8_t)x;  break;
+  case VEC_I16: ((int16_t *)v)[i]  = (int16_t)x;  break;
+  case VEC_U16: ((uint16_t *)v)[i] = (uint16_t)x; break;
+  case VEC_I32: ((int32_t *)v)[i]  = (int32_t)x;  break;
+  case VEC_U32: ((uint32_t *)v)[i] = (uint32_t)x; break;
+  case VEC_I64: ((int64_t *)v)[i]  = (int64_t)x;  break;
+  case VEC_U64: ((uint64_t *)v)[i] = (uint64_t)x; break;
+  case VEC_F32: ((float *)v)[i]    = (float)x;    break;
+  default:      ((double *)v)[i]   = x;
+  }
+}
+
+static VEC_scalar scalar(VEC_kind k, double x) {
+  VEC_scalar s;
+
+  if (VEC_kindFloat(k))
+    s.f = x;
+  else if (VEC_kindSigned(k))
+    s.i = (int64_t)x;
+  else
+    s.u = (uint64_t)x;
+  return s;
+}
+
+static double clamp(VEC_kind k, double x) {
+  /* Bounds are converted to the kind: keep them in its range (only 8 bits kinds can leave it here) */
+  if (k == VEC_I8)
+    return x > INT8_MAX ? INT8_MAX : x;
+  if (k == VEC_U8)
+    return x > UINT8_MAX ? UINT8_MAX : x;
+  return x;
+}
+
+static vsize_t bound(const void *v, VEC_kind k, double x, bool upper) {
+  vsize_t i;
+
+  for (i = 0; i < VEC_used(v); i++)
+    if (upper ? load(v, k, i) > x : load(v, k, i) >= x)
+      break;
+  return i;
+}
+
+static int cmp(const void *a, const void *b) {
+  const double x = *(const double *)a, y = *(const double *)b;
+
+  return (x > y) - (x < y);
+}
+
+static void run(VEC_kind k, vsize_t n, unsigned spread) {
+  const vsize_t dt = VEC_kindSize(k), nq = 300;
+  const double base = VEC_kindSigned(k) ? -(double)spread / 2 : 0;
+  void *s = VEC_newFrmSize(n | !n, dt), *q = VEC_newFrmSize(nq, dt);
+  vsize_t *dl, *du, i, f, c;
+  double *x = VEC_new(n | !n, double), y, h;
+  VEC_index ix;
+
+  for (i = 0; i < n; i++)
+    x[i] = base + (double)(next() % spread);
+  if (VEC_kindFloat(k) && (n > 2)) {
+    x[0] = -INFINITY;
+    x[1] = INFINITY;
+  }
+  qsort(x, n, sizeof *x, cmp);
+  for (i = 0; i < n; i++)
+    store(s, k, i, x[i]);
+  VEC_vusedSet(s, n);
+
+  ix = VEC_indexBuild(s, k);
+  VEC_destroy(x);
+
+  /* Queries from one below the least key to one above the greatest, kept in the range of the kind */
+  for (i = 0; i < nq; i++) {
+    y = clamp(k, base + (double)(next() % (spread + 2)) - (VEC_kindSigned(k) ? 1 : 0));
+    store(q, k, i, y);
+    CHECK(VEC_indexLower(&ix, scalar(k, y)) == bound(s, k, y, false));
+    CHECK(VEC_indexUpper(&ix, scalar(k, y)) == bound(s, k, y, true));
+
+    h = clamp(k, y + (double)(next() % 8));
+    c = VEC_indexRange(&ix, scalar(k, y), scalar(k, h), &f);
+    CHECK((f == bound(s, k, y, false)) && (c == bound(s, k, h, true) - f));
+  }
+  VEC_vusedSet(q, nq);
+
+  dl = VEC_indexBatch(NULL, &ix, q, false);
+  du = VEC_indexBatch(NULL, &ix, q, true);
+  CHECK((VEC_used(dl) == nq) && (VEC_used(du) == nq));
+  for (i = 0; i < nq; i++)
+    CHECK((dl[i] == bound(s, k, load(q, k, i), false)) && (du[i] == bound(s, k, load(q, k, i), true)));
+
+  VEC_indexDestroy(&ix);
+  VEC_destroy(dl);
+  VEC_destroy(du);
+  VEC_destroy(s);
+  VEC_destroy(q);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 2, 7, 8, 9, 64, 65, 1000, 20000};
+  unsigned k, i;
+
+  for (k = VEC_I8; k <= VEC_F64; k++)
+    for (i = 0; i < sizeof lens / sizeof *lens; i++) {
+      run((VEC_kind)k, lens[i], 10);
+      run((VEC_kind)k, lens[i], 250);
+    }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
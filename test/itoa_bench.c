@@ -0,0 +1,93 @@
+/* Integer formatting: snprintf against VEC_Repr (batch decimal path; SIMD unless VEC_REPR_NOSIMD), 1M int64 per run.
+ * Build: cc -O2 -march=native itoa_bench.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ * (add -DVEC_REPR_NOSIMD for the scalar path). Values are uniform 64-bit, then of uniformly drawn lengths (1 to 19 digits),
+ * then short (up to 4 digits); the VEC_Repr output is checked against snprintf.
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <inttypes.h>
+
+#include "../v_base.h"
+#include "../v_str.h"
+
+#define N    (1ul << 20)
+#define REPS 10
+
+static double now(void) {
+  struct timespec t;
+
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static uint64_t rnd(void) {
+  static uint64_t s = 88172645463325252ull;
+
+  s ^= s << 13;
+  s ^= s >> 7;
+  s ^= s << 17;
+  return s;
+}
+
+static int run(const char *name, int64_t *v, char *ref) {
+  VEC_str s = VEC_strNew(N * 22);
+  Pp_Setup cf;
+  double t, tp, tv;
+  char *p;
+  size_t i, r;
+
+  t = now();
+  for (r = 0; r < REPS; r++) {
+    for (i = 0, p = ref; i < N; i++)
+      p += sprintf(p, i ? ", %" PRId64 : "%" PRId64, v[i]);
+  }
+  tp = (now() - t) / REPS;
+
+  t = now();
+  for (r = 0; r < REPS; r++) {
+    memset(&cf, 0, sizeof cf);
+    cf.Pp_fmt = "lld";
+    cf.Pp_str = &s;
+    VEC_vusedSet(s, 0);
+    VEC_Repr(v, &cf);
+  }
+  tv = (now() - t) / REPS;
+
+  printf("%-10s %12.1f %12.1f %8.2fx\n", name, tp * 1e9 / N, tv * 1e9 / N, tp / tv);
+  if (strcmp(s, ref)) {
+    printf("mismatch (%s)\n", name);
+    return 1;
+  }
+  VEC_destroy(s);
+  return 0;
+}
+
+int main(void) {
+  int64_t *v = VEC_new(N, int64_t);
+  char *ref = malloc(N * 22 + 1);
+  uint64_t p10[20];
+  size_t i;
+  int err = 0;
+
+  for (p10[0] = 1, i = 1; i < 20; i++)
+    p10[i] = p10[i - 1] * 10;
+  VEC_vusedSet(v, N);
+
+  printf("%-10s %12s %12s %9s\n", "values", "snprintf ns", "VEC_Repr ns", "speedup");
+  for (i = 0; i < N; i++)
+    v[i] = (int64_t)rnd();
+  err |= run("uniform", v, ref);
+
+  for (i = 0; i < N; i++)
+    v[i] = (int64_t)(rnd() % p10[1 + rnd() % 19]) * ((rnd() & 1) ? -1 : 1);
+  err |= run("lengths", v, ref);
+
+  for (i = 0; i < N; i++)
+    v[i] = (int64_t)(rnd() % 10000);
+  err |= run("short", v, ref);
+
+  VEC_destroy(v);
+  free(ref);
+  return err;
+}
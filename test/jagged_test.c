@@ -0,0 +1,121 @@
+/* VEC_jagged against the nested form it flattens (a vector of pointers to vectors): FromNested, Push, ToNested and ForEach
+ * must give every row back with its items, empty and NULL rows included; ForEach must visit each row once.
+ * Build: cc -O2 jagged_test.c ../v_jagged.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (-DVEC_JAGGED_PARMIN=1024 -DVEC_JAGGED_THREADS=4 for the threaded ForEach)
+ */
+
+#include <stdio.h>
+
+#include "../v_jagged.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+#define NROWS 3000
+
+static int32_t *nested[NROWS];
+static vsize_t  visits[NROWS];
+static int64_t  sums[NROWS];
+
+static void visit(void *row, vsize_t len, vsize_t r, void *arg) {
+  vsize_t i;
+
+  MvpgMacro_Ignore(arg);
+  visits[r]++;
+  for (i = 0; i < len; i++)
+    sums[r] += ((int32_t *)row)[i];
+}
+
+static vsize_t rowLen(vsize_t r) {
+  return nested[r] == NULL ? 0 : VEC_used(nested[r]);
+}
+
+static void compare(const VEC_jagged *j, vsize_t rows) {
+  vsize_t r;
+
+  CHECK(VEC_jaggedRows(*j) == rows);
+  CHECK(j->jg_offsets[0] == 0);
+  for (r = 0; r < rows; r++) {
+    CHECK(VEC_jaggedLen(*j, r) == rowLen(r));
+    CHECK(!rowLen(r) || !memcmp(VEC_jaggedRow(*j, int32_t, r), nested[r], rowLen(r) * sizeof(int32_t)));
+  }
+}
+
+static void run(vsize_t rows, vsize_t maxlen) {
+  void **v = VEC_new(rows | !rows, void *), **back;
+  VEC_jagged j, p;
+  int64_t sum;
+  vsize_t r, i, n;
+
+  for (r = 0; r < rows; r++) {
+    n = next() % (maxlen + 1);
+    nested[r] = (next() % 10) ? VEC_new(n | !n, int32_t) : NULL;
+    for (i = 0; (nested[r] != NULL) && (i < n); i++)
+      nested[r][i] = (int32_t)next();
+    if (nested[r] != NULL)
+      VEC_vusedSet(nested[r], n);
+    v[r] = nested[r];
+  }
+  VEC_vusedSet(v, rows);
+
+  j = VEC_jaggedFromNested(v, sizeof(int32_t));
+  compare(&j, rows);
+
+  /* Row by row, from an array sized for none of them */
+  p = VEC_jaggedNew(sizeof(int32_t), 1, 1);
+  for (r = 0; r < rows; r++)
+    VEC_jaggedPush(&p, nested[r] != NULL ? (const void *)nested[r] : (const void *)"", rowLen(r));
+  compare(&p, rows);
+
+  back = VEC_jaggedToNested(&j);
+  CHECK(VEC_used(back) == rows);
+  for (r = 0; r < rows; r++) {
+    n = back[r] == NULL ? 0 : VEC_used(back[r]);
+    CHECK(n == rowLen(r));
+    CHECK(!n || !memcmp(back[r], nested[r], n * sizeof(int32_t)));
+    VEC_destroy(back[r]);
+  }
+
+  memset(visits, 0, sizeof visits);
+  memset(sums, 0, sizeof sums);
+  VEC_jaggedForEach(&j, visit, NULL);
+  for (r = 0; r < rows; r++) {
+    for (i = 0, sum = 0; i < rowLen(r); i++)
+      sum += nested[r][i];
+    CHECK((visits[r] == 1) && (sums[r] == sum));
+  }
+
+  for (r = 0; r < rows; r++)
+    VEC_destroy(nested[r]);
+  VEC_destroy(v);
+  VEC_destroy(back);
+  VEC_jaggedDestroy(&j);
+  VEC_jaggedDestroy(&p);
+}
+
+int main(void) {
+  run(0, 0);
+  run(1, 0);
+  run(5, 3);
+  run(200, 40);
+  run(NROWS, 500);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
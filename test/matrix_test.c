@@ -0,0 +1,139 @@
+/* VEC_matFromVec, VEC_matTranspose, VEC_matMul and the row / column views against dense arrays and a triple loop: both orders,
+ * item sizes 1, 2, 4 and 8 for the transpose, and shapes around the tile, register and block sizes. Products are of small
+ * integers, which float sums hold exactly in any association.
+ * Build: cc -O2 matrix_test.c ../v_matrix.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -mavx2 -mfma, -mavx512f for the SIMD kernels)
+ */
+
+#include <stdio.h>
+
+#include "../v_matrix.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Item (i, j) of the matrix m, by its bytes */
+static const char *item(const void *m, vsize_t i, vsize_t j) {
+  const vsize_t dt = VEC_vdtype(m), s = VEC_matStride(m);
+
+  return (const char *)m + dt * (VEC_matOrder(m) == VEC_ROWMAJOR ? i * s + j : j * s + i);
+}
+
+static void transpose(vsize_t r, vsize_t c, vsize_t dt, VEC_order o) {
+  char *v = VEC_newFrmSize(r * c, dt), *m, *t;
+  VEC_view w;
+  vsize_t i, j;
+
+  for (i = 0; i < r * c * dt; i++)
+    v[i] = (char)next();
+  VEC_vusedSet(v, r * c);
+
+  /* Dense v is in the order o */
+  m = VEC_matFromVec(v, r, c, o);
+  CHECK((VEC_matRows(m) == r) && (VEC_matCols(m) == c) && (VEC_matOrder(m) == o));
+  CHECK(((uintptr_t)m % MVPG_ALLOC_MEMALIGN == 0) && ((VEC_matStride(m) * dt) % MVPG_ALLOC_MEMALIGN == 0));
+  for (i = 0; i < r; i++)
+    for (j = 0; j < c; j++)
+      CHECK(!memcmp(item(m, i, j), v + dt * (o == VEC_ROWMAJOR ? i * c + j : j * r + i), dt));
+
+  t = VEC_matTranspose(NULL, m);
+  CHECK((VEC_matRows(t) == c) && (VEC_matCols(t) == r) && (VEC_matOrder(t) == o));
+  for (i = 0; i < r; i++)
+    for (j = 0; j < c; j++)
+      CHECK(!memcmp(item(t, j, i), item(m, i, j), dt));
+
+  /* Again into t (reshaped in place) */
+  t = VEC_matTranspose(t, m);
+  for (i = 0; i < r; i++)
+    for (j = 0; j < c; j++)
+      CHECK(!memcmp(item(t, j, i), item(m, i, j), dt));
+
+  i = next() % r;
+  w = VEC_matRow(m, i);
+  CHECK(w.v_len == c);
+  for (j = 0; j < c; j++)
+    CHECK(!memcmp((char *)w.v_data + j * w.v_step * dt, item(m, i, j), dt));
+  j = next() % c;
+  w = VEC_matCol(m, j);
+  CHECK(w.v_len == r);
+  for (i = 0; i < r; i++)
+    CHECK(!memcmp((char *)w.v_data + i * w.v_step * dt, item(m, i, j), dt));
+
+  VEC_matDestroy(t);
+  VEC_matDestroy(m);
+  VEC_destroy(v);
+}
+
+static double get(const void *m, VEC_kind k, vsize_t i, vsize_t j) {
+  return k == VEC_F32 ? *(const float *)item(m, i, j) : *(const double *)item(m, i, j);
+}
+
+static void mul(vsize_t r, vsize_t n, vsize_t c, VEC_kind k, VEC_order oa, VEC_order ob) {
+  const vsize_t dt = VEC_kindSize(k);
+  void *a = VEC_matNew(r, n, dt, oa), *b = VEC_matNew(n, c, dt, ob), *d;
+  double s;
+  vsize_t i, j, l;
+
+  for (i = 0; i < r; i++)
+    for (j = 0; j < n; j++) {
+      if (k == VEC_F32)
+	*(float *)item(a, i, j) = (float)((int)(next() % 9) - 4);
+      else
+	*(double *)item(a, i, j) = (double)((int)(next() % 9) - 4);
+    }
+  for (i = 0; i < n; i++)
+    for (j = 0; j < c; j++) {
+      if (k == VEC_F32)
+	*(float *)item(b, i, j) = (float)((int)(next() % 9) - 4);
+      else
+	*(double *)item(b, i, j) = (double)((int)(next() % 9) - 4);
+    }
+
+  d = VEC_matMul(NULL, a, b, k);
+  CHECK((VEC_matRows(d) == r) && (VEC_matCols(d) == c) && (VEC_matOrder(d) == oa));
+  for (i = 0; i < r; i++)
+    for (j = 0; j < c; j++) {
+      for (l = 0, s = 0; l < n; l++)
+	s += get(a, k, i, l) * get(b, k, l, j);
+      CHECK(get(d, k, i, j) == s);
+    }
+
+  VEC_matDestroy(d);
+  VEC_matDestroy(a);
+  VEC_matDestroy(b);
+}
+
+int main(void) {
+  static const vsize_t dims[][3] = {{1, 1, 1}, {7, 13, 5}, {33, 65, 31}, {6, 300, 16}, {150, 270, 40}};
+  static const vsize_t dts[] = {1, 2, 4, 8};
+  unsigned i, j, o, p;
+
+  for (i = 0; i < sizeof dims / sizeof *dims; i++)
+    for (o = 0; o < 2; o++) {
+      for (j = 0; j < sizeof dts / sizeof *dts; j++)
+	transpose(dims[i][0], dims[i][1], dts[j], (VEC_order)o);
+      for (p = 0; p < 2; p++) {
+	mul(dims[i][0], dims[i][1], dims[i][2], VEC_F32, (VEC_order)o, (VEC_order)p);
+	mul(dims[i][0], dims[i][1], dims[i][2], VEC_F64, (VEC_order)o, (VEC_order)p);
+      }
+    }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,122 @@
+/* VEC_PROFILE against counts known in advance, read back from VEC_profileReport: vectors, resizes, peak used (kept by a vector
+ * grown then shrunk before it is destroyed), used / capacity and the recommended capacity of right-sized, oversized and
+ * growing sites, from several threads; VEC_profileReset clears them.
+ * Build: cc -O2 -DVEC_PROFILE -DVEC_PROFILE_NOEXIT profile_test.c ../v_profile.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c
+ *        ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+
+#include "../v_profile.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+typedef struct {
+  unsigned long vectors, resizes, copied, init, peak, rec;
+  double        usedcap;
+  bool          star, found;
+} Row;
+
+/* The report line of the site at line of this file */
+static Row row(unsigned line) {
+  FILE *f = tmpfile();
+  char l[256], site[128], at[32], *c;
+  Row r = {0};
+  int n;
+
+  if (f == NULL)
+    return r;
+  VEC_profileReport(f);
+  rewind(f);
+  snprintf(at, sizeof at, ":%u", line);
+  while (fgets(l, sizeof l, f) != NULL) {
+    n = sscanf(l, "%127s %lu %lu %lu %lu %lu %lf%% %lu", site, &r.vectors, &r.resizes, &r.copied, &r.init, &r.peak,
+	       &r.usedcap, &r.rec);
+    c = strrchr(site, ':');
+    if ((n == 8) && (c != NULL) && !strcmp(c, at) && (strstr(site, "profile_test.c") != NULL)) {
+      r.star  = strchr(l, '*') != NULL;
+      r.found = true;
+      break;
+    }
+  }
+  fclose(f);
+  return r;
+}
+
+#define NTHREADS 4
+
+static unsigned tline;
+
+static void *worker(void *arg) {
+  int *v;
+  int i, j;
+
+  MvpgMacro_Ignore(arg);
+  for (i = 0; i < 100; i++) {
+    tline = __LINE__, v = VEC_new(64, int);
+    for (j = 0; j < 50; j++)
+      VEC_push(v, j);
+    VEC_destroy(v);
+  }
+  return NULL;
+}
+
+int main(void) {
+  pthread_t th[NTHREADS];
+  unsigned la, lb, lc;
+  int *a, *b, *c[3];
+  Row r;
+  int i, j;
+
+  /* Grown from 4 to 1024, shrunk to 10, destroyed: the peak is 1000 */
+  la = __LINE__, a = VEC_new(4, int);
+  for (i = 0; i < 1000; i++)
+    VEC_push(a, i);
+  VEC_shrink(a, 10);
+  VEC_destroy(a);
+  r = row(la);
+  CHECK(r.found && (r.vectors == 1) && (r.resizes == 8) && (r.init == 4) && (r.peak == 1000) && (r.rec == 1000) && r.star);
+  CHECK(r.copied % sizeof(int) == 0);
+
+  /* Right-sized: no resize, full, recommended as is */
+  lb = __LINE__, b = VEC_new(100, int);
+  for (i = 0; i < 100; i++)
+    VEC_push(b, i);
+  VEC_destroy(b);
+  r = row(lb);
+  CHECK(r.found && (r.vectors == 1) && !r.resizes && !r.copied && (r.peak == 100) && (r.usedcap == 100.0) && (r.rec == 100) && !r.star);
+
+  /* Oversized: a tenth used, recommended at the peak */
+  for (j = 0; j < 3; j++) {
+    lc = __LINE__, c[j] = VEC_new(1000, int);
+    for (i = 0; i < 10 * (j + 1); i++)
+      VEC_push(c[j], i);
+  }
+  for (j = 0; j < 3; j++)
+    VEC_destroy(c[j]);
+  r = row(lc);
+  CHECK(r.found && (r.vectors == 3) && !r.resizes && (r.init == 1000) && (r.peak == 30) && (r.usedcap == 2.0) && (r.rec == 30) && r.star);
+
+  /* One site, from several threads */
+  for (i = 0; i < NTHREADS; i++)
+    CHECK(!pthread_create(th + i, NULL, worker, NULL));
+  for (i = 0; i < NTHREADS; i++)
+    pthread_join(th[i], NULL);
+  r = row(tline);
+  CHECK(r.found && (r.vectors == 100 * NTHREADS) && !r.resizes && (r.peak == 50) && (r.rec == 64) && !r.star);
+
+  VEC_profileReset();
+  CHECK(!row(la).found && !row(lb).found && !row(lc).found && !row(tline).found);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
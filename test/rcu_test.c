@@ -0,0 +1,119 @@
+/* VEC_rcu against the items the writer is known to have published: item i is always f(i), so every snapshot must be a prefix of
+ * f, no shorter than the previous one of its reader. Readers run while the writer appends (past the capacity, so vectors are
+ * retired) and publishes rebuilt vectors; a snapshot held across many publications must stay intact (run under
+ * AddressSanitizer, or ThreadSanitizer, to see a version freed under a reader).
+ * Build: cc -O2 rcu_test.c ../v_rcu.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+#include <pthread.h>
+
+#include "../v_rcu.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+#define NREADERS 4
+#define NITEMS   200000
+
+static VEC_rcu r;
+static _Atomic unsigned long rbad;
+
+static uint64_t f(vsize_t i) {
+  return i * 0x9E3779B97F4A7C15ull + 1;
+}
+
+static bool prefix(const VEC_rcuSnap *s, vsize_t from) {
+  const uint64_t *d = s->rs_data;
+  vsize_t i;
+
+  for (i = from; i < s->rs_len; i++)
+    if (d[i] != f(i))
+      return false;
+  return true;
+}
+
+static void *reader(void *arg) {
+  const vsize_t id = VEC_rcuRegister(&r);
+  VEC_rcuSnap s;
+  vsize_t last = 0;
+
+  MvpgMacro_Ignore(arg);
+  do {
+    s = VEC_rcuRead(&r, id);
+    /* The whole snapshot now and then, else its last items */
+    if ((s.rs_len < last) || !prefix(&s, (s.rs_len & 15) ? (s.rs_len > 64 ? s.rs_len - 64 : 0) : 0))
+      rbad++;
+    last = s.rs_len;
+    VEC_rcuDone(&r, id);
+  } while (last < NITEMS);
+  return NULL;
+}
+
+/* A rebuilt vector of the first n items, with room for more */
+static uint64_t *rebuilt(vsize_t n) {
+  uint64_t *v = VEC_new(n + 1 + n / 4, uint64_t);
+  vsize_t i;
+
+  for (i = 0; i < n; i++)
+    v[i] = f(i);
+  VEC_vusedSet(v, n);
+  return v;
+}
+
+int main(void) {
+  pthread_t th[NREADERS];
+  uint64_t b[64];
+  VEC_rcuSnap held;
+  vsize_t n = 0, k, i, id;
+
+  VEC_rcuInit(&r, VEC_new(1, uint64_t), NREADERS + 1);
+  id = VEC_rcuRegister(&r);
+  held = VEC_rcuRead(&r, id);
+  CHECK(held.rs_len == 0);
+  VEC_rcuDone(&r, id);
+
+  for (i = 0; i < NREADERS; i++)
+    CHECK(!pthread_create(th + i, NULL, reader, NULL));
+
+  while (n < NITEMS) {
+    k = 1 + (vsize_t)(n * 7 % 64);
+    k = n + k > NITEMS ? NITEMS - n : k;
+    for (i = 0; i < k; i++)
+      b[i] = f(n + i);
+    if ((n / 64) % 97 == 5)
+      VEC_rcuPublish(&r, rebuilt(n + k));
+    else
+      VEC_rcuAppend(&r, b, k);
+    n += k;
+
+    /* Hold one snapshot across many versions */
+    if (n / 64 == 1000)
+      held = VEC_rcuRead(&r, id);
+    if (n / 64 == 2000) {
+      CHECK((held.rs_len >= 64000) && (held.rs_len < 64064) && prefix(&held, 0));
+      VEC_rcuDone(&r, id);
+    }
+  }
+
+  for (i = 0; i < NREADERS; i++)
+    pthread_join(th[i], NULL);
+  CHECK(!rbad);
+
+  held = VEC_rcuRead(&r, id);
+  CHECK((held.rs_len == NITEMS) && prefix(&held, 0));
+  VEC_rcuDone(&r, id);
+
+  VEC_rcuReclaim(&r);
+  VEC_rcuDestroy(&r);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,121 @@
+/* VEC_ReprF (compile-time format) against VEC_Repr with the same format string, byte for byte: every format of VEC_REPR_FORMATS,
+ * on random items (and floats of all exponents), to a VEC_str, a callback, a short buffer, and in parallel (Pp_threads).
+ * Build: cc -O2 repr_fmt_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (-DVEC_REPR_PARMIN=16 for the parallel path on these lengths)
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "../v_str.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static int sinkStr(void *arg, const char *p, vsize_t n) {
+  VEC_strAppend((VEC_str *)arg, p, n);
+  return 0;
+}
+
+#define N 5000
+
+/* Targets: 0 VEC_str, 1 VEC_str in parallel, 2 callback, 3 callback in parallel, 4 a buffer holding part of the items */
+static void target(Pp_Setup *p, unsigned t, VEC_str *s, char *buf) {
+  memset(p, 0, sizeof *p);
+  p->Pp_threads = (t % 2) ? 4 : 0;
+  if (t < 2)
+    p->Pp_str = s;
+  else if (t < 4) {
+    p->Pp_sink    = sinkStr;
+    p->Pp_sinkarg = s;
+  }
+  else {
+    p->Pp_buf  = buf;
+    p->Pp_size = 1000;
+  }
+}
+
+#define REPR_FMT(T, F, GEN)						\
+  do {									\
+    T *v = VEC_new(N, T);						\
+    char a[1000], b[1000];						\
+    VEC_str x, y;							\
+    Pp_Setup p, q;							\
+    unsigned t_;							\
+    vsize_t i_;								\
+									\
+    for (i_ = 0; i_ < N; i_++) {					\
+      uint64_t r_ = next();						\
+      T e_;								\
+      GEN;								\
+      v[i_] = e_;							\
+    }									\
+    VEC_vusedSet(v, N);							\
+    for (t_ = 0; t_ < 5; t_++) {					\
+      x = VEC_strNew(16);						\
+      y = VEC_strNew(16);						\
+      target(&p, t_, &x, a);						\
+      target(&q, t_, &y, b);						\
+      p.Pp_fmt = #F;							\
+      VEC_Repr(v, &p);							\
+      VEC_ReprF(v, &q, F);						\
+      CHECK(p.Pp_used && (p.Pp_used == q.Pp_used) && (p.Pp_overflw == q.Pp_overflw)); \
+      CHECK((t_ < 4) ? (VEC_strLen(x) == VEC_strLen(y)) && !memcmp(x, y, VEC_strLen(x)) : !strcmp(a, b)); \
+      VEC_strDestroy(x);						\
+      VEC_strDestroy(y);						\
+    }									\
+    VEC_destroy(v);							\
+  } while (0)
+
+#define INT_GEN e_ = (__typeof__(e_))(r_ >> (r_ % 64))
+#define DBL_GEN								\
+  do {									\
+    union { uint64_t u; double d; } u_ = {r_};				\
+    e_ = isnan(u_.d) ? 1.5 : (r_ % 2) ? u_.d : (double)(int32_t)r_ / 1024; \
+  } while (0)
+#define FLT_GEN								\
+  do {									\
+    union { uint32_t u; float f; } u_ = {(uint32_t)r_};			\
+    e_ = isnan(u_.f) ? 1.5f : (r_ % 2) ? u_.f : (float)(int16_t)r_ / 64; \
+  } while (0)
+
+int main(void) {
+  REPR_FMT(int, d, INT_GEN);
+  REPR_FMT(int, i, INT_GEN);
+  REPR_FMT(unsigned, u, INT_GEN);
+  REPR_FMT(short, hd, INT_GEN);
+  REPR_FMT(unsigned short, hu, INT_GEN);
+  REPR_FMT(long long, lld, INT_GEN);
+  REPR_FMT(unsigned long long, llu, INT_GEN);
+  REPR_FMT(int64_t, q, INT_GEN);
+  REPR_FMT(int8_t, h0, INT_GEN);
+  REPR_FMT(int16_t, h1, INT_GEN);
+  REPR_FMT(int32_t, h2, INT_GEN);
+  REPR_FMT(int64_t, h4, INT_GEN);
+  REPR_FMT(uintptr_t, p, INT_GEN);
+  REPR_FMT(double, g, DBL_GEN);
+  REPR_FMT(double, e, DBL_GEN);
+  REPR_FMT(double, f, DBL_GEN);
+  REPR_FMT(float, g, FLT_GEN);
+  REPR_FMT(float, e, FLT_GEN);
+  REPR_FMT(float, f, FLT_GEN);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,114 @@
+/* Decimal VEC_Repr against snprintf, item by item: every decimal format (d i u hd hu lld llu q h0 h1 h2 h4) on values of each
+ * digit count (powers of 10 and their neighbours, the type limits, random bit lengths), to a VEC_str, and to buffers from the
+ * least one holding all the items (the SIMD store falls back to the scalar path near its end) down to the longest item.
+ * Build: cc -O2 repr_int_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -DVEC_REPR_NOSIMD)
+ */
+
+#include <stdio.h>
+#include <inttypes.h>
+
+#include "../v_str.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+#define N 4000
+
+/* The i-th test value: 10^k - 1, 10^k, 10^k + 1 and their negations first, then random bit lengths and signs */
+static uint64_t value(vsize_t i) {
+  uint64_t x = 1;
+  vsize_t k;
+
+  if (i < 6 * 20) {
+    for (k = 0; k < (i / 6) % 20; k++)
+      x *= 10;
+    x += (i % 3) - 1;
+    return (i % 6) < 3 ? x : -x;
+  }
+  if (i < 6 * 20 + 4)
+    return (uint64_t[]){0, UINT64_MAX, INT64_MAX, (uint64_t)INT64_MIN}[i - 6 * 20];
+  return next() >> (next() % 64);
+}
+
+/* ref: the items of v as printf formats them, joined by ", ", n bytes */
+static void run(void *v, char *fmt, const char *ref, vsize_t n) {
+  char *buf;
+  Pp_Setup p;
+  VEC_str s;
+  vsize_t size;
+
+  s = VEC_strNew(16);
+  memset(&p, 0, sizeof p);
+  p.Pp_fmt = fmt;
+  p.Pp_str = &s;
+  VEC_Repr(v, &p);
+  CHECK((VEC_strLen(s) == n) && !strcmp(s, ref));
+  VEC_strDestroy(s);
+
+  /* Items are written while the longest one (Pp_overflw) surely fits: the least buffer for all of them, then shorter ones
+   * holding the items up to a separator (none below Pp_overflw + 1 bytes: the buffer is not written) */
+  for (size = n + p.Pp_overflw + 1; size > p.Pp_overflw; size = size > 100 ? size / 3 : size - 1) {
+    buf = malloc(size);
+    memset(&p, 0, sizeof p);
+    p.Pp_fmt  = fmt;
+    p.Pp_buf  = buf;
+    p.Pp_size = size;
+    VEC_Repr(v, &p);
+    CHECK((p.Pp_used < size) && (strlen(buf) == p.Pp_used) && !memcmp(buf, ref, p.Pp_used));
+    CHECK((p.Pp_used == n) ? (size > n) : (p.Pp_used + p.Pp_overflw >= size) && !memcmp(ref + p.Pp_used, ", ", 2));
+    free(buf);
+  }
+}
+
+#define REPR_INT(T, F, PF)						\
+  do {									\
+    T *v = VEC_new(N, T);						\
+    VEC_str ref = VEC_strNew(16);					\
+    vsize_t i_;								\
+									\
+    for (i_ = 0; i_ < N; i_++) {					\
+      v[i_] = (T)value(i_);						\
+      if (i_)								\
+	VEC_strCat(&ref, ", ");						\
+      VEC_strAppendf(&ref, "%" PF, v[i_]);				\
+    }									\
+    VEC_vusedSet(v, N);							\
+    run(v, F, ref, VEC_strLen(ref));					\
+    VEC_strDestroy(ref);						\
+    VEC_destroy(v);							\
+  } while (0)
+
+int main(void) {
+  REPR_INT(int, "d", "d");
+  REPR_INT(int, "i", "i");
+  REPR_INT(unsigned, "u", "u");
+  REPR_INT(short, "hd", "hd");
+  REPR_INT(unsigned short, "hu", "hu");
+  REPR_INT(long long, "lld", "lld");
+  REPR_INT(unsigned long long, "llu", "llu");
+  REPR_INT(int64_t, "q", PRId64);
+  REPR_INT(int8_t, "h0", PRId8);
+  REPR_INT(int16_t, "h1", PRId16);
+  REPR_INT(int32_t, "h2", PRId32);
+  REPR_INT(int64_t, "h4", PRId64);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,184 @@
+/* Parallel VEC_Repr (Pp_threads) against the sequential one, byte for byte: to a plain buffer (and one too short, where the
+ * sequential repr is kept), to a VEC_str after a prefix, to a callback, to a FILE *, and to a file descriptor (written with pwrite
+ * at the offset after a prefix, or in order when opened for appending), for integer and float formats, at lengths around the
+ * thread count times VEC_REPR_PARMIN.
+ * Build: cc -O2 repr_par_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (-DVEC_REPR_PARMIN=16 for many threads on short vectors)
+ */
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "../v_str.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static int sinkStr(void *arg, const char *p, vsize_t n) {
+  VEC_strAppend((VEC_str *)arg, p, n);
+  return 0;
+}
+
+/* The file of fd holds pre, then the n bytes of ref */
+static bool fdHas(int fd, const char *pre, const char *ref, size_t n) {
+  const size_t np = strlen(pre);
+  char *b = malloc(np + n + 1);
+  bool ok;
+
+  ok = (b != NULL) && (pread(fd, b, np + n + 1, 0) == (ssize_t)(np + n)) && !memcmp(b, pre, np) && !memcmp(b + np, ref, n);
+  free(b);
+  return ok;
+}
+
+static void run(void *v, char *fmt, uint8_t threads) {
+  char path[] = "/tmp/repr_par_testXXXXXX", *buf, *out;
+  VEC_str ref = VEC_strNew(16), s;
+  Pp_Setup q = {0}, p;
+  vsize_t n;
+  FILE *f;
+  int fd;
+
+  /* Sequential */
+  q.Pp_fmt = fmt;
+  q.Pp_str = &ref;
+  VEC_Repr(v, &q);
+  n = VEC_strLen(ref);
+
+  /* Plain buffer, long enough and too short */
+  buf = malloc(n + q.Pp_overflw + 2);
+  out = malloc(n + q.Pp_overflw + 2);
+  memset(&p, 0, sizeof p);
+  p.Pp_fmt     = fmt;
+  p.Pp_threads = threads;
+  p.Pp_buf     = buf;
+  p.Pp_size    = n + q.Pp_overflw + 2;
+  VEC_Repr(v, &p);
+  CHECK((p.Pp_used == n) && !strcmp(buf, ref));
+
+  memset(&q, 0, sizeof q);
+  q.Pp_fmt  = fmt;
+  q.Pp_buf  = out;
+  q.Pp_size = n / 2 + 1;
+  VEC_Repr(v, &q);
+  memset(&p, 0, sizeof p);
+  p.Pp_fmt     = fmt;
+  p.Pp_threads = threads;
+  p.Pp_buf     = buf;
+  p.Pp_size    = n / 2 + 1;
+  VEC_Repr(v, &p);
+  CHECK((p.Pp_used == q.Pp_used) && !strcmp(buf, out));
+  free(buf);
+  free(out);
+
+  /* VEC_str after a prefix */
+  s = VEC_strNew(4);
+  VEC_strCat(&s, "pre:");
+  memset(&p, 0, sizeof p);
+  p.Pp_fmt     = fmt;
+  p.Pp_threads = threads;
+  p.Pp_str     = &s;
+  VEC_Repr(v, &p);
+  CHECK((p.Pp_used == n) && (VEC_strLen(s) == n + 4) && !memcmp(s, "pre:", 4) && !strcmp(s + 4, ref));
+
+  /* Callback */
+  VEC_strClear(s);
+  memset(&p, 0, sizeof p);
+  p.Pp_fmt     = fmt;
+  p.Pp_threads = threads;
+  p.Pp_sink    = sinkStr;
+  p.Pp_sinkarg = &s;
+  VEC_Repr(v, &p);
+  CHECK((p.Pp_used == n) && !p.Pp_serr && (VEC_strLen(s) == n) && !memcmp(s, ref, n));
+  VEC_strDestroy(s);
+
+  /* FILE *, then a seekable file descriptor (pwrite), then one in append mode (in order), each after a prefix */
+  fd = mkstemp(path);
+  CHECK(fd >= 0);
+  if (fd >= 0) {
+    unlink(path);
+    f = fdopen(dup(fd), "w");
+    CHECK(f != NULL);
+    if (f != NULL) {
+      fputs("file:", f);
+      memset(&p, 0, sizeof p);
+      p.Pp_fmt     = fmt;
+      p.Pp_threads = threads;
+      p.Pp_sink    = VEC_reprSinkFile;
+      p.Pp_sinkarg = f;
+      VEC_Repr(v, &p);
+      fclose(f);
+      CHECK((p.Pp_used == n) && !p.Pp_serr && fdHas(fd, "file:", ref, n));
+    }
+
+    CHECK(!ftruncate(fd, 0) && !lseek(fd, 0, SEEK_SET) && (write(fd, "fd:", 3) == 3));
+    memset(&p, 0, sizeof p);
+    p.Pp_fmt     = fmt;
+    p.Pp_threads = threads;
+    p.Pp_sink    = VEC_reprSinkFd;
+    p.Pp_sinkarg = (void *)(intptr_t)fd;
+    VEC_Repr(v, &p);
+    CHECK((p.Pp_used == n) && !p.Pp_serr && (lseek(fd, 0, SEEK_CUR) == (off_t)(3 + n)) && fdHas(fd, "fd:", ref, n));
+
+    CHECK(!ftruncate(fd, 0) && !lseek(fd, 0, SEEK_SET) && (write(fd, "app:", 4) == 4));
+    CHECK(fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_APPEND) != -1);
+    p.Pp_fmt = fmt; /* Read by VEC_Repr */
+    VEC_Repr(v, &p);
+    CHECK((p.Pp_used == n) && !p.Pp_serr && fdHas(fd, "app:", ref, n));
+    close(fd);
+  }
+
+  VEC_strDestroy(ref);
+}
+
+int main(void) {
+  static const uint8_t threads[] = {2, 3, 255};
+  static const vsize_t mul[] = {1, 3, 20};
+  static const vsize_t near[] = {0, 7};
+  int64_t *vi;
+  float *vf;
+  vsize_t i, j, t, n;
+
+  for (i = 0; i < sizeof mul / sizeof *mul; i++)
+    for (j = 0; j < sizeof near / sizeof *near; j++) {
+      /* Many threads on short chunks, whose rounding leaves the last ones empty, with a small VEC_REPR_PARMIN only */
+      n  = mul[i] * 2 * VEC_REPR_PARMIN + near[j];
+      if (n > (1u << 20))
+	continue;
+      vi = VEC_new(n, int64_t);
+      vf = VEC_new(n, float);
+      for (t = 0; t < n; t++) {
+	vi[t] = (int64_t)next() >> (next() % 64);
+	vf[t] = (float)(int32_t)next() / (float)(1u << (next() % 31));
+      }
+      VEC_vusedSet(vi, n);
+      VEC_vusedSet(vf, n);
+
+      for (t = 0; t < sizeof threads / sizeof *threads; t++) {
+	run(vi, "q", threads[t]);
+	run(vf, (t % 2) ? "g" : "e", threads[t]);
+      }
+
+      VEC_destroy(vi);
+      VEC_destroy(vf);
+    }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
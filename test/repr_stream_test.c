@@ -0,0 +1,170 @@
+/* Streaming VEC_Repr against VEC_Repr to one large buffer: to a callback, through chunks from barely longer than an item to the
+ * default one (no chunk passed longer than Pp_size), to a FILE * and to a file descriptor after bytes already written, for
+ * integer and float formats; a failing sink stops the stream, and its result is Pp_serr.
+ * Build: cc -O2 repr_stream_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "../v_str.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+#define REFMAX (1 << 24)
+
+static char ref[REFMAX];
+
+/* Callback sink: appends to a VEC_str, keeps the longest chunk, fails from call sk_fail (0: never) */
+typedef struct {
+  VEC_str  sk_s;
+  vsize_t  sk_calls, sk_max, sk_fail;
+} Sink;
+
+static int sinkStr(void *arg, const char *p, vsize_t n) {
+  Sink *k = arg;
+
+  if (++k->sk_calls == k->sk_fail)
+    return 7;
+  k->sk_max = n > k->sk_max ? n : k->sk_max;
+  VEC_strAppend(&k->sk_s, p, n);
+  return 0;
+}
+
+static bool fileHas(FILE *f, const char *pre, size_t np, size_t n) {
+  char *b = malloc(np + n + 1);
+  bool ok;
+
+  rewind(f);
+  ok = (b != NULL) && (fread(b, 1, np + n + 1, f) == np + n) && !memcmp(b, pre, np) && !memcmp(b + np, ref, n);
+  free(b);
+  return ok;
+}
+
+static void run(void *v, char *fmt) {
+  static const vsize_t chunks[] = {0, 1, 2, 17, 100, 4096};
+  char *buf;
+  Pp_Setup a = {0}, s;
+  Sink k;
+  FILE *f;
+  size_t n;
+  vsize_t i;
+
+  a.Pp_buf  = ref;
+  a.Pp_size = sizeof ref;
+  a.Pp_fmt  = fmt;
+  VEC_Repr(v, &a);
+  n = strlen(ref);
+  CHECK(a.Pp_used == n);
+
+  /* Callback, with the default chunk (Pp_buf NULL) and with chunks of Pp_overflw + chunks[i] bytes */
+  for (i = 0; i < sizeof chunks / sizeof *chunks; i++) {
+    memset(&s, 0, sizeof s);
+    memset(&k, 0, sizeof k);
+    k.sk_s = VEC_strNew(16);
+    s.Pp_fmt     = fmt;
+    s.Pp_sink    = sinkStr;
+    s.Pp_sinkarg = &k;
+    buf = NULL;
+    if (chunks[i]) {
+      /* Pp_overflw, as set by VEC_Repr, is the longest item: the least chunk is one byte more */
+      buf = malloc(a.Pp_overflw + chunks[i]);
+      s.Pp_buf  = buf;
+      s.Pp_size = a.Pp_overflw + chunks[i];
+    }
+    VEC_Repr(v, &s);
+    CHECK((s.Pp_used == n) && (VEC_strLen(k.sk_s) == n) && !memcmp(k.sk_s, ref, n) && !s.Pp_serr);
+    CHECK(k.sk_max <= (chunks[i] ? a.Pp_overflw + chunks[i] : VEC_REPR_CHUNK));
+    CHECK((s.Pp_buf == buf) && (!n || k.sk_calls));
+    VEC_strDestroy(k.sk_s);
+    free(buf);
+  }
+
+  /* A sink failing on its second call: not called again */
+  memset(&s, 0, sizeof s);
+  memset(&k, 0, sizeof k);
+  k.sk_s    = VEC_strNew(16);
+  k.sk_fail = 2;
+  buf = malloc(a.Pp_overflw + 1);
+  s.Pp_fmt     = fmt;
+  s.Pp_sink    = sinkStr;
+  s.Pp_sinkarg = &k;
+  s.Pp_buf     = buf;
+  s.Pp_size    = a.Pp_overflw + 1;
+  VEC_Repr(v, &s);
+  CHECK((k.sk_calls < 2) ? (s.Pp_serr == 0) && (s.Pp_used == n) : (k.sk_calls == 2) && (s.Pp_serr == 7) && (s.Pp_used < n));
+  VEC_strDestroy(k.sk_s);
+  free(buf);
+
+  /* FILE *, and a file descriptor, after a prefix */
+  f = tmpfile();
+  CHECK(f != NULL);
+  if (f == NULL)
+    return;
+  memset(&s, 0, sizeof s);
+  s.Pp_fmt     = fmt;
+  s.Pp_sink    = VEC_reprSinkFile;
+  s.Pp_sinkarg = f;
+  fputs("pre:", f);
+  VEC_Repr(v, &s);
+  fflush(f);
+  CHECK((s.Pp_used == n) && !s.Pp_serr && fileHas(f, "pre:", 4, n));
+
+  CHECK(!ftruncate(fileno(f), 0) && !lseek(fileno(f), 0, SEEK_SET));
+  CHECK(write(fileno(f), "fd:", 3) == 3);
+  memset(&s, 0, sizeof s);
+  s.Pp_fmt     = fmt;
+  s.Pp_sink    = VEC_reprSinkFd;
+  s.Pp_sinkarg = (void *)(intptr_t)fileno(f);
+  VEC_Repr(v, &s);
+  CHECK((s.Pp_used == n) && !s.Pp_serr && (lseek(fileno(f), 0, SEEK_CUR) == (off_t)(3 + n)) && fileHas(f, "fd:", 3, n));
+  fclose(f);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 2, 100, 5000, 300000};
+  int32_t *vi;
+  double *vd;
+  vsize_t i, j, n;
+
+  for (i = 0; i < sizeof lens / sizeof *lens; i++) {
+    n  = lens[i];
+    vi = VEC_new(n | !n, int32_t);
+    vd = VEC_new(n | !n, double);
+    for (j = 0; j < n; j++) {
+      vi[j] = (int32_t)next() >> (next() % 32);
+      vd[j] = (next() % 2) ? (double)(int64_t)next() / (double)(1ull << (next() % 60)) : (double)(int32_t)next() / 1024;
+    }
+    VEC_vusedSet(vi, n);
+    VEC_vusedSet(vd, n);
+
+    run(vi, "d");
+    run(vi, "h2");
+    run(vd, "g");
+    run(vd, "e");
+    run(vd, "f");
+
+    VEC_destroy(vi);
+    VEC_destroy(vd);
+  }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,100 @@
+/* VEC_inclusiveScan and VEC_exclusiveScan against a sequential loop: every kind, to a new vector and in place. Integer sums
+ * wrap, so they are compared modulo 2^bits; float items are small integers, whose sums are exact in any association.
+ * Build: cc -O2 scan_test.c ../v_scan.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (-DVEC_SCAN_PARMIN=4096 -DVEC_SCAN_THREADS=4 for the threaded path, -mavx2 or -mavx512f for the SIMD blocks)
+ */
+
+#include <stdio.h>
+
+#include "../v_scan.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* Item i of kind k, as the low bits of an integer (floats: their integer value) */
+static uint64_t load(const void *v, VEC_kind k, vsize_t i) {
+  switch (k) {
+  case VEC_I8:
+  case VEC_U8:  return ((const uint8_t *)v)[i];
+  case VEC_I16:
+  case VEC_U16: return ((const uint16_t *)v)[i];
+  case VEC_I32:
+  case VEC_U32: return ((const uint32_t *)v)[i];
+  case VEC_F32: return (uint64_t)((const float *)v)[i];
+  case VEC_F64: return (uint64_t)((const double *)v)[i];
+  default:      return ((const uint64_t *)v)[i];
+  }
+}
+
+static void store(void *v, VEC_kind k, vsize_t i, uint64_t x) {
+  switch (k) {
+  case VEC_I8:
+  case VEC_U8:  ((uint8_t *)v)[i]  = (uint8_t)x;  break;
+  case VEC_I16:
+  case VEC_U16: ((uint16_t *)v)[i] = (uint16_t)x; break;
+  case VEC_I32:
+  case VEC_U32: ((uint32_t *)v)[i] = (uint32_t)x; break;
+  case VEC_F32: ((float *)v)[i]    = (float)x;    break;
+  case VEC_F64: ((double *)v)[i]   = (double)x;   break;
+  default:      ((uint64_t *)v)[i] = x;
+  }
+}
+
+static void run(VEC_kind k, vsize_t n) {
+  const vsize_t dt = VEC_kindSize(k);
+  const uint64_t wrap = dt < 8 ? ((uint64_t)1 << (dt * 8)) - 1 : ~(uint64_t)0;
+  void *s = VEC_newFrmSize(n | !n, dt), *d, *e, *w;
+  uint64_t sum;
+  vsize_t i;
+
+  for (i = 0; i < n; i++)
+    store(s, k, i, VEC_kindFloat(k) ? next() % 8 : next());
+  VEC_vusedSet(s, n);
+
+  d = VEC_inclusiveScan(NULL, s, k);
+  e = VEC_exclusiveScan(NULL, s, k);
+  CHECK((VEC_used(d) == n) && (VEC_used(e) == n));
+  for (i = 0, sum = 0; i < n; i++) {
+    CHECK(load(e, k, i) == (sum & wrap));
+    sum += load(s, k, i);
+    CHECK(load(d, k, i) == (sum & wrap));
+  }
+
+  /* In place: the inclusive scan of s, over s */
+  w = VEC_inclusiveScan(s, s, k);
+  CHECK((w == s) && (VEC_used(w) == n));
+  for (i = 0; i < n; i++)
+    CHECK(load(w, k, i) == load(d, k, i));
+
+  VEC_destroy(w);
+  VEC_destroy(d);
+  VEC_destroy(e);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 3, 8, 17, 64, 1000, 100000};
+  unsigned k, i;
+
+  for (k = VEC_I8; k <= VEC_F64; k++)
+    for (i = 0; i < sizeof lens / sizeof *lens; i++)
+      run((VEC_kind)k, lens[i]);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,141 @@
+/* VEC_nthElement, VEC_topk and VEC_quantiles against a sorted copy (qsort): every kind, with repeated items, and NaNs among
+ * floats (they rank after every number).
+ * Build: cc -O2 select_test.c ../v_select.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+#include <math.h>
+
+#include "../v_select.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static double load(const void *v, VEC_kind k, vsize_t i) {
+  switch (k) {
+  case VEC_I8:  return ((const int8_t *)v)[i];
+  case VEC_U8:  return ((const uint8_t *)v)[i];
+  case VEC_I16: return ((const int16_t *)v)[i];
+  case VEC_U16: return ((const uint16_t *)v)[i];
+  case VEC_I32: return ((const int32_t *)v)[i];
+  case VEC_U32: return ((const uint32_t *)v)[i];
+  case VEC_I64: return (double)((const int64_t *)v)[i];
+  case VEC_U64: return (double)((const uint64_t *)v)[i];
+  case VEC_F32: return ((const float *)v)[i];
+  default:      return ((const double *)v)[i];
+  }
+}
+
+static void store(void *v, VEC_kind k, vsize_t i, double x) {
+  switch (k) {
+  case VEC_I8:  ((int8_t *)v)[i]   = (int8_t)x;   break;
+  case VEC_U8:  ((uint8_t *)v)[i]  = (uint8_t)x;  break;
+  case VEC_I16: ((int16_t *)v)[i]  = (int16_t)x;  break;
+  case VEC_U16: ((uint16_t *)v)[i] = (uint16_t)x; break;
+  case VEC_I32: ((int32_t *)v)[i]  = (int32_t)x;  break;
+  case VEC_U32: ((uint32_t *)v)[i] = (uint32_t)x; break;
+  case VEC_I64: ((int64_t *)v)[i]  = (int64_t)x;  break;
+  case VEC_U64: ((uint64_t *)v)[i] = (uint64_t)x; break;
+  case VEC_F32: ((float *)v)[i]    = (float)x;    break;
+  default:      ((double *)v)[i]   = x;
+  }
+}
+
+/* Order of the reference, and equality: NaN after every number, and equal to NaN */
+static bool less(double a, double b) {
+  return isnan(a) ? false : isnan(b) ? true : a < b;
+}
+
+static bool same(double a, double b) {
+  return (isnan(a) && isnan(b)) || (a == b);
+}
+
+static int cmp(const void *a, const void *b) {
+  const double x = *(const double *)a, y = *(const double *)b;
+
+  return less(x, y) ? -1 : less(y, x);
+}
+
+static double widened(const VEC_scalar *s, VEC_kind k) {
+  return VEC_kindFloat(k) ? s->f : VEC_kindSigned(k) ? (double)s->i : (double)s->u;
+}
+
+static void run(VEC_kind k, vsize_t n, unsigned spread) {
+  static const double q[] = {0, 0.1, 0.25, 0.5, 0.5, 0.9, 0.999, 1, -1, 2};
+  const vsize_t dt = VEC_kindSize(k), m = sizeof q / sizeof *q;
+  void *v = VEC_newFrmSize(n | !n, dt), *w = VEC_newFrmSize(n | !n, dt), *d;
+  double *s = VEC_new(n | !n, double), x;
+  VEC_scalar out[sizeof q / sizeof *q];
+  vsize_t i, r, t;
+
+  for (i = 0; i < n; i++) {
+    x = (double)(next() % spread) - (VEC_kindSigned(k) ? spread / 2 : 0);
+    store(v, k, i, (VEC_kindFloat(k) && !(next() % 50)) ? NAN : x);
+    s[i] = load(v, k, i);
+  }
+  VEC_vusedSet(v, n);
+  qsort(s, n, sizeof *s, cmp);
+
+  /* Ranks: first, last, and random ones */
+  for (t = 0; n && (t < 8); t++) {
+    r = t == 0 ? 0 : t == 1 ? n - 1 : next() % n;
+    memcpy(w, v, n * dt);
+    VEC_vusedSet(w, n);
+    VEC_nthElement(w, r, k);
+    CHECK(same(load(w, k, r), s[r]));
+    for (i = 0; i < n; i++)
+      CHECK(i < r ? !less(load(w, k, r), load(w, k, i)) : i > r ? !less(load(w, k, i), load(w, k, r)) : true);
+  }
+
+  /* Top-k: the greatest first */
+  for (t = 0; t < 4; t++) {
+    r = t == 0 ? 0 : t == 1 ? n + 3 : next() % (n + 1);
+    d = VEC_topk(NULL, v, r, k);
+    CHECK(VEC_used(d) == (r < n ? r : n));
+    for (i = 0; i < VEC_used(d); i++)
+      CHECK(same(load(d, k, i), s[n - 1 - i]));
+    VEC_destroy(d);
+  }
+
+  if (n) {
+    memcpy(w, v, n * dt);
+    VEC_vusedSet(w, n);
+    VEC_quantiles(w, q, m, k, out);
+    for (i = 0; i < m; i++)
+      CHECK(same(widened(out + i, k), s[(vsize_t)((q[i] <= 0 ? 0 : q[i] >= 1 ? 1 : q[i]) * (n - 1) + 0.5)]));
+  }
+
+  VEC_destroy(v);
+  VEC_destroy(w);
+  VEC_destroy(s);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 2, 15, 16, 17, 100, 5000};
+  unsigned k, i;
+
+  for (k = VEC_I8; k <= VEC_F64; k++)
+    for (i = 0; i < sizeof lens / sizeof *lens; i++) {
+      run((VEC_kind)k, lens[i], 4);
+      run((VEC_kind)k, lens[i], 200);
+    }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
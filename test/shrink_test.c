@@ -0,0 +1,127 @@
+/* VEC_shrink against plain arrays: to a capacity N (the first N items kept, a capacity at or above the current one a no-op), and
+ * shrink-to-fit with its hysteresis (skipped unless cap / VEC_SHRINK_MIN items are released, used / VEC_SHRINK_SLACK items of
+ * headroom kept), so that alternating pushes and shrinks keep the items and do not reallocate on every call.
+ * Build: cc -O2 shrink_test.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ *        (and with -DVEC_COMPACT_HEADER)
+ */
+
+#include <stdio.h>
+
+#include "../v_base.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+/* A vector of capacity cap holding the first used items of ref */
+static uint32_t *filled(const uint32_t *ref, vsize_t cap, vsize_t used) {
+  uint32_t *v = VEC_new(cap, uint32_t);
+
+  memcpy(v, ref, used * sizeof *ref);
+  VEC_vusedSet(v, used);
+  return v;
+}
+
+static void toSize(const uint32_t *ref, vsize_t cap, vsize_t used, vsize_t n) {
+  uint32_t *v = filled(ref, cap, used), *w = v;
+  vsize_t i;
+
+  VEC_shrink(v, n);
+  if (n >= cap) {
+    CHECK((v == w) && (VEC_vsize(v) == cap) && (VEC_used(v) == used));
+  }
+  else {
+    CHECK((VEC_vsize(v) == n) && (VEC_used(v) == (used < n ? used : n)));
+    /* The last item of the new capacity is writable */
+    v[n - 1] = ref[n - 1];
+  }
+  CHECK(!memcmp(v, ref, VEC_used(v) * sizeof *ref));
+  CHECK(VEC_vdtype(v) == sizeof *ref);
+
+  /* And grown back */
+  for (i = VEC_used(v); i < used; i++)
+    VEC_push(v, ref[i]);
+  CHECK((VEC_used(v) == used) && !memcmp(v, ref, used * sizeof *ref));
+  VEC_destroy(v);
+}
+
+static void toFit(const uint32_t *ref, vsize_t cap, vsize_t used) {
+  const vsize_t fit = used + used / VEC_SHRINK_SLACK;
+  uint32_t *v = filled(ref, cap, used), *w = v;
+
+  VEC_shrink(v);
+  if ((fit >= cap) || ((cap - fit) < cap / VEC_SHRINK_MIN)) {
+    CHECK((v == w) && (VEC_vsize(v) == cap));
+  }
+  else
+    CHECK(VEC_vsize(v) == fit);
+  CHECK((VEC_used(v) == used) && !memcmp(v, ref, used * sizeof *ref));
+
+  /* A second shrink-to-fit has nothing to release */
+  w = v;
+  VEC_shrink(v);
+  CHECK(v == w);
+  VEC_destroy(v);
+}
+
+#define MAXN 5000
+
+int main(void) {
+  static const vsize_t caps[] = {1, 2, 8, 100, 254, 255, 256, 1024, 4096};
+  static uint32_t ref[MAXN];
+  uint32_t *v;
+  vsize_t i, j, n, shrinks, grows;
+
+  for (i = 0; i < MAXN; i++)
+    ref[i] = (uint32_t)next();
+
+  for (i = 0; i < sizeof caps / sizeof *caps; i++)
+    for (j = 0; j < 20; j++) {
+      n = j < 4 ? (vsize_t[]){0, 1, caps[i] / 2, caps[i]}[j] : next() % (caps[i] + 1);
+      toFit(ref, caps[i], n);
+      toSize(ref, caps[i], n, 1 + next() % (caps[i] + 8));
+    }
+
+  /* The examples of VEC_SHRINK_MIN and VEC_SHRINK_SLACK: 100 of 1024 kept with 12 more; 800 of 1024 not worth it */
+  v = filled(ref, 1024, 100);
+  VEC_shrink(v);
+  CHECK(VEC_vsize(v) == 100 + 100 / VEC_SHRINK_SLACK);
+  VEC_destroy(v);
+  v = filled(ref, 1024, 800);
+  VEC_shrink(v);
+  CHECK(VEC_vsize(v) == 1024);
+  VEC_destroy(v);
+
+  /* Push one, shrink-to-fit, over and over: the items stay those of ref, and only a shrink after a growth reallocates (the
+   * capacity still grows geometrically, by the VEC_SHRINK_SLACK headroom at least) */
+  v = VEC_new(1, uint32_t);
+  for (i = shrinks = grows = 0; i < MAXN; i++) {
+    n = VEC_vsize(v);
+    VEC_push(v, ref[i]);
+    grows += VEC_vsize(v) != n;
+    n = VEC_vsize(v);
+    VEC_shrink(v);
+    shrinks += VEC_vsize(v) != n;
+  }
+  CHECK((VEC_used(v) == MAXN) && !memcmp(v, ref, sizeof ref));
+  CHECK((shrinks <= grows) && (shrinks < MAXN / 50));
+  VEC_destroy(v);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,187 @@
+/* VEC_str against the same appends to a plain buffer through snprintf: bytes (with '\0's), C strings, integers in decimal and
+ * hexadecimal, floats (the shortest "%.Ng" that reads back) and printf formats, always '\0' terminated; VEC_strWrite to a file.
+ * VEC_Repr to a Pp_str must append the bytes VEC_Repr writes to a plain buffer, in a string grown by doubling (not reserved for the
+ * longest output of every item).
+ * Build: cc -O2 str_test.c ../v_str.c ../v_base.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+
+#include "../v_str.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+#define REFMAX (1 << 20)
+
+static char   ref[REFMAX];
+static size_t rlen;
+
+/* The fewest digits that read back, as "%.Ng" */
+static int shortest(char *b, size_t n, double f) {
+  int p, l = 0;
+
+  for (p = 1; p <= 17; p++) {
+    l = snprintf(b, n, "%.*g", p, f);
+    if (isnan(f) || (strtod(b, NULL) == f))
+      break;
+  }
+  return l;
+}
+
+static double randomFlt(void) {
+  static const double special[] = {0.0, -0.0, 1.0, 0.1, 1e-5, 1e-4, 123456.0, 1e16, 1e17, 1e22, DBL_MAX, DBL_MIN, 5e-324,
+				   INFINITY, -INFINITY, NAN};
+  uint64_t u;
+  double f;
+
+  if (!(next() % 4))
+    return special[next() % (sizeof special / sizeof *special)];
+  do {
+    u = next();
+    memcpy(&f, &u, sizeof f);
+  } while (isnan(f) || isinf(f));
+  return (next() % 2) ? f : (double)(int64_t)(next() % 2000000) / 1000;
+}
+
+static void appends(void) {
+  VEC_str s = VEC_strNew(1);
+  char b[64];
+  intmax_t i;
+  uintmax_t u;
+  double f;
+  int t, l;
+
+  rlen = 0;
+  while (rlen < REFMAX - 4096) {
+    switch (next() % 8) {
+    case 0:
+      l = (int)(next() % 40);
+      for (t = 0; t < l; t++)
+	b[t] = (char)next(); /* '\0' included */
+      VEC_strAppend(&s, b, (vsize_t)l);
+      memcpy(ref + rlen, b, (size_t)l);
+      break;
+    case 1:
+      VEC_strCat(&s, "abc");
+      l = snprintf(ref + rlen, REFMAX - rlen, "abc");
+      break;
+    case 2:
+      VEC_strPutc(&s, (char)next());
+      ref[rlen] = s[VEC_strLen(s) - 1];
+      l = 1;
+      break;
+    case 3:
+      i = (next() % 8) ? (intmax_t)next() >> (next() % 64) : (next() % 2) ? INTMAX_MIN : INTMAX_MAX;
+      VEC_strAppendInt(&s, i);
+      l = snprintf(ref + rlen, REFMAX - rlen, "%jd", i);
+      break;
+    case 4:
+      u = (next() % 8) ? (uintmax_t)next() >> (next() % 64) : UINTMAX_MAX * (next() % 2);
+      t = (int)(next() % 2);
+      VEC_strAppendUint(&s, u, t);
+      l = snprintf(ref + rlen, REFMAX - rlen, t ? "%#jx" : "%ju", u);
+      if (t && !u)
+	l = snprintf(ref + rlen, REFMAX - rlen, "0x0"); /* printf writes "0" for %#x of 0 */
+      break;
+    case 5:
+      f = randomFlt();
+      VEC_strAppendFlt(&s, f);
+      l = shortest(ref + rlen, REFMAX - rlen, f);
+      break;
+    default:
+      i = (intmax_t)(next() % 100000);
+      VEC_strAppendf(&s, "[%5jd|%-8s|%.3f]", i, "xy", (double)i / 7);
+      l = snprintf(ref + rlen, REFMAX - rlen, "[%5jd|%-8s|%.3f]", i, "xy", (double)i / 7);
+    }
+    rlen += (size_t)l;
+    if ((VEC_strLen(s) != rlen) || memcmp(s, ref, rlen) || s[rlen]) {
+      CHECK((VEC_strLen(s) == rlen) && !memcmp(s, ref, rlen) && !s[rlen]);
+      break;
+    }
+  }
+  CHECK(VEC_vsize(s) <= 2 * rlen + 64);
+
+#if !__WINDOWS__
+  {
+    FILE *fp = tmpfile();
+    char *back = malloc(rlen);
+
+    CHECK((fp != NULL) && (back != NULL));
+    if ((fp != NULL) && (back != NULL)) {
+      CHECK(VEC_strWrite(fileno(fp), s) == (ssize_t)rlen);
+      rewind(fp);
+      CHECK((fread(back, 1, rlen, fp) == rlen) && !memcmp(back, ref, rlen));
+    }
+    free(back);
+    if (fp != NULL)
+      fclose(fp);
+  }
+#endif
+
+  VEC_strClear(s);
+  CHECK(!VEC_strLen(s) && !s[0]);
+  VEC_strDestroy(s);
+}
+
+/* VEC_Repr, to a string holding a prefix and to a plain buffer */
+static void repr(vsize_t n, char *fmt) {
+  static char buf[1 << 22];
+  double *v = VEC_new(n | !n, double);
+  VEC_str s = VEC_strNew(8);
+  Pp_Setup a = {0}, b = {0};
+  vsize_t i;
+
+  for (i = 0; i < n; i++)
+    v[i] = (double)(int64_t)(next() % 2000000) / 8 - 125000;
+  VEC_vusedSet(v, n);
+
+  VEC_strCat(&s, "x=");
+  a.Pp_str = &s;
+  a.Pp_fmt = fmt;
+  VEC_Repr(v, &a);
+
+  b.Pp_buf  = buf;
+  b.Pp_size = sizeof buf;
+  b.Pp_fmt  = fmt;
+  VEC_Repr(v, &b);
+
+  CHECK((VEC_strLen(s) == 2 + strlen(buf)) && !strcmp(s + 2, buf) && (a.Pp_used == strlen(buf)));
+  /* Each slice reserves for its longest items, at most VEC_REPR_CHUNK bytes: not for the whole vector */
+  CHECK(VEC_vsize(s) <= 2 * (VEC_strLen(s) + VEC_REPR_CHUNK + 16) + 64);
+
+  VEC_destroy(v);
+  VEC_strDestroy(s);
+}
+
+int main(void) {
+  static const vsize_t lens[] = {0, 1, 7, 100, 5000, 100000};
+  unsigned i;
+
+  appends();
+  for (i = 0; i < sizeof lens / sizeof *lens; i++) {
+    repr(lens[i], "f");
+    repr(lens[i], "e");
+  }
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
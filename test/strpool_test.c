@@ -0,0 +1,121 @@
+/* VEC_strpool against an array of strings: Push, PushN, Get and Find, with and without interning. Strings of the pool itself
+ * (VEC_strpoolGet) are pushed again, one by one and in PushN, while the byte vector grows: they must be copied from where they
+ * are, not from the block they were in (run under AddressSanitizer to see a read of the freed block).
+ * Build: cc -O2 strpool_test.c ../v_strpool.c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c -lpthread -lm
+ */
+
+#include <stdio.h>
+
+#include "../v_strpool.h"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      printf("%s:%d: %s\n", __FILE__, __LINE__, #E);			\
+      bad++;								\
+    }									\
+  } while (0)
+
+#define NSTR 3000
+
+static char   ref[NSTR][24];
+static size_t reflen[NSTR];
+static vsize_t nref;
+
+static uint64_t rng = 88172645463325252ull;
+
+static uint64_t next(void) {
+  rng ^= rng << 13;
+  rng ^= rng >> 7;
+  rng ^= rng << 17;
+  return rng;
+}
+
+static void refPush(const char *s, size_t len) {
+  memcpy(ref[nref], s, len);
+  ref[nref][len] = '\0';
+  reflen[nref++] = len;
+}
+
+static long refFind(const char *s, size_t len) {
+  vsize_t i;
+
+  for (i = 0; i < nref; i++)
+    if ((reflen[i] == len) && !memcmp(ref[i], s, len))
+      return (long)i;
+  return -1;
+}
+
+static void compare(const VEC_strpool *sp) {
+  const char *s;
+  size_t len;
+  vsize_t i;
+
+  CHECK(VEC_strpoolSize(sp) == nref);
+  for (i = 0; (i < nref) && (i < VEC_strpoolSize(sp)); i++) {
+    s = VEC_strpoolGet(sp, i, &len);
+    CHECK((len == reflen[i]) && !memcmp(s, ref[i], len) && (s[len] == '\0'));
+    CHECK(VEC_strpoolFind(sp, ref[i], reflen[i]) == refFind(ref[i], reflen[i]));
+  }
+  CHECK(VEC_strpoolFind(sp, "absent", 6) == -1);
+}
+
+static void run(uint8_t flags) {
+  VEC_strpool sp;
+  const char *s, *batch[16];
+  size_t len, lens[16];
+  char b[24];
+  vsize_t i, j;
+
+  nref = 0;
+  VEC_strpoolInit(&sp, 1, 1, flags);
+
+  /* New strings (with repeats), and strings of the pool, each pushed while the pool is about to grow */
+  while (nref < NSTR / 2) {
+    if ((next() % 3) || !nref) {
+      len = (size_t)snprintf(b, sizeof b, "s%u", (unsigned)(next() % 500));
+      CHECK(VEC_strpoolPush(&sp, b, len) == nref);
+      refPush(b, len);
+    }
+    else {
+      j = next() % nref;
+      s = VEC_strpoolGet(&sp, j, &len);
+      refPush(ref[j], reflen[j]);
+      CHECK(VEC_strpoolPush(&sp, s, len) == nref - 1);
+    }
+  }
+  compare(&sp);
+
+  /* PushN of pool strings (NULL lengths: strlen) and of new ones (explicit lengths) */
+  while (nref + 16 <= NSTR) {
+    for (i = 0; i < 16; i++) {
+      if (i & 1) {
+	j        = next() % nref;
+	batch[i] = VEC_strpoolGet(&sp, j, NULL);
+	lens[i]  = reflen[j];
+      }
+      else {
+	lens[i]  = (size_t)snprintf(ref[nref + i], sizeof ref[0], "n%u", (unsigned)(next() % 2000));
+	batch[i] = ref[nref + i];
+      }
+    }
+    for (i = 0; i < 16; i++) {
+      memcpy(b, batch[i], lens[i]);
+      refPush(b, lens[i]);
+    }
+    CHECK(VEC_strpoolPushN(&sp, batch, (next() & 1) ? lens : NULL, 16) == nref - 16);
+  }
+  compare(&sp);
+
+  VEC_strpoolDestroy(&sp);
+}
+
+int main(void) {
+  run(0);
+  run(VEC_STRPOOL_INTERN);
+
+  printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
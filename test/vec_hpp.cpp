@@ -0,0 +1,190 @@
+/* C++ interface (v_base.hpp): compiles as C++ (no implicit void * conversions in v_base.h), and mvpg::vec agrees with the C API
+ * on the items it holds, through growth (VEC_INTERNAL_realloc), shrink_to_fit, and adopt / release of raw VEC vectors (batch
+ * vectors included), and vec(n) holds n items as std::vector does. A copy that throws during growth leaves the vec whole, and
+ * leaks no item (live counts Item objects).
+ * VEC_REPR_FMT: a valid format matches VEC_Repr; an unknown one, or one of another item size, is rejected when compiled
+ * (mvpg::repr_valid asserts it here; each of VEC_HPP_BADFMT=1 (unknown), =2 (item size) must fail to compile).
+ * Build: cc -c ../v_base.c ../v_str.c ../dtoa.c ../memtool.c ../include.c && c++ -std=c++17 -Wall vec_hpp.cpp *.o -lpthread -lm
+ */
+
+#include <cstdio>
+
+#include "../v_base.hpp"
+
+static unsigned long bad;
+
+#define CHECK(E)							\
+  do {									\
+    if (!(E)) {								\
+      std::printf("%s:%d: %s\n", __FILE__, __LINE__, #E);		\
+      bad++;								\
+    }									\
+  } while (0)
+
+/* Copyable only (no noexcept move), so growth copies; the copy numbered throwAt throws */
+struct Item {
+  static long live, copies, throwAt;
+  int x;
+
+  explicit Item(int i) : x(i) { live++; }
+  Item(const Item &o) : x(o.x) {
+    if (++copies == throwAt)
+      throw std::runtime_error("copy");
+    live++;
+  }
+  ~Item() {
+    live--;
+    x = -1; /* An item destroyed too early reads -1 */
+  }
+};
+long Item::live, Item::copies, Item::throwAt;
+
+static void grow() {
+  mvpg::vec<int> v;
+  int i;
+
+  for (i = 0; i < 1000; i++)
+    v.push_back(i * 3);
+  CHECK(v.size() == 1000);
+  CHECK(v.capacity() >= 1000);
+  CHECK(VEC_vused(v.raw()) == 1000);
+  for (i = 0; i < 1000; i++)
+    CHECK(v[i] == i * 3);
+
+  v.resize(10);
+  v.shrink_to_fit();
+  CHECK(v.capacity() == 10);
+  for (i = 0; i < 10; i++)
+    CHECK(v.at(i) == i * 3);
+}
+
+static void sized() {
+  /* vec(n) holds n value-initialized items, as std::vector(n) */
+  mvpg::vec<int> v(5), w(3, 7), e(0);
+  int i;
+
+  CHECK((v.size() == 5) && (v.capacity() == 5));
+  for (i = 0; i < 5; i++)
+    CHECK(v[i] == 0);
+  CHECK((w.size() == 3) && (w[0] == 7) && (w[2] == 7));
+  CHECK(e.empty());
+
+  Item::copies  = 0;
+  Item::throwAt = 3;
+  try {
+    mvpg::vec<Item> t(4, Item(1));
+    CHECK(false);
+  }
+  catch (const std::runtime_error &) {
+  }
+  Item::throwAt = 0;
+  CHECK(Item::live == 0);
+}
+
+static void growThrow() {
+  {
+    mvpg::vec<Item> v;
+    bool thrown = false;
+    int i;
+
+    for (i = 0; i < 8; i++)
+      v.emplace_back(i);
+    CHECK(v.size() == v.capacity());
+
+    Item::copies  = 0;
+    Item::throwAt = 5;
+    try {
+      v.emplace_back(8);
+    }
+    catch (const std::runtime_error &) {
+      thrown = true;
+    }
+    CHECK(thrown);
+    CHECK((v.size() == 8) && (Item::live == 8));
+    for (i = 0; i < 8; i++)
+      CHECK(v[i].x == i);
+
+    Item::throwAt = 0;
+    v.emplace_back(8);
+    CHECK((v.size() == 9) && (v[8].x == 8) && (Item::live == 9));
+  }
+  CHECK(Item::live == 0);
+}
+
+static void adopt() {
+  VEC_type(long) raw = VEC_typeCast(VEC_new(4, long), long);
+  long *r;
+  void *p;
+
+  raw[0] = 7;
+  raw[1] = 9;
+  VEC_vusedSet(raw, 2);
+
+  mvpg::vec<long> v = mvpg::vec<long>::adopt(raw);
+  v.push_back(11);
+  CHECK((v.size() == 3) && (v.front() == 7) && (v.back() == 11));
+
+  r = v.release();
+  CHECK(v.empty() && (VEC_vused(r) == 3) && (r[2] == 11));
+  p = r;
+  VEC_destroy(p);
+}
+
+static void adoptBatch() {
+  VEC_type(int) out[2];
+  void *b = VEC_newBatch(2, 4, int, out);
+  int i;
+
+  {
+    /* Destroyed in its slot: dropped; grown out of it: freed */
+    mvpg::vec<int> v = mvpg::vec<int>::adopt(out[0]), w = mvpg::vec<int>::adopt(out[1]);
+
+    v.push_back(1);
+    for (i = 0; i < 100; i++)
+      w.push_back(i);
+    CHECK((v.size() == 1) && (w.size() == 100) && (w[99] == 99));
+  }
+  out[0] = out[1] = NULL;
+  VEC_batchDestroy(b, out, 2);
+}
+
+static_assert(mvpg::repr_valid<int64_t>("h4") && mvpg::repr_valid<int64_t>("h4:^"), "h4 takes int64_t");
+static_assert(mvpg::repr_valid<float>("g") && mvpg::repr_valid<double>("g"), "g takes float and double");
+static_assert(!mvpg::repr_valid<int>("h4"), "h4 does not take int");
+static_assert(!mvpg::repr_valid<int>("h9") && !mvpg::repr_valid<int>("") && !mvpg::repr_valid<int>("d4"), "unknown formats");
+
+static void reprFmt() {
+  mvpg::vec<int64_t> v;
+  char a[256], b[256];
+  Pp_Setup s{}, t{};
+  int64_t i;
+
+  for (i = -3; i < 4; i++)
+    v.push_back(i * 1000000007);
+  s.Pp_buf  = a;
+  s.Pp_size = sizeof a;
+  s.Pp_fmt  = const_cast<char *>("h4");
+  t.Pp_buf  = b;
+  t.Pp_size = sizeof b;
+
+  VEC_Repr(v.data(), &s);
+  CHECK(VEC_REPR_FMT("h4:^")(v, t) == s.Pp_used);
+  CHECK(!std::strcmp(a, b) && !std::strcmp(b, "-3000000021, -2000000014, -1000000007, 0, 1000000007, 2000000014, 3000000021"));
+
+#if VEC_HPP_BADFMT == 1
+  VEC_REPR_FMT("h9")(v, t);
+#elif VEC_HPP_BADFMT == 2
+  VEC_REPR_FMT("d")(v, t);
+#endif
+}
+
+int main() {
+  grow();
+  sized();
+  growThrow();
+  adopt();
+  adoptBatch();
+  reprFmt();
+  std::printf("%s: %lu failures\n", bad ? "FAIL" : "ok", bad);
+  return bad != 0;
+}
@@ -0,0 +1,279 @@
+/* MVPG API Vector Type: Arrow C Data Interface
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_arrow.h"
+
+typedef uint8_t  u8;
+typedef int32_t  i32;
+typedef int64_t  i64;
+typedef uint64_t u64;
+
+/* Utf8View: 16 bytes per string, strings of at most ARROW_INLINE bytes are held in the view */
+#define ARROW_VIEW   16
+#define ARROW_INLINE 12
+
+/* Formats by VEC_kind */
+static const char *const arrowFormat[] = {
+  "c", "C", "s", "S", "i", "I", "l", "L", "f", "g"
+};
+
+/* Private data of an exported array: what release frees, and the buffers array */
+typedef struct {
+  void        *ap_vec;      /* Items (NULL for a string pool) */
+  u64         *ap_valid;    /* Validity bit vector, or NULL */
+  VEC_strpool  ap_pool;     /* String pool (VEC_ARROW_OWN) */
+  char        *ap_views;    /* Utf8View views, always owned */
+  const void  *ap_bufs[4];
+  i64          ap_sizes[1]; /* Utf8View: size of the data buffer */
+  u8           ap_own;
+} arrowPriv;
+
+static void arrowSchemaRelease(struct ArrowSchema *sch) {
+  sch->release = NULL;
+}
+
+static void arrowRelease(struct ArrowArray *arr) {
+  arrowPriv *p = arr->private_data;
+
+  if (p->ap_own) {
+    VEC_destroy(p->ap_vec);
+    VEC_destroy(p->ap_valid);
+    VEC_strpoolDestroy(&p->ap_pool);
+  }
+  VEC_destroy(p->ap_views);
+  free(p);
+  arr->release = NULL;
+}
+
+__NONNULL__ static void arrowSchema(struct ArrowSchema *sch, const char *fmt, bool nullable) {
+  sch->format       = fmt;
+  sch->name         = "";
+  sch->metadata     = NULL;
+  sch->flags        = nullable ? ARROW_FLAG_NULLABLE : 0;
+  sch->n_children   = 0;
+  sch->children     = NULL;
+  sch->dictionary   = NULL;
+  sch->release      = arrowSchemaRelease;
+  sch->private_data = NULL;
+}
+
+static i64 arrowNulls(const u64 *valid, vsize_t n) {
+  /* Clear bits among the first n of valid */
+  vsize_t i, c;
+
+  if (valid == NULL)
+    return 0;
+  VEC_assert(VEC_used(valid) >= (n + 63) / 64, "VEC_toArrow: validity bit vector shorter than the vector");
+
+  for (i = c = 0; i < n / 64; i++)
+    c += POPCNT64(valid[i]);
+  if (n % 64)
+    c += POPCNT64(valid[i] & ((1ull << (n % 64)) - 1));
+  return (i64)(n - c);
+}
+
+__NONNULL__ static arrowPriv *arrowArray(struct ArrowArray *arr, vsize_t n, u64 *valid, int64_t nbuf, uint8_t flags) {
+  arrowPriv *p = calloc(1, sizeof *p);
+
+  VEC_assert(p != NULL, "VEC_toArrow: out of memory");
+  p->ap_valid   = valid;
+  p->ap_own     = flags & VEC_ARROW_OWN;
+  p->ap_bufs[0] = valid;
+
+  arr->length       = n;
+  arr->null_count   = arrowNulls(valid, n);
+  arr->offset       = 0;
+  arr->n_buffers    = nbuf;
+  arr->n_children   = 0;
+  arr->buffers      = p->ap_bufs;
+  arr->children     = NULL;
+  arr->dictionary   = NULL;
+  arr->release      = arrowRelease;
+  arr->private_data = p;
+  return p;
+}
+
+__NONNULL__ static u64 *arrowBits(const u8 *src, i64 off, vsize_t n) {
+  /* Bit vector of the n bits of src from bit off (bits past n are cleared) */
+  const vsize_t nw = (n + 63) / 64, nb = (vsize_t)(off + n + 7) / 8;
+  const u8 s = off & 7;
+  vsize_t j, q;
+  u8 *d;
+  u64 *m;
+
+  m = VEC_new(nw | !nw, u64);
+  VEC_vusedSet(m, nw);
+
+  src += off / 8;
+  d = (u8 *)m;
+  for (j = 0, q = off / 8; j < (n + 7) / 8; j++, q++)
+    d[j] = s ? (src[j] >> s) | ((q + 1 < nb ? src[j + 1] : 0) << (8 - s)) : src[j];
+  if (n % 64)
+    m[nw - 1] &= (1ull << (n % 64)) - 1;
+  return m;
+}
+
+/****************************************************************************************************************************************
+
+ * EXPORT
+
+****************************************************************************************************************************************/
+
+__NONNULL__ void VEC_toArrow(struct ArrowArray *arr, struct ArrowSchema *sch, void *v, VEC_kind k, uint64_t *valid, uint8_t flags) {
+  arrowPriv *p;
+
+  VEC_assert(VEC_kindSize(k) == VEC_vdtype(v), "VEC_toArrow: kind does not match the vector dtype");
+
+  p = arrowArray(arr, VEC_used(v), valid, 2, flags);
+  p->ap_vec     = v;
+  p->ap_bufs[1] = v;
+  arrowSchema(sch, arrowFormat[k], valid != NULL);
+}
+
+__NONNULL__ void VEC_strpoolToArrow(struct ArrowArray *arr, struct ArrowSchema *sch, VEC_strpool *sp, uint64_t *valid, uint8_t flags) {
+  const vsize_t n = VEC_strpoolSize(sp);
+  arrowPriv *p;
+  const char *s;
+  vsize_t i;
+  size_t len;
+  char *w;
+  i32 x;
+
+  VEC_assert(VEC_strpoolBytes(sp) <= INT32_MAX, "VEC_strpoolToArrow: string bytes over 2GB");
+
+  p = arrowArray(arr, n, valid, 4, flags);
+  p->ap_views = VEC_new((n | !n) * ARROW_VIEW, char);
+
+  for (i = 0, w = p->ap_views; i < n; i++, w += ARROW_VIEW) {
+    s = VEC_strpoolGet(sp, i, &len);
+    x = (i32)len;
+    memcpy(w, &x, 4);
+    if (len <= ARROW_INLINE) {
+      /* Inline (the views are zeroed, as is any allocation) */
+      memcpy(w + 4, s, len);
+      continue;
+    }
+    memcpy(w + 4, s, 4);
+    x = 0;
+    memcpy(w + 8, &x, 4);
+    x = (i32)sp->sp_offs[i];
+    memcpy(w + 12, &x, 4);
+  }
+
+  p->ap_sizes[0] = VEC_strpoolBytes(sp);
+  p->ap_bufs[1]  = p->ap_views;
+  p->ap_bufs[2]  = sp->sp_bytes;
+  p->ap_bufs[3]  = p->ap_sizes;
+
+  if (p->ap_own) {
+    /* Move the pool into the array */
+    p->ap_pool = *sp;
+    memset(sp, 0, sizeof *sp);
+  }
+  arrowSchema(sch, "vu", valid != NULL);
+}
+
+/****************************************************************************************************************************************
+
+ * IMPORT
+
+****************************************************************************************************************************************/
+
+__NONNULL__ static int arrowKind(const char *fmt) {
+  int k;
+
+  for (k = VEC_I8; k <= VEC_F64; k++) {
+    if (! strcmp(fmt, arrowFormat[k]))
+      return k;
+  }
+  return -1;
+}
+
+__NONNULL__ static u64 *arrowValidity(const struct ArrowArray *arr) {
+  return (arr->null_count != 0) && (arr->n_buffers > 0) && (arr->buffers[0] != NULL) ?
+    arrowBits(arr->buffers[0], arr->offset, arr->length) : NULL;
+}
+
+void *VEC_fromArrow(struct ArrowArray *arr, const struct ArrowSchema *sch, uint64_t **valid) {
+  const int k = arrowKind(sch->format);
+  arrowPriv *p = arr->private_data;
+  vsize_t dt, n;
+  u64 *m;
+  void *v;
+
+  VEC_assert(arr->release != NULL, "VEC_fromArrow: released array");
+  VEC_assert(k >= 0, "VEC_fromArrow: unsupported format (integer and float arrays only)");
+
+  n  = arr->length;
+  dt = VEC_kindSize(k);
+
+  if ((arr->release == arrowRelease) && p->ap_own && (p->ap_vec != NULL) && (arr->offset == 0)
+      && ((vsize_t)arr->length == VEC_used(p->ap_vec))) {
+    /* Our own export: take the vectors back */
+    v = p->ap_vec;
+    m = p->ap_valid;
+    p->ap_vec = p->ap_valid = NULL;
+  }
+  else {
+    v = VEC_newFrmSize(n | !n, dt);
+    mvpgMemcpy(v, (const char *)arr->buffers[1] + arr->offset * dt, n * dt);
+    VEC_vusedSet(v, n);
+    m = arrowValidity(arr);
+  }
+  arr->release(arr);
+
+  if (valid != NULL)
+    *valid = m;
+  else
+    VEC_destroy(m);
+  return v;
+}
+
+__NONNULL__ void VEC_strpoolFromArrow(VEC_strpool *sp, struct ArrowArray *arr, const struct ArrowSchema *sch, uint64_t **valid) {
+  const char *f = sch->format, *s;
+  const u8 *w;
+  i64 i, a, b;
+  i32 x, bi;
+  size_t len;
+
+  VEC_assert(arr->release != NULL, "VEC_strpoolFromArrow: released array");
+  VEC_assert(!strcmp(f, "u") || !strcmp(f, "U") || !strcmp(f, "vu"), "VEC_strpoolFromArrow: unsupported format (u, U or vu)");
+
+  for (i = arr->offset; i < arr->offset + arr->length; i++) {
+    if (f[0] == 'v') {
+      w = (const u8 *)arr->buffers[1] + i * ARROW_VIEW;
+      memcpy(&x, w, 4);
+      len = x;
+      s = (const char *)w + 4;
+      if (len > ARROW_INLINE) {
+        memcpy(&bi, w + 8, 4);
+        memcpy(&x, w + 12, 4);
+        s = (const char *)arr->buffers[2 + bi] + x;
+      }
+    }
+    else {
+      if (f[0] == 'u') {
+        a = ((const i32 *)arr->buffers[1])[i];
+        b = ((const i32 *)arr->buffers[1])[i + 1];
+      }
+      else {
+        a = ((const i64 *)arr->buffers[1])[i];
+        b = ((const i64 *)arr->buffers[1])[i + 1];
+      }
+      s   = (const char *)arr->buffers[2] + a;
+      len = b - a;
+    }
+    VEC_strpoolPush(sp, s, len);
+  }
+
+  if (valid != NULL)
+    *valid = arrowValidity(arr);
+  arr->release(arr);
+}
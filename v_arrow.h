@@ -0,0 +1,78 @@
+/* MVPG API Vector Type: Arrow C Data Interface
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_ARROW_H
+#define V_ARROW_H
+
+#include "v_base.h"
+#include "v_strpool.h"
+
+/*                    ARROW C DATA INTERFACE (EXPORT / IMPORT)
+ *
+ * VEC_toArrow(A, S, V, K, M, F):         export the vector V of kind K, with the validity bit vector M (NULL: no nulls), as A and S
+ * VEC_strpoolToArrow(A, S, SP, M, F):    export the strings of SP as a Utf8View ("vu") array
+ * VEC_fromArrow(A, S, &M):               import a primitive array as a new vector, and its validity as a new bit vector *M (M may be NULL)
+ * VEC_strpoolFromArrow(SP, A, S, &M):    import a string array ("u", "U" or "vu") into SP (initialized by the caller)
+ *
+ * Bit vectors are those of VEC_filterMask (bit i of M[i / 64] is item i), which is the Arrow validity layout
+ * on little-endian hosts: they are exported as is.
+ * Items are exported without copy: buffers point to the vector items, which are 8 bytes aligned.
+ * Strings are exported as views into sp_bytes (Utf8View allows gaps and repeats, as left by the length prefixes and interning);
+ * only the 16 bytes views are built, the string bytes are not copied. sp_bytes must then be under 2GB.
+ *
+ * With VEC_ARROW_OWN in F, the array takes the vectors (and SP, which is then emptied): its release callback destroys them.
+ * Else they are borrowed, and must outlive the array unchanged (not grown). The schema never refers to them.
+ *
+ * Import consumes A (its release callback is called). An array exported by VEC_toArrow with VEC_ARROW_OWN, at offset 0,
+ * hands its vectors back without copy; other arrays are copied with memcpy (and bit shifts for a validity bitmap at an offset).
+ */
+
+#define VEC_ARROW_OWN 0x01
+
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE           2
+#define ARROW_FLAG_MAP_KEYS_SORTED    4
+
+struct ArrowSchema {
+  const char          *format;
+  const char          *name;
+  const char          *metadata;
+  int64_t              flags;
+  int64_t              n_children;
+  struct ArrowSchema **children;
+  struct ArrowSchema  *dictionary;
+  void               (*release)(struct ArrowSchema *);
+  void                *private_data;
+};
+
+struct ArrowArray {
+  int64_t             length;
+  int64_t             null_count;
+  int64_t             offset;
+  int64_t             n_buffers;
+  int64_t             n_children;
+  const void        **buffers;
+  struct ArrowArray **children;
+  struct ArrowArray  *dictionary;
+  void              (*release)(struct ArrowArray *);
+  void               *private_data;
+};
+
+#endif /* ARROW_C_DATA_INTERFACE */
+
+void  VEC_toArrow          (struct ArrowArray *arr, struct ArrowSchema *sch, void *v, VEC_kind k, uint64_t *valid, uint8_t flags);
+void  VEC_strpoolToArrow   (struct ArrowArray *arr, struct ArrowSchema *sch, VEC_strpool *sp, uint64_t *valid, uint8_t flags);
+void *VEC_fromArrow        (struct ArrowArray *arr, const struct ArrowSchema *sch, uint64_t **valid);
+void  VEC_strpoolFromArrow (VEC_strpool *sp, struct ArrowArray *arr, const struct ArrowSchema *sch, uint64_t **valid);
+
+#endif /* V_ARROW_H */
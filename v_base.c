@@ -9,8 +9,20 @@ You should have received a copy of the GNU General Public License along with thi
 */
 
 #include "v_base.h"
+#include "v_str.h"
+#include "dtoa.h"
+#include <stdatomic.h>
+#if !__WINDOWS__
+    #include <unistd.h>
+    #include <fcntl.h>
+#endif
 #ifdef VEC_INTERNAL_CCS
 
+#if !defined(VEC_REPR_NOSIMD) && defined(__SSSE3__)
+    #include <immintrin.h>
+    #define REPR_SIMD 1
+#endif
+
 static const DBLT__ Precalc_2powDdivP[16] =
   {
    // 2^d/p or p_root(2^d); P = 16
@@ -50,6 +62,7 @@ static const DBLT__ Precalc_2powDdivP[16] =
 
 enum {
       PTR  = 0x01,  USIGNED = 0x02,  CHAR   = 0x04,
+      FLT_E = 0x08, FLT_F   = 0x10,  FLT    = 0x20,
       L_8  = 0,     L_16    = 0x100, L_32   = 0x200,
       L_64 = 0x400, L_128   = 0x800, H_SPEC = 0x100,
       TYPE = 0x7f,  WIDTH   = 0xf00, BASE   = 0x1000
@@ -193,40 +206,412 @@ static inline void floatRepr(DBLT__ f) {
   PASS;
 }
 
-__NONNULL__ __STATIC_FORCE_INLINE_F void VEC_Itoa(const intmax_t n, Pp_Setup *cf) {
-  const vsize_t U = cf->Pp_used, O = cf->Pp_overflw;
+/* Decimal conversion of a whole vector
+ * Digits are written in place by MvpgInclude_Utoa10 (two at a time, from a table), without a call chain per item.
+ * With SSSE3, items of 9 to 16 digits are converted in one register: n = hi * 10^8 + lo, then each half is split in 4 digits
+ * pairs (abcd, efgh) by a reciprocal multiplication, and in digits by reciprocal multiplications by 10^-1, 10^-2, 10^-3 in 16-bit
+ * lanes; the 16 digits are shifted over the leading zeros with a shuffle, and stored at once (REPR_SIMDROOM bytes must be free).
+ */
+#define REPR_SIMDROOM 17 /* sign + 16 bytes store */
+
+#ifdef REPR_SIMD
+static const uint8_t Reprshift__[32] =
+  {
+   0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15,
+   0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80
+  };
+
+__STATIC_FORCE_INLINE_F __m128i reprDigits8(uint32_t n) {
+  /* Digits of n < 10^8, one per 16-bit lane */
+  const __m128i x    = _mm_cvtsi32_si128(n);
+  const __m128i abcd = _mm_srli_epi64(_mm_mul_epu32(x, _mm_set1_epi32((int)0xd1b71759)), 45);
+  const __m128i efgh = _mm_sub_epi32(x, _mm_mul_epu32(abcd, _mm_set1_epi32(10000)));
+  __m128i v;
+
+  /* [abcd * 4 (x4), efgh * 4 (x4)] / [10^3, 10^2, 10, 1] = [a, ab, abc, abcd, e, ef, efg, efgh] */
+  v = _mm_slli_epi64(_mm_unpacklo_epi16(abcd, efgh), 2);
+  v = _mm_unpacklo_epi16(v, v);
+  v = _mm_unpacklo_epi32(v, v);
+  v = _mm_mulhi_epu16(v, _mm_setr_epi16(8389, 5243, 13108, (short)32768, 8389, 5243, 13108, (short)32768));
+  v = _mm_mulhi_epu16(v, _mm_setr_epi16(1 << 7, 1 << 11, 1 << 13, (short)(1 << 15), 1 << 7, 1 << 11, 1 << 13, (short)(1 << 15)));
+
+  /* Less 10 times the preceding lane: [a, b, c, d, e, f, g, h] */
+  return _mm_sub_epi16(v, _mm_slli_epi64(_mm_mullo_epi16(v, _mm_set1_epi16(10)), 16));
+}
+
+__STATIC_FORCE_INLINE_F unsigned int reprDec16(uint64_t n, char *bf, unsigned int len) {
+  /* The len digits of n < 10^16; 16 bytes are stored */
+  const uint64_t hi = n / 100000000;
+  __m128i d;
 
-  if (LIKELY___(((cf->Pp_size - U) > O) && (U < (VSIZE_MAX - O)), 1)) {
-    MvpgMacro_Ignore(U && COMMA(cf->Pp_buf));
+  d = _mm_packus_epi16(reprDigits8((uint32_t)hi), reprDigits8((uint32_t)(n - hi * 100000000)));
+  d = _mm_add_epi8(d, _mm_set1_epi8('0'));
+  d = _mm_shuffle_epi8(d, _mm_loadu_si128((const __m128i *)(Reprshift__ + 16 - len)));
+  _mm_storeu_si128((__m128i *)bf, d);
+  return len;
+}
+#endif
 
-    cf->Pp_used += MvpgInclude_Itoa(n, cf->Pp_buf+U+2, !!(cf->Pp_mask & BASE), !(cf->Pp_mask & USIGNED) && (n < 0));
+__STATIC_FORCE_INLINE_F unsigned int reprDec(uint64_t n, char *bf, bool room) {
+#ifdef REPR_SIMD
+  uint64_t top;
+  unsigned int t;
+
+  if (room && (n >= 100000000)) {
+    if (n < 10000000000000000ull)
+      return reprDec16(n, bf, MvpgInclude_DecLen(n));
+
+    top = n / 10000000000000000ull;
+    t   = MvpgInclude_Utoa10(top, bf);
+    return t + reprDec16(n - top * 10000000000000000ull, bf + t, 16);
   }
+#else
+  MvpgMacro_Ignore(room);
+#endif
+  return MvpgInclude_Utoa10(n, bf);
 }
 
-__NONNULL__ void VEC_TostrInt(void *v, Pp_Setup *cf) {
-  char *saveBuf;
+__STATIC_FORCE_INLINE_F unsigned int reprDecS(int64_t x, char *bf, const char *end) {
+  const bool neg = x < 0;
+
+  *bf = '-';
+  return neg + reprDec(neg ? -(uint64_t)x : (uint64_t)x, bf + neg, (end - bf) >= REPR_SIMDROOM);
+}
 
-  if (cf->Pp_mask & PTR) {
-    // Undone
-    cf->Pp_overflw = 22;
+__STATIC_FORCE_INLINE_F unsigned int reprDecU(uint64_t x, char *bf, const char *end) {
+  return reprDec(x, bf, (end - bf) >= REPR_SIMDROOM);
+}
+
+__STATIC_FORCE_INLINE_F unsigned int reprHex(intmax_t x, char *bf, bool u) {
+  return MvpgInclude_Itoa(x, bf, 16, !u && (x < 0));
+}
+
+/* Items from p_ while the room exceeds O (the longest item with its separator); CONV writes *p_ at b_, and returns its length.
+ * Items after the first of the output are preceded by ", " (Pp_cont: the output continues a former one, the first too) */
+#define REPR_LOOP(T, CONV)						\
+  do {									\
+    const T *p_ = p, *const e_ = p_ + n;				\
+									\
+    for ( ; (p_ != e_) && ((vsize_t)(end - b_) > O); p_++) {		\
+      if ((b_ != cf->Pp_buf) || cf->Pp_cont)				\
+	MvpgMacro_Ignore(COMMA(b_));					\
+      b_ += CONV;							\
+    }									\
+    k = p_ - (const T *)p;						\
+  } while (0)
+
+/* Slice formatters: write the n items at p at Pp_buf + Pp_used, as far as they surely fit; return the count written.
+ * One per item type and format, so that the loop holds no format test */
+typedef vsize_t (*reprSliceFn)(const void *p, vsize_t n, Pp_Setup *cf);
+
+#define REPR_SLICE(NAME, T, CONV)					\
+  __NONNULL__ static vsize_t NAME(const void *p, vsize_t n, Pp_Setup *cf) { \
+    const vsize_t O = cf->Pp_overflw;					\
+    const char *end = cf->Pp_buf + cf->Pp_size;				\
+    char *b_ = cf->Pp_buf + cf->Pp_used;				\
+    vsize_t k;								\
+									\
+    if ((cf->Pp_size <= cf->Pp_used) || (cf->Pp_size - cf->Pp_used <= O)) \
+      return 0;								\
+    REPR_LOOP(T, CONV);							\
+    *b_ = '\0';								\
+    cf->Pp_used = b_ - cf->Pp_buf;					\
+    MvpgMacro_Ignore(end);						\
+    return k;								\
+  }
 
+REPR_SLICE(reprSliceI8,  int8_t,   reprDecS(*p_, b_, end))
+REPR_SLICE(reprSliceU8,  uint8_t,  reprDecU(*p_, b_, end))
+REPR_SLICE(reprSliceI16, int16_t,  reprDecS(*p_, b_, end))
+REPR_SLICE(reprSliceU16, uint16_t, reprDecU(*p_, b_, end))
+REPR_SLICE(reprSliceI32, int32_t,  reprDecS(*p_, b_, end))
+REPR_SLICE(reprSliceU32, uint32_t, reprDecU(*p_, b_, end))
+REPR_SLICE(reprSliceI64, int64_t,  reprDecS(*p_, b_, end))
+REPR_SLICE(reprSliceU64, uint64_t, reprDecU(*p_, b_, end))
+
+REPR_SLICE(reprSliceX8,   int8_t,   reprHex(*p_, b_, 0))
+REPR_SLICE(reprSliceXU8,  uint8_t,  reprHex(*p_, b_, 1))
+REPR_SLICE(reprSliceX16,  int16_t,  reprHex(*p_, b_, 0))
+REPR_SLICE(reprSliceXU16, uint16_t, reprHex(*p_, b_, 1))
+REPR_SLICE(reprSliceX32,  int32_t,  reprHex(*p_, b_, 0))
+REPR_SLICE(reprSliceXU32, uint32_t, reprHex(*p_, b_, 1))
+REPR_SLICE(reprSliceX64,  int64_t,  reprHex(*p_, b_, 0))
+REPR_SLICE(reprSliceXU64, uint64_t, reprHex(*p_, b_, 1))
+
+REPR_SLICE(reprSliceG32, float,  mvpgFtoa(*p_, b_, 'g'))
+REPR_SLICE(reprSliceE32, float,  mvpgFtoa(*p_, b_, 'e'))
+REPR_SLICE(reprSliceF32, float,  mvpgFtoa(*p_, b_, 'f'))
+REPR_SLICE(reprSliceG64, double, mvpgDtoa(*p_, b_, 'g'))
+REPR_SLICE(reprSliceE64, double, mvpgDtoa(*p_, b_, 'e'))
+REPR_SLICE(reprSliceF64, double, mvpgDtoa(*p_, b_, 'f'))
+
+__NONNULL__ static reprSliceFn VEC_reprSlice(const Pp_Setup *cf) {
+  /* Formatter of the format (Pp_mask, Pp_dtype), chosen once per repr */
+  static const reprSliceFn dec[8] = {
+    reprSliceI8, reprSliceU8, reprSliceI16, reprSliceU16, reprSliceI32, reprSliceU32, reprSliceI64, reprSliceU64
+  };
+  static const reprSliceFn hex[8] = {
+    reprSliceX8, reprSliceXU8, reprSliceX16, reprSliceXU16, reprSliceX32, reprSliceXU32, reprSliceX64, reprSliceXU64
+  };
+  static const reprSliceFn flt[2][3] = {
+    {reprSliceG32, reprSliceE32, reprSliceF32}, {reprSliceG64, reprSliceE64, reprSliceF64}
+  };
+  /* L_8: 0, L_16: 1, L_32: 2, L_64 (and wider): 3 */
+  const unsigned int w = ((cf->Pp_mask & WIDTH) >> 8) < 3 ? (cf->Pp_mask & WIDTH) >> 8 : 3;
+
+  if (cf->Pp_mask & FLT)
+    return flt[cf->Pp_dtype == sizeof(double)][(cf->Pp_mask & FLT_E) ? 1 : (cf->Pp_mask & FLT_F) ? 2 : 0];
+  return ((cf->Pp_mask & BASE) ? hex : dec)[(w << 1) | !!(cf->Pp_mask & USIGNED)];
+}
+
+#if !__WINDOWS__
+__NONNULL__ int VEC_reprSinkFd(void *fd, const char *p, vsize_t n) {
+  /* Resumes partial writes */
+  ssize_t w;
+
+  for ( ; n; p += w, n -= w) {
+    if ((w = write((int)(intptr_t)fd, p, n)) < 0) {
+      if (errno == EINTR) {
+	w = 0;
+	continue;
+      }
+      return -1;
+    }
+  }
+  return 0;
+}
+#endif
+
+__NONNULL__ int VEC_reprSinkFile(void *f, const char *p, vsize_t n) {
+  return fwrite(p, 1, n, f) == n ? 0 : -1;
+}
+
+__NONNULL__ static void VEC_reprStream(const void *v, Pp_Setup *cf, reprSliceFn slice) {
+  /* Format in the chunk, and hand it to the sink whenever the next item may not fit: memory use is the chunk, whatever the
+   * vector size. Pp_buf[0, Pp_used) is passed first. Pp_used is then the count of bytes passed */
+  char chunk[VEC_REPR_CHUNK];
+  const char *p = v;
+  const vsize_t dt = VEC_vdtype(v);
+  vsize_t n = VEC_vused(v), k, total = 0;
+  const bool own = cf->Pp_buf == NULL;
+
+  if (own) {
+    cf->Pp_buf  = chunk;
+    cf->Pp_size = sizeof chunk;
+    cf->Pp_used = 0;
+  }
+  VEC_assert(cf->Pp_size > cf->Pp_overflw, "Repr: Stream chunk is shorter than an item");
+
+  cf->Pp_serr = 0;
+  do {
+    k  = slice(p, n, cf);
+    p += k * dt;
+    n -= k;
+    if (cf->Pp_used && ((cf->Pp_serr = cf->Pp_sink(cf->Pp_sinkarg, cf->Pp_buf, cf->Pp_used)) != 0))
+      break;
+    total += cf->Pp_used;
+    cf->Pp_cont = cf->Pp_cont || cf->Pp_used;
+    cf->Pp_used = 0;
+  } while (n);
+
+  cf->Pp_cont = 0;
+  cf->Pp_used = total;
+  if (own) {
+    cf->Pp_buf  = NULL;
+    cf->Pp_size = 0;
+  }
+}
+
+__NONNULL__ static void VEC_reprAppend(const void *v, Pp_Setup *cf, reprSliceFn slice) {
+  /* Append to the VEC_str in slices of at most VEC_REPR_CHUNK bytes of longest items (and room for a 16 bytes store), the string
+   * growing (doubling) as in reprFormat: the reserve follows the output, not the longest output of every item.
+   * Pp_buf is then the start of the output, and Pp_used its length */
+  const char *p = v;
+  const vsize_t dt = VEC_vdtype(v), O = cf->Pp_overflw, m = VEC_REPR_CHUNK / O, start = VEC_vused(*cf->Pp_str);
+  vsize_t n = VEC_vused(v), k;
+  const uint8_t cont = cf->Pp_cont;
+
+  do {
+    VEC_strReserve(cf->Pp_str, (n < m ? n : m) * O + 16);
+    cf->Pp_buf  = *cf->Pp_str + VEC_vused(*cf->Pp_str);
+    cf->Pp_size = VEC_vsize(*cf->Pp_str) - VEC_vused(*cf->Pp_str);
+    cf->Pp_used = 0;
+    k  = slice(p, n, cf);
+    p += k * dt;
+    n -= k;
+    VEC_vusedSet(*cf->Pp_str, VEC_vused(*cf->Pp_str) + cf->Pp_used);
+    cf->Pp_cont = cf->Pp_cont || cf->Pp_used;
+  } while (n);
+
+  (*cf->Pp_str)[VEC_vused(*cf->Pp_str)] = '\0';
+  cf->Pp_cont = cont;
+  cf->Pp_buf  = *cf->Pp_str + start;
+  cf->Pp_size = VEC_vsize(*cf->Pp_str) - start;
+  cf->Pp_used = VEC_vused(*cf->Pp_str) - start;
+}
+
+/* Parallel repr: the vector is cut in one chunk per thread, each formatted in its own string (the chunks after the first begin with
+ * the separator); the prefix sums of their lengths are their offsets in the output, where they are copied (or written with
+ * pwrite) in parallel. The output is the sequential one, byte for byte.
+ */
+typedef struct {
+  const char *rj_v;
+  vsize_t     rj_n, rj_chunk;
+  Pp_Setup   *rj_cf;
+  reprSliceFn rj_slice;
+  bool        rj_cont;                     /* The first chunk is preceded by a separator */
+  char       *rj_out[MVPG_MAXTHREADS];     /* Chunk strings (VEC vectors of char) */
+  vsize_t     rj_off[MVPG_MAXTHREADS + 1]; /* Offsets of the chunks */
+  char       *rj_dst;                      /* Place phase: copy to rj_dst, or write to rj_fd at rj_base (if rj_dst is NULL) */
+  int         rj_fd;
+  int64_t     rj_base;
+  _Atomic int rj_err;
+} reprJob;
+
+static void reprFormat(void *arg, size_t i) {
+  reprJob *j = arg;
+  const vsize_t dt = j->rj_cf->Pp_dtype, first = i * j->rj_chunk;
+  const char *p = j->rj_v + first * dt;
+  vsize_t n = (j->rj_n - first < j->rj_chunk) ? j->rj_n - first : j->rj_chunk, k;
+  Pp_Setup c = *j->rj_cf;
+  char *s = VEC_new(VEC_REPR_CHUNK, char);
+
+  /* Slices while the string grows (doubling) */
+  c.Pp_cont = i ? 1 : j->rj_cont;
+  while (n) {
+    VEC_strReserve(&s, VEC_REPR_CHUNK);
+    c.Pp_buf  = s + VEC_vused(s);
+    c.Pp_size = VEC_vsize(s) - VEC_vused(s);
+    c.Pp_used = 0;
+    k  = j->rj_slice(p, n, &c);
+    p += k * dt;
+    n -= k;
+    VEC_vusedSet(s, VEC_vused(s) + c.Pp_used);
+    c.Pp_cont = c.Pp_cont || c.Pp_used;
+  }
+  j->rj_out[i] = s;
+}
+
+static void reprPlace(void *arg, size_t i) {
+  reprJob *j = arg;
+  const char *s = j->rj_out[i];
+  vsize_t n = VEC_vused(s), o = j->rj_off[i];
+#if !__WINDOWS__
+  ssize_t w;
+#endif
+
+  if (j->rj_dst != NULL) {
+    mvpgMemcpy(j->rj_dst + o, s, n);
     return;
   }
+#if !__WINDOWS__
+  for ( ; n; s += w, n -= w, o += w) {
+    if ((w = pwrite(j->rj_fd, s, n, j->rj_base + o)) < 0) {
+      if (errno == EINTR) {
+	w = 0;
+	continue;
+      }
+      atomic_store(&j->rj_err, -1);
+      return;
+    }
+  }
+#endif
+}
 
-  switch (cf->Pp_mask & WIDTH) {
-  case L_16:
-    cf->Pp_overflw = 7; // digits(short) + len(", ")
-    VEC_map(v, VEC_Itoa, int16_t, cf);
-    break;
-  case L_64:
-    cf->Pp_overflw = 22;
-    VEC_map(v, VEC_Itoa, int64_t, cf);
-    break;
-  default:
-    cf->Pp_overflw = 12;
-    VEC_map(v, VEC_Itoa, int32_t, cf);
-    break;
+__NONNULL__ static bool VEC_reprParallel(const void *v, Pp_Setup *cf, reprSliceFn slice) {
+  /* false if the output would not fit Pp_buf (the sequential repr truncates it); nothing is written then */
+  reprJob j;
+  vsize_t i, nt, total, max;
+  char *dst = NULL;
+
+  max = cf->Pp_threads < MVPG_MAXTHREADS ? cf->Pp_threads : MVPG_MAXTHREADS;
+  nt  = VEC_vused(v) / VEC_REPR_PARMIN;
+  nt  = nt < max ? nt : max;
+
+  j.rj_v     = v;
+  j.rj_n     = VEC_vused(v);
+  j.rj_chunk = (j.rj_n + nt - 1) / nt;
+  nt         = (j.rj_n + j.rj_chunk - 1) / j.rj_chunk; /* The rounded up chunks may cover the items in fewer than nt */
+  j.rj_cf    = cf;
+  j.rj_slice = slice;
+  j.rj_cont  = cf->Pp_cont || ((cf->Pp_str == NULL) && (cf->Pp_buf != NULL) && cf->Pp_used);
+  atomic_init(&j.rj_err, 0);
+  MvpgInclude_Parallel(reprFormat, &j, nt);
+
+  for (i = 0, j.rj_off[0] = 0; i < nt; i++)
+    j.rj_off[i + 1] = j.rj_off[i] + VEC_vused(j.rj_out[i]);
+  total = j.rj_off[nt];
+
+  if (cf->Pp_sink != NULL) {
+    /* Streaming: Pp_buf[0, Pp_used) first. To a seekable fd (not in append mode), at its offset with pwrite; else in order */
+    cf->Pp_used = cf->Pp_buf != NULL ? cf->Pp_used : 0;
+    cf->Pp_serr = cf->Pp_used ? cf->Pp_sink(cf->Pp_sinkarg, cf->Pp_buf, cf->Pp_used) : 0;
+    j.rj_base   = -1;
+#if !__WINDOWS__
+    if (cf->Pp_sink == VEC_reprSinkFd) {
+      j.rj_fd = (int)(intptr_t)cf->Pp_sinkarg;
+      if (!(fcntl(j.rj_fd, F_GETFL) & O_APPEND))
+	j.rj_base = lseek(j.rj_fd, 0, SEEK_CUR);
+    }
+#endif
+    if (!cf->Pp_serr && (j.rj_base >= 0)) {
+      j.rj_dst = NULL;
+      MvpgInclude_Parallel(reprPlace, &j, nt);
+      cf->Pp_serr = atomic_load(&j.rj_err);
+      if (!cf->Pp_serr && (lseek(j.rj_fd, j.rj_base + total, SEEK_SET) < 0))
+	cf->Pp_serr = -1;
+    }
+    for (i = 0; (i < nt) && !cf->Pp_serr && (j.rj_base < 0); i++) {
+      if (VEC_vused(j.rj_out[i]))
+	cf->Pp_serr = cf->Pp_sink(cf->Pp_sinkarg, j.rj_out[i], VEC_vused(j.rj_out[i]));
+    }
+    cf->Pp_used = cf->Pp_serr ? 0 : cf->Pp_used + total;
+  }
+  else if (cf->Pp_str != NULL) {
+    VEC_strReserve(cf->Pp_str, total);
+    dst = *cf->Pp_str + VEC_vused(*cf->Pp_str);
+    cf->Pp_used = total;
+  }
+  else if ((cf->Pp_size > cf->Pp_used) && (cf->Pp_size - cf->Pp_used > total + cf->Pp_overflw)) {
+    /* Every item fits (as the sequential repr checks it) */
+    dst = cf->Pp_buf + cf->Pp_used;
+    cf->Pp_used += total;
+  }
+
+  if (dst != NULL) {
+    j.rj_dst = dst;
+    MvpgInclude_Parallel(reprPlace, &j, nt);
+    dst[total] = '\0';
+    if (cf->Pp_str != NULL)
+      VEC_vusedSet(*cf->Pp_str, VEC_vused(*cf->Pp_str) + total);
+  }
+
+  for (i = 0; i < nt; i++)
+    VEC_destroy(j.rj_out[i]);
+  return (dst != NULL) || (cf->Pp_sink != NULL);
+}
+
+__NONNULL__ static void VEC_reprOut(const void *v, Pp_Setup *cf, reprSliceFn slice) {
+  /* Pp_overflw is set: in parallel, to a sink, to a VEC_str, or to Pp_buf */
+  if ((cf->Pp_threads > 1) && (VEC_vused(v) >= 2 * VEC_REPR_PARMIN) && VEC_reprParallel(v, cf, slice))
+    return;
+  if (cf->Pp_sink != NULL) {
+    VEC_reprStream(v, cf, slice);
+    return;
+  }
+  if (cf->Pp_str != NULL) {
+    VEC_reprAppend(v, cf, slice);
+    return;
   }
+  slice(v, VEC_vused(v), cf);
+}
+
+/* Longest integer item of the width W: digits + sign + len(", ") (hexadecimal, 0x prefixed, is no longer) */
+#define REPR_INTLEN(W) ((W) == L_8 ? 6 : (W) == L_16 ? 8 : (W) == L_32 ? 13 : 22)
+
+__NONNULL__ void VEC_TostrInt(void *v, Pp_Setup *cf) {
+  cf->Pp_overflw = REPR_INTLEN(cf->Pp_mask & WIDTH);
+  VEC_reprOut(v, cf, VEC_reprSlice(cf));
 }
 
 /*                    REPR (POSSIBLE REPRESENTATION OF VECTOR)
@@ -250,9 +635,9 @@ __NONNULL__ void VEC_TostrInt(void *v, Pp_Setup *cf) {
  * h2  - int32_t
  * h4  - int64_t
  * lz  - int128_t (unimplemented)
- * f   - float
- * e
- * g
+ * f   - float / double, fixed form ("0.0001")
+ * e   - float / double, exponent form ("1e-04")
+ * g   - float / double, "%g" form (each with the fewest digits that read back)
  * c   - unsigned char
  * hc  - signed char
  * s   - char array
@@ -281,13 +666,18 @@ __NONNULL__ void VEC_TostrInt(void *v, Pp_Setup *cf) {
  */
 
 __NONNULL__ __STATIC_FORCE_INLINE_F void VEC_TostrFlt(const void *v, Pp_Setup *cf) {
-  switch (cf->Pp_mask & WIDTH) {
-  case L_64:
-  case L_128:
-  default:
-    PASS;
-  }
-  VEC_assert(false, "Repr: TOSTRFLT: UINMPLEMENTED");
+  /* Shortest digits that read back (dtoa.h), in the "%g" form ('g'), exponent form ('e') or fixed form ('f') */
+  const bool dbl = cf->Pp_dtype == sizeof(double), f = cf->Pp_mask & FLT_F;
+
+  VEC_assert(dbl || (cf->Pp_dtype == sizeof(float)), "Repr: Type Mismatch");
+
+  /* Longest item with its separator */
+  if (dbl)
+    cf->Pp_overflw = 2 + (f ? MVPG_DTOA_FLEN : MVPG_DTOA_LEN);
+  else
+    cf->Pp_overflw = 2 + (f ? MVPG_FTOA_FLEN : MVPG_FTOA_LEN);
+  cf->Pp_mask |= FLT;
+  VEC_reprOut(v, cf, VEC_reprSlice(cf));
 }
 
 __NONNULL__ vsize_t VEC_Repr(void *v, Pp_Setup *setup) {
@@ -301,8 +691,9 @@ __NONNULL__ vsize_t VEC_Repr(void *v, Pp_Setup *setup) {
   {
     uint8_t mskc, error, *fmt, fc[16] = {0};
 
-    fmt = setup->Pp_fmt;
-    VEC_assert(EOFMT(c, *fmt++), "Repr: Empty Format is unsupported");
+    fmt  = setup->Pp_fmt;
+    mskc = EOFMT(c, *fmt++); /* Out of VEC_assert, which is compiled out with MVPG_NDEBUG or VEC_UNSAFE */
+    VEC_assert(mskc, "Repr: Empty Format is unsupported");
 
     for (fc[0] = c, mskc = 0; (mskc < 5) && EOFMT(c, fmt[mskc]); mskc++)
       fc[1u << mskc] = c; // starts at index 1
@@ -333,35 +724,39 @@ __NONNULL__ vsize_t VEC_Repr(void *v, Pp_Setup *setup) {
   LOCATION(Main);
 
   setup->Pp_dtype = VEC_vdtype(v);
-  setup->Pp_mask  = mask & WIDTH; /* Igore Type bits (Reused for other mask) */
+  setup->Pp_mask  = mask & (WIDTH | BASE); /* Igore Type bits (Reused for other mask) */
   switch ( mask & TYPE ) {
   case '0':
-    // int8_t
-    PASS;
   case '1':
-    setup->Pp_mask |= L_16;
   case '2':
-    setup->Pp_mask |= L_32;
   case '4':
-    setup->Pp_mask |= L_64;
+    /* h0, h1, h2, h4: int8_t, int16_t, int32_t, int64_t */
     if (!(mask & H_SPEC))
       JMP_(ERROR);
+    setup->Pp_mask = (setup->Pp_mask & ~WIDTH) | (((mask & TYPE) - '0') << 8);
     JMP_(INT);
   case 'p':
-    setup->Pp_mask |= PTR;
+    setup->Pp_mask = (setup->Pp_mask & ~WIDTH) | PTR | USIGNED | BASE | (sizeof(void *) << 7);
+    JMP_(INT);
+  case 'q':
+    setup->Pp_mask = (setup->Pp_mask & ~WIDTH) | L_64;
+    JMP_(INT);
   case 'u':
     setup->Pp_mask |= USIGNED;
-  case 'q':
-    setup->Pp_mask |= LLNG;
   case 'i':
   case 'd':
-    setup->Pp_mask |= WIDTH_(setup->Pp_mask & WIDTH);
+    setup->Pp_mask = (setup->Pp_mask & ~WIDTH) | WIDTH_((mask & WIDTH) >> 8);
     LOCATION(INT);
+    VEC_assert(setup->Pp_dtype == (((setup->Pp_mask & WIDTH) >> 7) | !(setup->Pp_mask & WIDTH)), "Repr: Type Mismatch");
     VEC_TostrInt(v, setup);
     break;
+  case 'f':
+    setup->Pp_mask |= FLT_F;
+    JMP_(FLT);
   case 'e':
+    setup->Pp_mask |= FLT_E;
   case 'g':
-  case 'f':
+    LOCATION(FLT);
     VEC_TostrFlt(v, setup);
     break;
   case 'c':
@@ -390,8 +785,61 @@ __NONNULL__ vsize_t VEC_Repr(void *v, Pp_Setup *setup) {
     setup->Pp_used = 0;
   }
 
-  setup->Pp_mask |= mask & TYPE; /* restore Type */
+  setup->Pp_mask = mask; /* restore the format mask (for Pp_skip) */
   return setup->Pp_used;
 }
 
+/*                    COMPILE-TIME FORMATS (VEC_ReprF)
+ *
+ * The mask VEC_Repr parses from the format, the longest item (Pp_overflw) and the slice formatter are constants of each
+ * entry point; only the item size is checked when run. Pp_mask is cleared after, so that a VEC_Repr with Pp_skip parses Pp_fmt.
+ */
+#define REPR_SLICEOF(S, I8, I16, I32, I64) ((S) == 1 ? I8 : (S) == 2 ? I16 : (S) == 4 ? I32 : I64)
+#define REPR_DECOF(S, U)						\
+  ((U) ? REPR_SLICEOF(S, reprSliceU8, reprSliceU16, reprSliceU32, reprSliceU64) \
+       : REPR_SLICEOF(S, reprSliceI8, reprSliceI16, reprSliceI32, reprSliceI64))
+
+#define REPR_FMT_INT(F, MASK, SLICE)					\
+  __NONNULL__ vsize_t VEC_reprF_##F(void *v, Pp_Setup *setup) {	\
+    VEC_assert(VEC_vdtype(v) == ((((MASK) & WIDTH) >> 7) | !((MASK) & WIDTH)), "Repr: Type Mismatch"); \
+    setup->Pp_dtype   = VEC_vdtype(v);					\
+    setup->Pp_mask    = MASK;						\
+    setup->Pp_overflw = REPR_INTLEN((MASK) & WIDTH);			\
+    VEC_reprOut(v, setup, SLICE);					\
+    setup->Pp_mask    = 0;						\
+    return setup->Pp_used;						\
+  }
+
+#define REPR_FMT_FLT(F, MASK, FLEN, DLEN, SLICE32, SLICE64)		\
+  __NONNULL__ vsize_t VEC_reprF_##F(void *v, Pp_Setup *setup) {	\
+    const bool dbl = VEC_vdtype(v) == sizeof(double);			\
+									\
+    VEC_assert(dbl || (VEC_vdtype(v) == sizeof(float)), "Repr: Type Mismatch"); \
+    setup->Pp_dtype   = VEC_vdtype(v);					\
+    setup->Pp_mask    = FLT | (MASK);					\
+    setup->Pp_overflw = 2 + (dbl ? (DLEN) : (FLEN));			\
+    VEC_reprOut(v, setup, dbl ? SLICE64 : SLICE32);			\
+    setup->Pp_mask    = 0;						\
+    return setup->Pp_used;						\
+  }
+
+REPR_FMT_INT(d,   sizeof(int) << 7,                  REPR_DECOF(sizeof(int), 0))
+REPR_FMT_INT(i,   sizeof(int) << 7,                  REPR_DECOF(sizeof(int), 0))
+REPR_FMT_INT(u,   sizeof(int) << 7 | USIGNED,        REPR_DECOF(sizeof(int), 1))
+REPR_FMT_INT(hd,  sizeof(short) << 7,                REPR_DECOF(sizeof(short), 0))
+REPR_FMT_INT(hu,  sizeof(short) << 7 | USIGNED,      REPR_DECOF(sizeof(short), 1))
+REPR_FMT_INT(lld, sizeof(long long) << 7,            REPR_DECOF(sizeof(long long), 0))
+REPR_FMT_INT(llu, sizeof(long long) << 7 | USIGNED,  REPR_DECOF(sizeof(long long), 1))
+REPR_FMT_INT(q,   L_64,                              reprSliceI64)
+REPR_FMT_INT(h0,  L_8,                               reprSliceI8)
+REPR_FMT_INT(h1,  L_16,                              reprSliceI16)
+REPR_FMT_INT(h2,  L_32,                              reprSliceI32)
+REPR_FMT_INT(h4,  L_64,                              reprSliceI64)
+REPR_FMT_INT(p,   sizeof(void *) << 7 | PTR | USIGNED | BASE,
+	     REPR_SLICEOF(sizeof(void *), reprSliceXU8, reprSliceXU16, reprSliceXU32, reprSliceXU64))
+
+REPR_FMT_FLT(g, 0,     MVPG_FTOA_LEN,  MVPG_DTOA_LEN,  reprSliceG32, reprSliceG64)
+REPR_FMT_FLT(e, FLT_E, MVPG_FTOA_LEN,  MVPG_DTOA_LEN,  reprSliceE32, reprSliceE64)
+REPR_FMT_FLT(f, FLT_F, MVPG_FTOA_FLEN, MVPG_DTOA_FLEN, reprSliceF32, reprSliceF64)
+
 #endif
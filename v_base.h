@@ -66,11 +66,57 @@ You should have received a copy of the GNU General Public License along with thi
 
 typedef unsigned long vsize_t;
 
+/* Header flags: the vector lives in a slot of a batch block (VEC_newBatch), which cannot be freed or reallocated alone */
+#define VEC_HDR_BATCH 0x02
+
+#ifndef VEC_COMPACT_HEADER
+typedef struct {
+  vsize_t  __cap; /* Capacity */
+  vsize_t  __used; /* Total of capacity used */
+  uint32_t __dtype; /* sizeof data Type */
+  uint8_t  __flags; /* Header flags (VEC_HDR_BATCH) */
+  uint8_t  __rsrv;
+  uint16_t __site; /* Creation site (VEC_PROFILE) */
+} VEC_metaData_;
+#else
+/* Compact Header Mode (VEC_COMPACT_HEADER)
+ * Vectors of capacity <= VEC_COMPACT_CAPMAX carry only the 8 bytes tag below. Larger vectors carry the
+ * full header, which ends with the same tag, so that the tag is always found just before the main block.
+ */
+#define VEC_COMPACT_CAPMAX UINT8_MAX
+#define VEC_HDR_FULL       0x01
+
+typedef struct {
+  uint8_t  __ccap; /* Capacity (compact only) */
+  uint8_t  __cused; /* Total of capacity used (compact only) */
+  uint8_t  __flags; /* Header flags (VEC_HDR_FULL, VEC_HDR_BATCH) */
+  uint8_t  __site; /* Creation site (VEC_PROFILE) */
+  uint32_t __dtype; /* sizeof data Type */
+} VEC_compactData_;
+
 typedef struct {
   vsize_t __cap; /* Capacity */
   vsize_t __used; /* Total of capacity used */
-  vsize_t __dtype; /* sizeof data Type */
+  VEC_compactData_ __tag;
 } VEC_metaData_;
+#endif
+
+/* Element kinds. The vector dtype is only an item size, so typed kernels (filter, scan, ...) are told the kind */
+typedef enum {
+  VEC_I8, VEC_U8, VEC_I16, VEC_U16, VEC_I32, VEC_U32, VEC_I64, VEC_U64, VEC_F32, VEC_F64
+} VEC_kind;
+
+#define VEC_kindSize(K)   ((K) >= VEC_F32 ? 4u << ((K) - VEC_F32) : 1u << ((K) >> 1))
+#define VEC_kindFloat(K)  ((K) >= VEC_F32)
+#define VEC_kindSigned(K) (VEC_kindFloat(K) || !((K) & 1))
+#define VEC_kindValid(K)  ((unsigned)(K) <= VEC_F64)
+
+/* Item of any kind (bounds, carries) */
+typedef union {
+  int64_t  i;
+  uint64_t u;
+  double   f;
+} VEC_scalar;
 
 /* V_BASE_C */
 typedef union {
@@ -84,11 +130,32 @@ typedef struct {
   int16_t fmt_Err;
 } fmt;
 
+/* Repr sink: take the n bytes at p; returns 0, or non-zero on failure (streaming then stops) */
+typedef int (*VEC_reprSink)(void *arg, const char *p, vsize_t n);
+
+/* Streaming chunk, when Pp_buf is NULL (on the stack) */
+#ifndef VEC_REPR_CHUNK
+    #define VEC_REPR_CHUNK (1u << 16)
+#endif
+/* Least items per thread of a parallel repr (Pp_threads) */
+#ifndef VEC_REPR_PARMIN
+    #define VEC_REPR_PARMIN (1u << 16)
+#endif
+
 typedef struct {
   char    *Pp_buf, *Pp_fmt;
+  char   **Pp_str; /* If not NULL, output is appended to this VEC_str (v_str.h), grown as needed; Pp_buf and Pp_size are then set by VEC_Repr */
+  VEC_reprSink Pp_sink; /* If not NULL, output (numeric formats) is streamed: formatted in Pp_buf (Pp_size bytes, or VEC_REPR_CHUNK bytes if Pp_buf is NULL),
+			   passed to Pp_sink(Pp_sinkarg, ...) whenever the next item may not fit; Pp_used is then the count of bytes passed */
+  void    *Pp_sinkarg;
+  int      Pp_serr;  /* Streaming: the failed sink result (0: none) */
   vsize_t  Pp_size, Pp_used;
   uint16_t Pp_mask, Pp_dtype;
-  uint8_t  Pp_skip, Pp_overflw;
+  uint16_t Pp_overflw;
+  uint8_t  Pp_skip;
+  uint8_t  Pp_threads; /* Up to Pp_threads threads (MVPG_MAXTHREADS at most) format the numeric items, VEC_REPR_PARMIN at least each;
+			  the output is the sequential one. To a VEC_reprSinkFd sink, chunks are written with pwrite at their offsets */
+  uint8_t  Pp_cont;  /* Internal: the output continues a former one (a separator precedes the first item) */
 } Pp_Setup;
 
 void   reprfloat   (bits_t bits);
@@ -98,8 +165,50 @@ DBLT__ exp___      (const DBLT__ x);
 DBLT__ exp__       (const DBLT__ x);
 vsize_t VEC_Repr(void *v, Pp_Setup *setup);
 
+/* Compile-time formats: VEC_ReprF(V, SETUP, F) is VEC_Repr(V, SETUP) with the format F written as a token (h4 for "h4"), to the
+ * same targets and with the same output; Pp_fmt and Pp_skip are not read. F names its formatter, so nothing is parsed or
+ * dispatched when run; V must be a typed vector (VEC_type(T)), whose item size is checked against F when compiled.
+ * An unknown format (VEC_reprSizes_F undeclared), or one of another item size (negative array size), does not compile.
+ * VEC_REPR_FORMATS lists them with the item sizes they take (bit N: N bytes). From C++, see VEC_REPR_FMT (v_base.hpp).
+ */
+#define VEC_REPR_FORMATS(X)						\
+  X(d,   1u << sizeof(int))						\
+  X(i,   1u << sizeof(int))						\
+  X(u,   1u << sizeof(int))						\
+  X(hd,  1u << sizeof(short))						\
+  X(hu,  1u << sizeof(short))						\
+  X(lld, 1u << sizeof(long long))					\
+  X(llu, 1u << sizeof(long long))					\
+  X(q,   1u << 8)							\
+  X(h0,  1u << 1)							\
+  X(h1,  1u << 2)							\
+  X(h2,  1u << 4)							\
+  X(h4,  1u << 8)							\
+  X(p,   1u << sizeof(void *))						\
+  X(g,   (1u << sizeof(float)) | (1u << sizeof(double)))		\
+  X(e,   (1u << sizeof(float)) | (1u << sizeof(double)))		\
+  X(f,   (1u << sizeof(float)) | (1u << sizeof(double)))
+
+#define VEC_REPR_DECLF(F, SIZES)					\
+  enum { VEC_reprSizes_##F = SIZES };					\
+  vsize_t VEC_reprF_##F(void *v, Pp_Setup *setup);
+VEC_REPR_FORMATS(VEC_REPR_DECLF)
+#undef VEC_REPR_DECLF
+
+#define VEC_ReprF(V, SETUP, F)						\
+  ((void)sizeof(char[((VEC_reprSizes_##F >> sizeof *(V)) & 1) ? 1 : -1]), VEC_reprF_##F((V), (SETUP)))
+
+/* Sinks: to the file descriptor (void *)(intptr_t)FD, with write (resuming partial writes); to the FILE * stream */
+#if !__WINDOWS__
+int     VEC_reprSinkFd   (void *fd, const char *p, vsize_t n);
+#endif
+int     VEC_reprSinkFile (void *f, const char *p, vsize_t n);
+
 /* Metadata size */
 static const uint16_t VEC_metadtsz       = sizeof(VEC_metaData_);
+#ifdef VEC_COMPACT_HEADER
+static const uint16_t VEC_cmetadtsz      = sizeof(VEC_compactData_);
+#endif
 static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
  /* Access: (sizeof(N) >> 2) */
 
@@ -117,6 +226,14 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
 #endif
 #define VEC_NsizeOverflow(N) !(N & VEC_sizeOverflwLim)
 
+/* Shrink-to-fit hysteresis: skip unless at least cap/VEC_SHRINK_MIN items are released, and keep used/VEC_SHRINK_SLACK items of headroom */
+#ifndef VEC_SHRINK_MIN
+    #define VEC_SHRINK_MIN   4
+#endif
+#ifndef VEC_SHRINK_SLACK
+    #define VEC_SHRINK_SLACK 8
+#endif
+
 /* Types Cvt */
 #define VEC_type(T) T*
 
@@ -132,9 +249,25 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
   ( (void *)(uintptr_t)(V) )
 
 /* Header Op */
+#ifndef VEC_COMPACT_HEADER
 #define VEC_peekblkst(V)			\
   ( VEC_metaDataType(V) - 1 )
 
+#define VEC_mv2MainBlk(V)			\
+  (						\
+   (V) = VEC_voidptr( VEC_metaDataType(V) + 1 )	\
+    )
+#else
+#define VEC_peektag(V)				\
+  ( (VEC_compactData_ *)(void *)(V) - 1 )
+
+#define VEC_iscompact(V)			\
+  !( VEC_peektag(V)->__flags & VEC_HDR_FULL )
+
+#define VEC_peekblkst(V)						\
+  ( (VEC_metaData_ *)(void *)((char *)(V) - (VEC_iscompact(V) ? VEC_cmetadtsz : VEC_metadtsz)) )
+#endif
+
 #define VEC_fromMetaDataGet(V)			\
   ( VEC_peekblkst(V)[0] )
 
@@ -143,15 +276,11 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
    (V) = VEC_voidptr( VEC_peekblkst(V) )	\
     )
 
-#define VEC_mv2MainBlk(V)			\
-  (						\
-   (V) = VEC_voidptr( VEC_metaDataType(V) + 1 )	\
-    )
-
 /* Header contents Op */
 #define VEC_base(V)				\
   ( &(V) )
 
+#ifndef VEC_COMPACT_HEADER
 #define VEC_vsize(V)				\
   VEC_fromMetaDataGet(V).__cap
 
@@ -161,6 +290,53 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
 #define VEC_vdtype(V)				\
   VEC_fromMetaDataGet(V).__dtype
 
+#define VEC_vflags(V)				\
+  VEC_fromMetaDataGet(V).__flags
+
+#define VEC_vsite(V)				\
+  VEC_fromMetaDataGet(V).__site
+
+#define VEC_vsizeSet(V, N)			\
+  ( VEC_vsize(V) = (N) )
+
+#define VEC_vusedSet(V, N)			\
+  ( VEC_vused(V) = (N) )
+
+#define VEC_vusedPostIncr(V)			\
+  ( VEC_vused(V)++ )
+
+#define VEC_vusedPreDecr(V)			\
+  ( --VEC_vused(V) )
+#else
+/* VEC_vsize and VEC_vused are not lvalues in compact mode; update through the Set/Incr/Decr ops below */
+#define VEC_vsize(V)							\
+  ( VEC_iscompact(V) ? (vsize_t)VEC_peektag(V)->__ccap : VEC_fromMetaDataGet(V).__cap )
+
+#define VEC_vused(V)							\
+  ( VEC_iscompact(V) ? (vsize_t)VEC_peektag(V)->__cused : VEC_fromMetaDataGet(V).__used )
+
+#define VEC_vdtype(V)				\
+  VEC_peektag(V)->__dtype
+
+#define VEC_vflags(V)				\
+  VEC_peektag(V)->__flags
+
+#define VEC_vsite(V)				\
+  VEC_peektag(V)->__site
+
+#define VEC_vsizeSet(V, N)						\
+  ( VEC_iscompact(V) ? (vsize_t)(VEC_peektag(V)->__ccap = (N)) : (VEC_fromMetaDataGet(V).__cap = (N)) )
+
+#define VEC_vusedSet(V, N)						\
+  ( VEC_iscompact(V) ? (vsize_t)(VEC_peektag(V)->__cused = (N)) : (VEC_fromMetaDataGet(V).__used = (N)) )
+
+#define VEC_vusedPostIncr(V)						\
+  ( VEC_iscompact(V) ? (vsize_t)VEC_peektag(V)->__cused++ : VEC_fromMetaDataGet(V).__used++ )
+
+#define VEC_vusedPreDecr(V)						\
+  ( VEC_iscompact(V) ? (vsize_t)--VEC_peektag(V)->__cused : --VEC_fromMetaDataGet(V).__used )
+#endif
+
 /* Read Only */
 #define VEC_size(V)\
   (VEC_vsize(V) | 0)
@@ -177,12 +353,33 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
 #define VEC_isfilled(V)\
   (VEC_used(V) == VEC_size(V))
 
+/* Growth Profiler (VEC_PROFILE)
+ * Vectors are tagged with the site (__FILE__, __LINE__) of their VEC_new; resizes, bytes copied by growth and the used items
+ * seen on resize (with the items requested), realloc / shrink and destroy are counted by site, and reported by VEC_profileReport (v_profile.h), and at exit.
+ * Sites beyond the capacity of the header tag (65535, or 255 with VEC_COMPACT_HEADER) are counted as site 0, with the
+ * vectors created by VEC_INTERNAL_create directly. Without VEC_PROFILE, the hooks below expand to nothing.
+ */
+#ifdef VEC_PROFILE
+void *VEC_INTERNAL_profileNew  (void *v, const char *file, unsigned int line);
+void  VEC_INTERNAL_profileGrow (const void *v, vsize_t used, vsize_t size, bool moved);
+void  VEC_INTERNAL_profileUsed (const void *v, vsize_t used);
+void  VEC_INTERNAL_profileFree (const void *v);
+
+    #define VEC_PROFILE_NEW(V)     VEC_INTERNAL_profileNew(V, __FILE__, __LINE__)
+    #define VEC_PROFILE_USED(V, N) VEC_INTERNAL_profileUsed(V, N)
+    #define VEC_PROFILE_FREE(V)    VEC_INTERNAL_profileFree(V)
+#else
+    #define VEC_PROFILE_NEW(V)     (V)
+    #define VEC_PROFILE_USED(V, N) PASS
+    #define VEC_PROFILE_FREE(V)    PASS
+#endif
+
 /* Vector Init */
 #define VEC_new(SZ, T, ...)						\
-  VEC_INTERNAL_create(SZ, MvpgMacro_Select(sizeof(T), 0, T))
+  VEC_PROFILE_NEW(VEC_INTERNAL_create(SZ, MvpgMacro_Select(sizeof(T), 0, T)))
 
 #define VEC_newFrmSize(SZ, SZOF)\
-  VEC_INTERNAL_create(SZ, MvpgMacro_Select(SZOF, 0, SZOF))
+  VEC_PROFILE_NEW(VEC_INTERNAL_create(SZ, MvpgMacro_Select(SZOF, 0, SZOF)))
 
 
 /* Vector Op */
@@ -204,17 +401,17 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
 
 #define VEC_push(V, N)							\
   (									\
-   VEC_assert((V != NULL) && (VEC_vdtype(V) == sizeof(N))),		\
+   MvpgMacro_Ignore(VEC_assert((V != NULL) && (VEC_vdtype(V) == sizeof(N)))), \
 									\
-   ( (VEC_vsize(V) < 1) || (VEC_vsize(V) == VEC_vused(V)) ) && VEC_INTERNAL_resize(V, 1), \
+   MvpgMacro_Ignore(( (VEC_vsize(V) < 1) || (VEC_vsize(V) == VEC_vused(V)) ) && ((V) = VEC_INTERNAL_resize(V, 1))), \
 									\
-   ((V)[VEC_vused(V)++] = (N))						\
+   ((V)[VEC_vusedPostIncr(V)] = (N))					\
   )
 
 #define VEC_popni(V, ...)				\
   (\
    VEC_assert((V) != NULL && VEC_vused(V) > 0),	\
-   (V)[--VEC_vused((V))]		  \
+   (V)[VEC_vusedPreDecr(V)]		  \
   )
 
 #define VEC_popi(V, I, ...)						\
@@ -244,7 +441,7 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
     if (Vv != NULL && F != NULL) {				\
       VEC_assert(VEC_vdtype(Vv) == sizeof(T));			\
 								\
-      for (VEC_type(T) Last = Vv + VEC_vused(Vv) - 1; Vv != Last; Vv++)	\
+      for (VEC_type(T) Last = Vv + VEC_vused(Vv); Vv != Last; Vv++)	\
 	F(*Vv MvpgMacro_Vaopt(,__VA_ARGS__));			\
     }								\
   } while (0)
@@ -252,21 +449,37 @@ static const vsize_t  VEC_sizeOverflwLim = ULONG_MAX & ~LONG_MAX;
 #define VEC_slice(V, S, E)			\
    VEC_INTERNAL_slice(&V, S, E)
 
+/* Shrink V to capacity N, or shrink-to-fit if N is not given (see VEC_INTERNAL_shrink) */
 #define VEC_shrink(V, ...)\
   MvpgMacro_Ignore(							\
-		   (V != NULL) && VEC_INTERNAL_shrink(&V, MvpgMacro_Select((__VA_ARGS__), VEC_vused(V), __VA_ARGS__)) \								)
+		   (V != NULL) && ((V) = VEC_INTERNAL_shrink(V, MvpgMacro_Select((__VA_ARGS__, false), (0, true), __VA_ARGS__))) \
+									)
 
 #define VEC_del(V, I)				\
        VEC_INTERNAL_del(&V, I, I < 0)
 
 #define VEC_clear(V)\
-  ( VEC_vused(V) = 0)
+  VEC_vusedSet(V, 0)
 
 #define VEC_sort(V)				\
   PASS
 
+#define VEC_isbatch(V)				\
+  ( VEC_vflags(V) & VEC_HDR_BATCH )
+
+/* A vector still in its batch slot is only dropped: the slot is freed with its batch (VEC_batchDestroy) */
 #define VEC_destroy(V)							\
-     MvpgMacro_Ignore(V != NULL ? mvpgDealloc(VEC_mv2blkst(V)), (V = NULL) : PASS)
+     MvpgMacro_Ignore(V != NULL ? VEC_PROFILE_FREE(V), (VEC_isbatch(V) ? PASS : mvpgDealloc(VEC_mv2blkst(V))), (void)(V = NULL) : PASS)
+
+/* COUNT vectors of capacity CAP of type T, carved from one block: OUT[0..COUNT) receive the vectors, the block is returned.
+ * Each slot (header and items) starts on a MVPG_ALLOC_MEMALIGN boundary. A vector that outgrows its slot moves to its own
+ * block, as on any resize; the slot is left unused. VEC_batchDestroy(B, OUT, COUNT) frees the moved vectors of OUT and the block.
+ */
+#define VEC_newBatch(COUNT, CAP, T, OUT)		\
+  VEC_INTERNAL_batch(COUNT, CAP, sizeof(T), (void **)(OUT))
+
+#define VEC_batchDestroy(B, OUT, COUNT)					\
+  MvpgMacro_Ignore(B != NULL ? VEC_INTERNAL_batchFree(B, (void **)(OUT), COUNT), (void)(B = NULL) : PASS)
 
 
 /*************************************************************
@@ -283,49 +496,177 @@ __STATIC_FORCE_INLINE_F __NONNULL__ vsize_t VEC_cvtindex(const void *v, vsize_t
        return i;
      }
 
-__STATIC_FORCE_INLINE_F __WARN_UNUSED__ void *VEC_INTERNAL_create(const vsize_t size, const vsize_t dtype) {
-  void *v;
+__STATIC_FORCE_INLINE_F vsize_t VEC_INTERNAL_hdrsize(const vsize_t size) {
+  /* Size of the header preceding the main block of a vector of capacity size */
+
+#ifdef VEC_COMPACT_HEADER
+  if (size <= VEC_COMPACT_CAPMAX)
+    return VEC_cmetadtsz;
+#else
+  MvpgMacro_Ignore(size);
+#endif
+  return VEC_metadtsz;
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void *VEC_INTERNAL_init(void *v, const vsize_t size, const vsize_t dtype) {
+  /* Setup the (zeroed) header of main block v, allocated with VEC_INTERNAL_hdrsize(size) bytes before it */
 
-  VEC_assert ( dtype );
-  v = mvpgAlloc(__bsafeUnsignedMulAddl(dtype, size, VEC_metadtsz), VEC_metadtsz);
-  VEC_vsize(v)  = size;
+  VEC_assert ( dtype && (dtype <= UINT32_MAX) );
+#ifdef VEC_COMPACT_HEADER
+  if (size > VEC_COMPACT_CAPMAX)
+    VEC_peektag(v)->__flags = VEC_HDR_FULL;
+#endif
+  VEC_vsizeSet(v, size);
   VEC_vdtype(v) = dtype;
 
   return v;
 }
 
-__STATIC_FORCE_INLINE_F void *VEC_INTERNAL_resize(void *v, const vsize_t size) {
-  PASS;
+__STATIC_FORCE_INLINE_F __WARN_UNUSED__ void *VEC_INTERNAL_create(const vsize_t size, const vsize_t dtype) {
+  const vsize_t hdr = VEC_INTERNAL_hdrsize(size);
+
+  return VEC_INTERNAL_init(mvpgAlloc(__bsafeUnsignedMulAddl(dtype, size, hdr), hdr), size, dtype);
 }
 
-__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_append(void *va, void *vb) {
-  PASS;
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_batch(const vsize_t n, const vsize_t size, const vsize_t dtype, void **out) {
+  /* Carve n vectors of capacity size from one block; returns the block */
+  const vsize_t hdr = VEC_INTERNAL_hdrsize(size);
+  const vsize_t slot = NXTMUL(__bsafeUnsignedMulAddl(dtype, size, hdr), MVPG_ALLOC_MEMALIGN);
+  char *blk;
+  vsize_t i;
+
+  VEC_assert( n );
+  blk = (char *)mvpgAlloc(__bsafeUnsignedMull(slot, n), 0);
+
+  for (i = 0; i < n; i++) {
+    out[i] = VEC_INTERNAL_init(blk + i * slot + hdr, size, dtype);
+    VEC_vflags(out[i]) |= VEC_HDR_BATCH;
+  }
+  return blk;
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void VEC_INTERNAL_batchFree(void *blk, void **out, const vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i < n; i++)
+    VEC_destroy(out[i]);
+  mvpgDealloc(blk);
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_reallocTyped(void *v, const vsize_t size, const vsize_t dtype) {
+  /* Resize v to capacity size in place (the block is reallocated, the header is kept); returns the (possibly moved) vector.
+   * A vector in a batch slot keeps its slot when shrunk, and moves to its own block when grown.
+   * dtype is the item size of v: VEC_vdtype(v), or a constant in a VEC_DEFINE vector (v_define.h).
+   */
+  char *blk;
+  vsize_t hdr;
+
+  /* The items a shrink drops count toward the peak */
+  VEC_PROFILE_USED(v, VEC_vused(v));
+  if (VEC_isbatch(v)) {
+    if (size <= VEC_vsize(v)) {
+      if (VEC_vused(v) > size)
+        VEC_vusedSet(v, size);
+      return v;
+    }
+    blk = (char *)VEC_INTERNAL_create(size, dtype);
+    mvpgMemcpy(blk, v, __bsafeUnsignedMull(VEC_vused(v), dtype));
+    VEC_vusedSet(blk, VEC_vused(v));
+    return blk;
+  }
+
+  blk = (char *)VEC_peekblkst(v);
+  hdr = (char *)v - blk;
+  blk = (char *)mvpgRealloc(blk, __bsafeUnsignedMulAddl(dtype, size, hdr));
+  v = blk + hdr;
+
+  VEC_vsizeSet(v, size);
+  if (VEC_vused(v) > size)
+    VEC_vusedSet(v, size);
+
+  return v;
 }
-__STATIC_FORCE_INLINE_F __NONNULL__ void *VEC_INTERNAL_shrink(void *v, vsize_t shrinkSize) {
+
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_realloc(void *v, const vsize_t size) {
+  return VEC_INTERNAL_reallocTyped(v, size, VEC_vdtype(v));
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_resizeTyped(void *v, const vsize_t size, const vsize_t dtype) {
+  /* Grow v to accomodate at least size more items. Capacity is doubled until it fits.
+   * The block is reallocated, except for a compact header which is promoted (moved) to a full header once the new capacity exceeds VEC_COMPACT_CAPMAX.
+   * dtype is the item size of v, as for VEC_INTERNAL_reallocTyped.
+   */
   void *p;
+  vsize_t cap;
+#ifdef VEC_PROFILE
+  const vsize_t site = VEC_vsite(v), used = VEC_vused(v);
+  const void *old = v;
+#endif
 
-  p = VEC_INTERNAL_create(shrinkSize, VEC_vdtype(v)); /* Create a new vector with shrinkSize (Realloc) */
-  memcpy(p, v, __bsafeUnsignedMull(shrinkSize, VEC_vdtype(v)));  /* Copy old to new */
-  VEC_vused(p) = shrinkSize < VEC_vused(v) ? shrinkSize : VEC_vused(v);
-  VEC_destroy(v); /* Remove old object */
+  cap = VEC_vsize(v) | !VEC_vsize(v);
+  while ((cap - VEC_vused(v)) < size)
+    cap = __bsafeUnsignedMull(cap, 2);
+
+#ifdef VEC_COMPACT_HEADER
+  if (VEC_iscompact(v) && (cap > VEC_COMPACT_CAPMAX)) {
+    p = VEC_INTERNAL_create(cap, dtype);
+    mvpgMemcpy(p, v, __bsafeUnsignedMull(VEC_vused(v), dtype));
+    VEC_vusedSet(p, VEC_vused(v));
+    if (! VEC_isbatch(v))
+      mvpgDealloc(VEC_peekblkst(v));
+  }
+  else
+#endif
+  p = VEC_INTERNAL_reallocTyped(v, cap, dtype);
 
+#ifdef VEC_PROFILE
+  VEC_vsite(p) = site;
+  VEC_INTERNAL_profileGrow(p, used, size, p != old);
+#endif
   return p;
 }
 
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_resize(void *v, const vsize_t size) {
+  return VEC_INTERNAL_resizeTyped(v, size, VEC_vdtype(v));
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_append(void *va, void *vb) {
+  PASS;
+}
+__STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_shrink(void *v, vsize_t shrinkSize, bool fit) {
+  /* Release the tail of v in place (no copy of the contents). Items beyond shrinkSize are dropped.
+   * On shrink-to-fit (fit), shrinkSize is computed from the used items with hysteresis (VEC_SHRINK_MIN, VEC_SHRINK_SLACK), so that alternating push and shrink do not thrash.
+   */
+  const vsize_t cap = VEC_vsize(v);
+
+  if (fit) {
+    shrinkSize = VEC_vused(v) + VEC_vused(v) / VEC_SHRINK_SLACK;
+
+    if ((shrinkSize >= cap) || ((cap - shrinkSize) < cap / VEC_SHRINK_MIN))
+      return v;
+  }
+  if (shrinkSize >= cap)
+    return v;
+
+  return VEC_INTERNAL_realloc(v, shrinkSize);
+}
+
 __STATIC_FORCE_INLINE_F __NONNULL__ __WARN_UNUSED__ void *VEC_INTERNAL_slice(void **v, vsize_t b, vsize_t e) {
   /* Slice items from index b to e, returning a new vector of sliced items */
 
-  void *new __MB_UNUSED__;
+  void *p;
+  const vsize_t dtype = VEC_vdtype(*v);
 
-  if (! ((b < VEC_vused(*v)) && (e < VEC_vused(*v)) && (e > b)) )
+  if (! ((b < VEC_vused(*v)) && (e <= VEC_vused(*v)) && (e > b)) )
     return NULL;
 
-  // new = VEC_newFrmSize((e - b), VEC_vdtype(*v));
+  p = VEC_newFrmSize((e - b), dtype);
 
-  memcpy(new, (*v + b), e);
-  memmove(*v + b, *v + e, __bsafeUnsignedMull(VEC_vdtype(*v), (e - b)));
-  VEC_vused(v) -= e - b;
-  return new;
+  mvpgMemcpy(p, (char *)*v + b * dtype, __bsafeUnsignedMull(dtype, (e - b)));
+  mvpgMemmove((char *)*v + b * dtype, (char *)*v + e * dtype, __bsafeUnsignedMull(dtype, (VEC_vused(*v) - e)));
+  VEC_vusedSet(p, e - b);
+  VEC_vusedSet(*v, VEC_vused(*v) - (e - b));
+  return p;
 }
 
 __NONNULL__ __STATIC_FORCE_INLINE_F void VEC_INTERNAL_del(void *v, vsize_t i) {
@@ -333,7 +674,7 @@ __NONNULL__ __STATIC_FORCE_INLINE_F void VEC_INTERNAL_del(void *v, vsize_t i) {
   /* vsize_t mvby = (VEC_vsize(v) - i - 1) * VEC_vdtype(v); */
   /* mvby ? memmove(v + i, (v + i) + 1, mvby) /\* Shift memory to left *\/ */
   /*   : ((v)[i] = (void *)MEMCHAR); /\* Last index: reusable *\/ */
-  VEC_vused(v)--;
+  VEC_vusedPreDecr(v);
 }
 
 #endif /* V_BASE_H */
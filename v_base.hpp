@@ -0,0 +1,384 @@
+/* MVPG API Vector Type: C++ Interface
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_BASE_HPP
+#define V_BASE_HPP
+
+extern "C" {
+#include "v_base.h"
+}
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#if __cplusplus >= 202002L && __has_include(<span>)
+    #include <span>
+    #define MVPG_HAS_SPAN 1
+#endif
+
+namespace mvpg {
+
+/*
+ * Allocator
+ *
+ * An allocator provides allocate(size), returning a block aligned to MVPG_ALLOC_MEMALIGN, and deallocate(block).
+ * The vector header is carved from the start of the block, exactly as VEC_INTERNAL_create lays it out.
+ * Arena or pool allocators plug in by providing the same two members.
+ * Only buffers of the default allocator may be handed to (and destroyed by) C code, since VEC_destroy calls mvpgDealloc.
+ */
+struct allocator {
+  void *allocate(std::size_t size) { return mvpgAlloc(size, 0); }
+  void deallocate(void *blk) noexcept { mvpgDealloc(blk); }
+};
+
+template <class T, class Alloc = allocator>
+class vec : private Alloc {
+  static_assert(alignof(T) <= alignof(VEC_metaData_), "mvpg::vec: over-aligned types are unsupported by the VEC layout");
+
+  VEC_type(T) v_;
+
+  Alloc &alloc() noexcept { return *this; }
+
+  VEC_type(T) create(vsize_t cap) {
+    const vsize_t hdr = VEC_INTERNAL_hdrsize(cap);
+    char *blk;
+
+    blk = static_cast<char *>(alloc().allocate(__bsafeUnsignedMulAddl(sizeof(T), cap, hdr)));
+    if (blk == nullptr)
+      throw std::bad_alloc();
+
+    std::memset(blk, 0, hdr);
+    return static_cast<VEC_type(T)>(VEC_INTERNAL_init(blk + hdr, cap, sizeof(T)));
+  }
+
+  void destroy() noexcept {
+    if (v_ == nullptr)
+      return;
+
+    if constexpr (!std::is_trivially_destructible_v<T>)
+      for (T *p = begin(); p != end(); p++)
+	p->~T();
+    /* A vector in a batch slot (VEC_newBatch) is only dropped, as VEC_destroy does: the slot is freed with its batch */
+    if (!VEC_isbatch(v_))
+      alloc().deallocate(VEC_peekblkst(v_));
+    v_ = nullptr;
+  }
+
+  void regrow(vsize_t cap) {
+    VEC_type(T) p = create(cap);
+    const vsize_t n = size();
+
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      if (n)
+	std::memcpy(p, v_, n * sizeof(T));
+    }
+    else {
+      vsize_t i = 0;
+
+      /* Every item is built in p before any of v_ is destroyed: if a copy throws, p is rolled back and v_ is left whole */
+      try {
+	for ( ; i < n; i++)
+	  ::new (static_cast<void *>(p + i)) T(std::move_if_noexcept(v_[i]));
+      }
+      catch (...) {
+	while (i > 0)
+	  p[--i].~T();
+	alloc().deallocate(VEC_peekblkst(p));
+	throw;
+      }
+      for (i = 0; i < n; i++)
+	v_[i].~T();
+    }
+    if (v_ != nullptr) {
+      VEC_vusedSet(v_, 0);
+      destroy();
+    }
+    VEC_vusedSet(p, n);
+    v_ = p;
+  }
+
+  void grow(vsize_t n) {
+    /* Same policy as VEC_INTERNAL_resize: double capacity until n more items fit */
+    vsize_t cap = capacity() | !capacity();
+
+    while ((cap - size()) < n)
+      cap = __bsafeUnsignedMull(cap, 2);
+    regrow(cap);
+  }
+
+public:
+  typedef T value_type;
+  typedef vsize_t size_type;
+  typedef std::ptrdiff_t difference_type;
+  typedef T &reference;
+  typedef const T &const_reference;
+  typedef T *pointer;
+  typedef const T *const_pointer;
+  typedef T *iterator; /* contiguous */
+  typedef const T *const_iterator;
+  typedef Alloc allocator_type;
+
+  vec() noexcept(std::is_nothrow_default_constructible_v<Alloc>) : Alloc(), v_(nullptr) {}
+  explicit vec(const Alloc &a) noexcept : Alloc(a), v_(nullptr) {}
+
+  /* n items, value-initialized or copies of x, as std::vector (reserve sets the capacity alone) */
+  explicit vec(size_type n, const Alloc &a = Alloc()) : Alloc(a), v_(nullptr) {
+    v_ = create(n);
+    try {
+      while (size() < n)
+	emplace_back();
+    }
+    catch (...) {
+      destroy();
+      throw;
+    }
+  }
+
+  vec(size_type n, const T &x, const Alloc &a = Alloc()) : Alloc(a), v_(nullptr) {
+    v_ = create(n);
+    try {
+      while (size() < n)
+	emplace_back(x);
+    }
+    catch (...) {
+      destroy();
+      throw;
+    }
+  }
+
+  vec(std::initializer_list<T> il, const Alloc &a = Alloc()) : Alloc(a), v_(nullptr) {
+    v_ = create(il.size());
+    for (const T &x : il)
+      push_back(x);
+  }
+
+  vec(const vec &o) : Alloc(o), v_(nullptr) {
+    if (o.v_ == nullptr)
+      return;
+    v_ = create(o.size());
+    for (const T &x : o)
+      push_back(x);
+  }
+
+  /* Move: steal the pointer, never copy */
+  vec(vec &&o) noexcept : Alloc(std::move(static_cast<Alloc &>(o))), v_(o.v_) {
+    o.v_ = nullptr;
+  }
+
+  vec &operator=(const vec &o) {
+    if (this != &o) {
+      vec t(o);
+      swap(t);
+    }
+    return *this;
+  }
+
+  vec &operator=(vec &&o) noexcept {
+    if (this != &o) {
+      destroy();
+      static_cast<Alloc &>(*this) = std::move(static_cast<Alloc &>(o));
+      v_ = o.v_;
+      o.v_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~vec() { destroy(); }
+
+  void swap(vec &o) noexcept {
+    std::swap(static_cast<Alloc &>(*this), static_cast<Alloc &>(o));
+    std::swap(v_, o.v_);
+  }
+
+  /* Raw VEC interop: adopt takes ownership of a VEC_type(T) created by the same allocator (VEC_new for the default one),
+   * release gives up ownership, returning the raw vector (NULL if empty) to be destroyed by its new owner.
+   * A vector of a batch (VEC_newBatch) may be adopted: it is dropped, not freed, while in its slot, so the vec must be
+   * destroyed or released before VEC_batchDestroy (its OUT entry set to NULL, or to the released vector).
+   */
+  static vec adopt(VEC_type(T) raw, const Alloc &a = Alloc()) noexcept {
+    vec r(a);
+
+    VEC_assert(raw == nullptr || VEC_vdtype(raw) == sizeof(T), "mvpg::vec: adopt: type size mismatch");
+    r.v_ = raw;
+    return r;
+  }
+
+  [[nodiscard]] VEC_type(T) release() noexcept {
+    VEC_type(T) raw = v_;
+
+    v_ = nullptr;
+    return raw;
+  }
+
+  VEC_type(T) raw() const noexcept { return v_; }
+
+  allocator_type get_allocator() const { return *this; }
+
+  /* Capacity */
+  size_type size() const noexcept { return v_ ? VEC_vused(v_) : 0; }
+  size_type capacity() const noexcept { return v_ ? VEC_vsize(v_) : 0; }
+  bool empty() const noexcept { return size() == 0; }
+
+  void reserve(size_type cap) {
+    if (cap > capacity())
+      regrow(cap);
+  }
+
+  void shrink_to_fit() {
+    if (v_ != nullptr && size() < capacity())
+      regrow(size());
+  }
+
+  /* Access */
+  T *data() noexcept { return v_; }
+  const T *data() const noexcept { return v_; }
+
+  T &operator[](size_type i) noexcept { return v_[i]; }
+  const T &operator[](size_type i) const noexcept { return v_[i]; }
+
+  T &at(size_type i) {
+    if (i >= size())
+      throw std::out_of_range("mvpg::vec::at");
+    return v_[i];
+  }
+  const T &at(size_type i) const {
+    if (i >= size())
+      throw std::out_of_range("mvpg::vec::at");
+    return v_[i];
+  }
+
+  T &front() noexcept { return v_[0]; }
+  T &back() noexcept { return v_[size() - 1]; }
+  const T &front() const noexcept { return v_[0]; }
+  const T &back() const noexcept { return v_[size() - 1]; }
+
+  iterator begin() noexcept { return v_; }
+  iterator end() noexcept { return v_ + size(); }
+  const_iterator begin() const noexcept { return v_; }
+  const_iterator end() const noexcept { return v_ + size(); }
+  const_iterator cbegin() const noexcept { return begin(); }
+  const_iterator cend() const noexcept { return end(); }
+
+#ifdef MVPG_HAS_SPAN
+  operator std::span<T>() noexcept { return std::span<T>(v_, size()); }
+  operator std::span<const T>() const noexcept { return std::span<const T>(v_, size()); }
+  std::span<T> span() noexcept { return *this; }
+  std::span<const T> span() const noexcept { return *this; }
+#endif
+
+  /* Modifiers */
+  template <class... Args>
+  T &emplace_back(Args &&...args) {
+    if (size() == capacity())
+      grow(1);
+
+    T *p = ::new (static_cast<void *>(v_ + size())) T(std::forward<Args>(args)...);
+    VEC_vusedPostIncr(v_);
+    return *p;
+  }
+
+  void push_back(const T &x) { emplace_back(x); }
+  void push_back(T &&x) { emplace_back(std::move(x)); }
+
+  void pop_back() noexcept {
+    VEC_assert(size() > 0, "mvpg::vec: pop_back on empty vector");
+    v_[VEC_vusedPreDecr(v_)].~T();
+  }
+
+  void resize(size_type n) {
+    reserve(n);
+    while (size() > n)
+      pop_back();
+    while (size() < n)
+      emplace_back();
+  }
+
+  void clear() noexcept {
+    while (size() > 0)
+      pop_back();
+  }
+};
+
+template <class T, class Alloc>
+void swap(vec<T, Alloc> &a, vec<T, Alloc> &b) noexcept { a.swap(b); }
+
+/*
+ * Compile-time formats
+ *
+ * VEC_REPR_FMT("h4") resolves the format string to its VEC_ReprF entry point (VEC_reprF_h4) when compiled:
+ * VEC_REPR_FMT("h4")(v, setup) formats the vec (or typed VEC vector) v as VEC_Repr does with that format.
+ * The string is matched up to a ':' (modifiers, as "h4:^", are ignored as VEC_Repr ignores them).
+ * An unknown format, or one that does not take the item size of v, fails a static_assert.
+ */
+namespace detail {
+
+struct repr_format {
+  const char *name;
+  unsigned int sizes;
+  vsize_t (*fn)(void *v, Pp_Setup *setup);
+};
+
+constexpr repr_format repr_formats[] = {
+#define MVPG_REPR_FORMAT(F, SIZES) {#F, SIZES, VEC_reprF_##F},
+  VEC_REPR_FORMATS(MVPG_REPR_FORMAT)
+#undef MVPG_REPR_FORMAT
+};
+
+constexpr bool repr_match(const char *f, const char *name) {
+  while (*name && (*f == *name)) {
+    ++f;
+    ++name;
+  }
+  return !*name && (!*f || (*f == ':'));
+}
+
+constexpr int repr_find(const char *f) {
+  for (std::size_t i = 0; i < sizeof repr_formats / sizeof *repr_formats; i++) {
+    if (repr_match(f, repr_formats[i].name))
+      return static_cast<int>(i);
+  }
+  return -1;
+}
+
+template <class T>
+constexpr bool repr_takes(int i) {
+  return (i >= 0) && ((repr_formats[i].sizes >> sizeof(T)) & 1);
+}
+
+template <int I>
+struct repr_fn {
+  static_assert(I >= 0, "VEC_REPR_FMT: invalid format");
+  static constexpr repr_format fmt = repr_formats[I < 0 ? 0 : I];
+
+  template <class T>
+  vsize_t operator()(T *v, Pp_Setup &setup) const {
+    static_assert(I < 0 || repr_takes<T>(I), "VEC_REPR_FMT: the format does not take items of this size");
+    return fmt.fn(v, &setup);
+  }
+
+  template <class T, class Alloc>
+  vsize_t operator()(vec<T, Alloc> &v, Pp_Setup &setup) const { return (*this)(v.data(), setup); }
+};
+
+} /* namespace detail */
+
+/* Whether the format string f is one VEC_REPR_FMT resolves, for items of T (what its static_asserts check) */
+template <class T>
+constexpr bool repr_valid(const char *f) { return detail::repr_takes<T>(detail::repr_find(f)); }
+
+#define VEC_REPR_FMT(F) (::mvpg::detail::repr_fn<::mvpg::detail::repr_find(F)>{})
+
+} /* namespace mvpg */
+
+#endif /* V_BASE_HPP */
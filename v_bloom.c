@@ -0,0 +1,250 @@
+/* MVPG API Vector Type: Bloom Filter
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_bloom.h"
+
+#if !defined(VEC_BLOOM_NOSIMD) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define BLOOM_SIMD 1
+#endif
+
+/* Words (uint32_t) per block */
+#define BLOOM_WORDS 8
+
+/* Dump header: magic, block count, seed */
+#define BLOOM_MAGIC 0x4642564dul /* "MVBF" */
+#define BLOOM_HDR   (sizeof(uint64_t) * 3)
+
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+static const u32 bloomSalt[BLOOM_WORDS] = {
+  0x47b6137bu, 0x44974d91u, 0x8824ad5bu, 0xa2b7289du, 0x705495c7u, 0x2df1424bu, 0x9efc4947u, 0x5c6bfb31u
+};
+
+
+/***********************************************************
+
+ * BLOCKS
+
+************************************************************/
+
+__STATIC_FORCE_INLINE_F u32 *bloomBlock(const VEC_bloom *f, u64 h) {
+  /* Upper bits scaled to [0, nblocks) (multiply-shift, no modulo) */
+  return f->bf_blocks + (((h >> 32) * f->bf_nblocks) >> 32) * BLOOM_WORDS;
+}
+
+#ifdef BLOOM_SIMD
+__STATIC_FORCE_INLINE_F __m256i bloomMask(u32 h) {
+  const __m256i s = _mm256_loadu_si256((const __m256i *)(const void *)bloomSalt);
+  const __m256i b = _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_set1_epi32((int)h), s), 27);
+
+  return _mm256_sllv_epi32(_mm256_set1_epi32(1), b);
+}
+
+__STATIC_FORCE_INLINE_F void bloomSet(u32 *b, u32 h) {
+  __m256i *p = (__m256i *)(void *)b;
+
+  _mm256_store_si256(p, _mm256_or_si256(_mm256_load_si256(p), bloomMask(h)));
+}
+
+__STATIC_FORCE_INLINE_F bool bloomTest(const u32 *b, u32 h) {
+  return _mm256_testc_si256(_mm256_load_si256((const __m256i *)(const void *)b), bloomMask(h));
+}
+#else
+__STATIC_FORCE_INLINE_F void bloomSet(u32 *b, u32 h) {
+  unsigned i;
+
+  for (i = 0; i < BLOOM_WORDS; i++)
+    b[i] |= (u32)1 << ((h * bloomSalt[i]) >> 27);
+}
+
+__STATIC_FORCE_INLINE_F bool bloomTest(const u32 *b, u32 h) {
+  unsigned i;
+  u32 miss;
+
+  for (miss = i = 0; i < BLOOM_WORDS; i++)
+    miss |= ~b[i] & ((u32)1 << ((h * bloomSalt[i]) >> 27));
+  return !miss;
+}
+#endif
+
+
+/***********************************************************
+
+ * CREATE / DESTROY
+
+************************************************************/
+
+static VEC_bloom bloomAlloc(vsize_t nblocks, u64 seed) {
+  /* One spare block to align the first to 32 bytes */
+  VEC_bloom f;
+
+  VEC_assert(nblocks && (nblocks <= UINT32_MAX), "VEC_bloom: block count out of range");
+
+  f.bf_nblocks = nblocks;
+  f.bf_seed    = seed;
+  f.bf_vec     = VEC_new((nblocks + 1) * BLOOM_WORDS, u32);
+  f.bf_blocks  = (u32 *)(((uintptr_t)f.bf_vec + 31) & ~(uintptr_t)31);
+  VEC_vusedSet(f.bf_vec, (nblocks + 1) * BLOOM_WORDS);
+
+  return f;
+}
+
+VEC_bloom VEC_bloomNew(vsize_t n, unsigned bitsPerKey, uint64_t seed) {
+  return bloomAlloc((__bsafeUnsignedMull(n | !n, bitsPerKey | !bitsPerKey) + 255) / 256, seed);
+}
+
+void VEC_bloomDestroy(VEC_bloom *f) {
+  VEC_destroy(f->bf_vec);
+  f->bf_blocks = NULL;
+}
+
+
+/***********************************************************
+
+ * ADD / QUERY
+
+************************************************************/
+
+void VEC_bloomAdd(VEC_bloom *f, const void *key, size_t len) {
+  const u64 h = MvpgInclude_Hash64(key, len, f->bf_seed);
+
+  bloomSet(bloomBlock(f, h), (u32)h);
+}
+
+bool VEC_bloomHas(const VEC_bloom *f, const void *key, size_t len) {
+  const u64 h = MvpgInclude_Hash64(key, len, f->bf_seed);
+
+  return bloomTest(bloomBlock(f, h), (u32)h);
+}
+
+void VEC_bloomAddAll(VEC_bloom *f, const void *v) {
+  const vsize_t n = VEC_vused(v), dt = VEC_vdtype(v);
+  const char *p = v;
+  u64 h[VEC_BLOOM_BATCH];
+  vsize_t i, j, m;
+
+  for (i = 0; i < n; i += m) {
+    m = (n - i < VEC_BLOOM_BATCH) ? n - i : VEC_BLOOM_BATCH;
+    for (j = 0; j < m; j++) {
+      h[j] = MvpgInclude_Hash64(p + (i + j) * dt, dt, f->bf_seed);
+      PREFETCH(bloomBlock(f, h[j]), 1);
+    }
+    for (j = 0; j < m; j++)
+      bloomSet(bloomBlock(f, h[j]), (u32)h[j]);
+  }
+}
+
+uint64_t *VEC_bloomHasAll(uint64_t *mask, const VEC_bloom *f, const void *v) {
+  const vsize_t n = VEC_vused(v), dt = VEC_vdtype(v), nw = (n + 63) / 64;
+  const char *p = v;
+  u64 h[VEC_BLOOM_BATCH];
+  vsize_t i, j, m;
+
+  if (mask == NULL)
+    mask = VEC_new(nw | !nw, u64);
+  else {
+    VEC_assert(VEC_vdtype(mask) == sizeof(u64), "VEC_bloomHasAll: type mismatch");
+    VEC_vusedSet(mask, 0);
+    if (VEC_vsize(mask) < nw)
+      mask = VEC_INTERNAL_resize(mask, nw);
+  }
+  memset(mask, 0, nw * sizeof(u64));
+
+  /* Hash a batch and prefetch its blocks, so that the misses overlap, then test it */
+  for (i = 0; i < n; i += m) {
+    m = (n - i < VEC_BLOOM_BATCH) ? n - i : VEC_BLOOM_BATCH;
+    for (j = 0; j < m; j++) {
+      h[j] = MvpgInclude_Hash64(p + (i + j) * dt, dt, f->bf_seed);
+      PREFETCH(bloomBlock(f, h[j]), 0);
+    }
+    for (j = 0; j < m; j++)
+      mask[(i + j) / 64] |= (u64)bloomTest(bloomBlock(f, h[j]), (u32)h[j]) << ((i + j) % 64);
+  }
+  VEC_vusedSet(mask, nw);
+
+  return mask;
+}
+
+
+/***********************************************************
+
+ * SET OPERATIONS
+
+************************************************************/
+
+static void bloomMerge(VEC_bloom *dst, const VEC_bloom *src, bool inter) {
+  const vsize_t n = dst->bf_nblocks * BLOOM_WORDS;
+  u32 *d = dst->bf_blocks;
+  const u32 *s = src->bf_blocks;
+  vsize_t i;
+
+  VEC_assert((dst->bf_nblocks == src->bf_nblocks) && (dst->bf_seed == src->bf_seed), "VEC_bloom: filters differ in size or seed");
+
+  /* Plain loops: they vectorize */
+  if (inter)
+    for (i = 0; i < n; i++)
+      d[i] &= s[i];
+  else
+    for (i = 0; i < n; i++)
+      d[i] |= s[i];
+}
+
+void VEC_bloomUnion(VEC_bloom *dst, const VEC_bloom *src) {
+  bloomMerge(dst, src, false);
+}
+
+void VEC_bloomIntersect(VEC_bloom *dst, const VEC_bloom *src) {
+  bloomMerge(dst, src, true);
+}
+
+
+/***********************************************************
+
+ * SERIALIZATION
+
+************************************************************/
+
+void *VEC_bloomDump(void *dst, const VEC_bloom *f) {
+  const vsize_t size = BLOOM_HDR + f->bf_nblocks * BLOOM_WORDS * sizeof(u32);
+  const u64 hdr[3] = {BLOOM_MAGIC, f->bf_nblocks, f->bf_seed};
+
+  if (dst == NULL)
+    dst = VEC_new(size, uint8_t);
+  else {
+    VEC_assert(VEC_vdtype(dst) == 1, "VEC_bloomDump: not a byte vector");
+    VEC_vusedSet(dst, 0);
+    if (VEC_vsize(dst) < size)
+      dst = VEC_INTERNAL_resize(dst, size);
+  }
+  memcpy(dst, hdr, BLOOM_HDR);
+  mvpgMemcpy((char *)dst + BLOOM_HDR, f->bf_blocks, size - BLOOM_HDR);
+  VEC_vusedSet(dst, size);
+
+  return dst;
+}
+
+VEC_bloom VEC_bloomLoad(const void *p, size_t len) {
+  /* The bytes are input: a header and block count that do not fit len are rejected when run, not asserted */
+  u64 hdr[3];
+  VEC_bloom f = {0};
+
+  if (len < BLOOM_HDR)
+    return f;
+  memcpy(hdr, p, BLOOM_HDR);
+  if ((hdr[0] != BLOOM_MAGIC) || !hdr[1] || (hdr[1] > UINT32_MAX) || ((len - BLOOM_HDR) / (BLOOM_WORDS * sizeof(u32)) < hdr[1]))
+    return f;
+
+  f = bloomAlloc(hdr[1], hdr[2]);
+  mvpgMemcpy(f.bf_blocks, (const char *)p + BLOOM_HDR, f.bf_nblocks * BLOOM_WORDS * sizeof(u32));
+
+  return f;
+}
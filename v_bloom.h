@@ -0,0 +1,62 @@
+/* MVPG API Vector Type: Bloom Filter
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_BLOOM_H
+#define V_BLOOM_H
+
+#include "v_base.h"
+
+/*                    BLOOM FILTER (SPLIT BLOCK)
+ *
+ * VEC_bloomNew(N, B, S):       filter for about N keys at B bits per key, hashing with seed S
+ * VEC_bloomAdd(F, K, L):       add the key of L bytes at K
+ * VEC_bloomHas(F, K, L):       false if the key was never added; true if it probably was
+ * VEC_bloomAddAll(F, V):       add every item of the vector V (each item is a key of VEC_vdtype(V) bytes)
+ * VEC_bloomHasAll(M, F, V):    bit vector of the items of V that are probably in F (bit i of M[i / 64] is item i), as VEC_filterMask
+ * VEC_bloomUnion(D, S):        D |= S: D then holds the keys of both
+ * VEC_bloomIntersect(D, S):    D &= S: D then holds at least the keys of both (with more false positives than a filter of the intersection)
+ * VEC_bloomDump(D, F):         D = F as a byte vector (magic, block count, seed, blocks, in host byte order)
+ * VEC_bloomLoad(P, L):         filter from the L bytes at P (VEC_used of a VEC_bloomDump vector), as written by VEC_bloomDump;
+ *                              an empty filter (bf_vec NULL) if they are not one, or are truncated
+ * VEC_bloomDestroy(F)
+ *
+ * M and D (for VEC_bloomDump) may be NULL, in which case they are created; else they are overwritten and grown if needed.
+ * Union and intersection require filters of the same size and seed.
+ *
+ * Keys are hashed with MvpgInclude_Hash64. The upper 32 bits of the hash select a 256 bits block (one SIMD register, within a cache line),
+ * the lower 32 bits set one bit in each of its 8 words, multiplied by 8 odd salts. Adding or testing a key thus touches a single block,
+ * in one AVX2 multiply, shift and or/test (VEC_BLOOM_NOSIMD disables it). Batched adds and queries hash VEC_BLOOM_BATCH keys, and
+ * prefetch their blocks, before setting or testing them.
+ * False positives: about 3.3% at 8 bits per key, 0.5% at 12 and 0.13% at 16.
+ */
+
+#ifndef VEC_BLOOM_BATCH
+    #define VEC_BLOOM_BATCH 16
+#endif
+
+typedef struct {
+  void     *bf_vec;     /* VEC vector of uint32_t holding the blocks */
+  uint32_t *bf_blocks;  /* First block, 32 bytes aligned, in bf_vec */
+  vsize_t   bf_nblocks;
+  uint64_t  bf_seed;
+} VEC_bloom;
+
+VEC_bloom  VEC_bloomNew       (vsize_t n, unsigned bitsPerKey, uint64_t seed);
+void       VEC_bloomAdd       (VEC_bloom *f, const void *key, size_t len);
+bool       VEC_bloomHas       (const VEC_bloom *f, const void *key, size_t len);
+void       VEC_bloomAddAll    (VEC_bloom *f, const void *v);
+uint64_t  *VEC_bloomHasAll    (uint64_t *mask, const VEC_bloom *f, const void *v);
+void       VEC_bloomUnion     (VEC_bloom *dst, const VEC_bloom *src);
+void       VEC_bloomIntersect (VEC_bloom *dst, const VEC_bloom *src);
+void      *VEC_bloomDump      (void *dst, const VEC_bloom *f);
+VEC_bloom  VEC_bloomLoad      (const void *p, size_t len);
+void       VEC_bloomDestroy   (VEC_bloom *f);
+
+#endif /* V_BLOOM_H */
@@ -0,0 +1,314 @@
+/* MVPG API Vector Type: Type-Specialized Vectors
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_DEFINE_H
+#define V_DEFINE_H
+
+#include "v_base.h"
+
+/*                    VEC_DEFINE (TYPE-SPECIALIZED VECTOR)
+ *
+ * Use: VEC_DEFINE(ivec, int)  or  VEC_DEFINE_CMP(pvec, struct pt, PT_LT)
+
+ * Emits a vector type name_t (VEC_type(T)) and the following inline functions:
+ * name_new(cap)        - new vector of capacity cap
+ * name_push(&v, n)     - append n, growing v if it is filled
+ * name_pop(v)          - remove and return the last item
+ * name_get(v, i)       - item at index i (negative i counts from the back)
+ * name_resize(&v, n)   - grow v to accomodate at least n more items
+ * name_map(v, f)       - v[i] = f(v[i]) for every item
+ * name_sort(v)         - sort v in ascending order (introsort)
+ * name_nth(v, k)       - reorder v so that v[k] is the item of rank k, no greater item before it and no lesser after it (introselect)
+ * name_select(v, k, m) - name_nth for the m ascending ranks k[0..m) at once, splitting the ranks at each partition
+ * name_quantiles(v, q, m, out) - out[i] = item of rank round(q[i] * (used - 1)) (no interpolation); reorders v as name_select
+ * name_topk(v, k)      - new vector of the k greatest items of v, in descending order (v is unchanged)
+ *
+ * The element size is the constant sizeof(T), so no operation checks or multiplies by VEC_vdtype at runtime (name_resize grows
+ * through VEC_INTERNAL_resizeTyped). With VEC_PROFILE, the vectors of name_new are counted at the site of the VEC_DEFINE.
+ * VEC_DEFINE_CMP takes a less-than predicate LT(a, b) (function or macro) used by sort and selection; VEC_DEFINE uses a < b.
+ * Vectors are ordinary VEC vectors: every generic VEC_ macro still applies to them.
+ */
+
+#define VEC_DEFINE_LT(a, b) ((a) < (b))
+
+#define VEC_DEFINE(name, T)			\
+  VEC_INTERNAL_define(name, T, VEC_DEFINE_LT)
+
+#define VEC_DEFINE_CMP(name, T, LT)		\
+  VEC_INTERNAL_define(name, T, LT)
+
+/* Sort: partitions below VEC_DEFINE_ISORT items are insertion sorted */
+#define VEC_DEFINE_ISORT 16
+
+/* Top-k: items are tested against the heap minimum VEC_DEFINE_TOPKBLK at a time, so that the test vectorizes for arithmetic types */
+#define VEC_DEFINE_TOPKBLK 32
+
+/* Partition depth before sort and selection fall back to heapsort: 2 * log2(n) */
+__STATIC_FORCE_INLINE_F unsigned VEC_INTERNAL_depth(vsize_t n) {
+  unsigned depth;
+
+  for (depth = 0; n; n >>= 1)
+    depth += 2;
+  return depth;
+}
+
+#define VEC_DEFINE_FN(name, F) MvpgMacro_Concat(name, F)
+
+#define VEC_INTERNAL_define(name, T, LT)				\
+									\
+  typedef VEC_type(T) VEC_DEFINE_FN(name, _t);				\
+									\
+  __STATIC_FORCE_INLINE_F __WARN_UNUSED__ VEC_type(T) VEC_DEFINE_FN(name, _new)(const vsize_t cap) { \
+    return VEC_new(cap, T);						\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _resize)(VEC_refType(T) v, const vsize_t n) { \
+    *v = VEC_INTERNAL_resizeTyped(*v, n, sizeof(T));			\
+  }									\
+									\
+  __STATIC_FORCE_INLINE_F __NONNULL__ void VEC_DEFINE_FN(name, _push)(VEC_refType(T) v, const T n) { \
+    if (LIKELY___(VEC_vused(*v) == VEC_vsize(*v), 0))			\
+      VEC_DEFINE_FN(name, _resize)(v, 1);				\
+									\
+    (*v)[VEC_vusedPostIncr(*v)] = n;					\
+  }									\
+									\
+  __STATIC_FORCE_INLINE_F __NONNULL__ T VEC_DEFINE_FN(name, _pop)(VEC_type(T) v) { \
+    VEC_assert(VEC_vused(v) > 0, "VEC_DEFINE: pop from empty vector");	\
+									\
+    return v[VEC_vusedPreDecr(v)];					\
+  }									\
+									\
+  __STATIC_FORCE_INLINE_F __NONNULL__ T VEC_DEFINE_FN(name, _get)(const VEC_type(T) v, const long i) { \
+    const vsize_t k = i < 0 ? VEC_vused(v) + i : (vsize_t)i;		\
+									\
+    VEC_assert(k < VEC_vused(v), "VEC_DEFINE: index out of range");	\
+    return v[k];							\
+  }									\
+									\
+  __STATIC_FORCE_INLINE_F __NONNULL__ void VEC_DEFINE_FN(name, _map)(VEC_type(T) v, T (*f)(T)) { \
+    register vsize_t i, e;						\
+									\
+    for (i = 0, e = VEC_vused(v); i < e; i++)				\
+      v[i] = f(v[i]);							\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_isort)(VEC_type(T) a, const vsize_t n) { \
+    vsize_t i, j;							\
+    T x;								\
+									\
+    for (i = 1; i < n; i++) {						\
+      for (x = a[i], j = i; j && LT(x, a[j - 1]); j--)			\
+	a[j] = a[j - 1];						\
+      a[j] = x;								\
+    }									\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_sift)(VEC_type(T) a, vsize_t i, const vsize_t n) { \
+    vsize_t c;								\
+    T x;								\
+									\
+    for (x = a[i]; (c = 2*i + 1) < n; i = c) {				\
+      c += (c + 1 < n) && LT(a[c], a[c + 1]);				\
+      if (! LT(x, a[c]))						\
+	break;								\
+      a[i] = a[c];							\
+    }									\
+    a[i] = x;								\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_hsort)(VEC_type(T) a, vsize_t n) { \
+    vsize_t i;								\
+    T x;								\
+									\
+    for (i = n / 2; i-- > 0; )						\
+      VEC_DEFINE_FN(name, _INTERNAL_sift)(a, i, n);			\
+    while (n-- > 1) {							\
+      x = a[0], a[0] = a[n], a[n] = x;					\
+      VEC_DEFINE_FN(name, _INTERNAL_sift)(a, 0, n);			\
+    }									\
+  }									\
+									\
+  /* Hoare partition of a[0..n) about the median of a[0], a[n/2], a[n-1]; returns the size of the left side */ \
+  static __inline__ __NONNULL__ vsize_t VEC_DEFINE_FN(name, _INTERNAL_partition)(VEC_type(T) a, const vsize_t n) { \
+    vsize_t i, j;							\
+    T p, x;								\
+									\
+    i = n / 2, j = n - 1;						\
+    if (LT(a[i], a[0])) x = a[i], a[i] = a[0], a[0] = x;		\
+    if (LT(a[j], a[i])) x = a[j], a[j] = a[i], a[i] = x;		\
+    if (LT(a[i], a[0])) x = a[i], a[i] = a[0], a[0] = x;		\
+									\
+    for (p = a[i], i = 0; ; i++, j--) {					\
+      while (LT(a[i], p)) i++;						\
+      while (LT(p, a[j])) j--;						\
+      if (i >= j)							\
+	return j + 1;							\
+      x = a[i], a[i] = a[j], a[j] = x;					\
+    }									\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_qsort)(VEC_type(T) a, vsize_t n, unsigned depth) { \
+    vsize_t k;								\
+									\
+    while (n > VEC_DEFINE_ISORT) {					\
+      if (! depth--) {							\
+	VEC_DEFINE_FN(name, _INTERNAL_hsort)(a, n);			\
+	return;								\
+      }									\
+      k = VEC_DEFINE_FN(name, _INTERNAL_partition)(a, n);		\
+									\
+      /* Recurse into the smaller side, loop on the larger */		\
+      if (k < n - k) {							\
+	VEC_DEFINE_FN(name, _INTERNAL_qsort)(a, k, depth);		\
+	a += k, n -= k;							\
+      }									\
+      else {								\
+	VEC_DEFINE_FN(name, _INTERNAL_qsort)(a + k, n - k, depth);	\
+	n = k;								\
+      }									\
+    }									\
+    VEC_DEFINE_FN(name, _INTERNAL_isort)(a, n);				\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _sort)(VEC_type(T) v) { \
+    VEC_DEFINE_FN(name, _INTERNAL_qsort)(v, VEC_vused(v), VEC_INTERNAL_depth(VEC_vused(v))); \
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_select)(VEC_type(T) a, vsize_t n, vsize_t k, unsigned depth) { \
+    vsize_t m;								\
+									\
+    while (n > VEC_DEFINE_ISORT) {					\
+      if (! depth--) {							\
+	VEC_DEFINE_FN(name, _INTERNAL_hsort)(a, n);			\
+	return;								\
+      }									\
+      /* Every item left of m is no greater than any item right of it */ \
+      m = VEC_DEFINE_FN(name, _INTERNAL_partition)(a, n);		\
+      if (k < m)							\
+	n = m;								\
+      else								\
+	a += m, n -= m, k -= m;						\
+    }									\
+    VEC_DEFINE_FN(name, _INTERNAL_isort)(a, n);				\
+  }									\
+									\
+  /* Ranks ks[0..nk) are ascending and relative to a */		\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_mselect)(VEC_type(T) a, vsize_t n, const vsize_t *ks, vsize_t nk, vsize_t base, unsigned depth) { \
+    vsize_t m, s;							\
+									\
+    while (nk && (n > VEC_DEFINE_ISORT)) {				\
+      if (nk == 1) {							\
+	VEC_DEFINE_FN(name, _INTERNAL_select)(a, n, ks[0] - base, depth); \
+	return;								\
+      }									\
+      if (! depth--) {							\
+	VEC_DEFINE_FN(name, _INTERNAL_hsort)(a, n);			\
+	return;								\
+      }									\
+      m = VEC_DEFINE_FN(name, _INTERNAL_partition)(a, n);		\
+      for (s = 0; (s < nk) && (ks[s] - base < m); s++)			\
+	PASS;								\
+									\
+      VEC_DEFINE_FN(name, _INTERNAL_mselect)(a, m, ks, s, base, depth); \
+      a += m, n -= m, base += m, ks += s, nk -= s;			\
+    }									\
+    if (nk)								\
+      VEC_DEFINE_FN(name, _INTERNAL_isort)(a, n);			\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _nth)(VEC_type(T) v, const vsize_t k) { \
+    VEC_assert(k < VEC_vused(v), "VEC_DEFINE: rank out of range");	\
+    VEC_DEFINE_FN(name, _INTERNAL_select)(v, VEC_vused(v), k, VEC_INTERNAL_depth(VEC_vused(v))); \
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _select)(VEC_type(T) v, const vsize_t *k, const vsize_t m) { \
+    VEC_assert(!m || k[m - 1] < VEC_vused(v), "VEC_DEFINE: rank out of range"); \
+    VEC_DEFINE_FN(name, _INTERNAL_mselect)(v, VEC_vused(v), k, m, 0, VEC_INTERNAL_depth(VEC_vused(v))); \
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _quantiles)(VEC_type(T) v, const double *q, const vsize_t m, T *out) { \
+    const vsize_t n = VEC_vused(v);					\
+    vsize_t *k, i, j, r;						\
+									\
+    VEC_assert(n > 0, "VEC_DEFINE: quantiles of an empty vector");	\
+    k = (vsize_t *)malloc((m | !m) * sizeof(vsize_t));			\
+    VEC_assert(k != NULL, "VEC_DEFINE: out of memory");		\
+									\
+    /* Ranks, insertion sorted (few) */					\
+    for (i = 0; i < m; i++) {						\
+      r = (vsize_t)((q[i] <= 0 ? 0 : q[i] >= 1 ? 1 : q[i]) * (n - 1) + 0.5); \
+      for (j = i; j && (r < k[j - 1]); j--)				\
+	k[j] = k[j - 1];						\
+      k[j] = r;								\
+    }									\
+    VEC_DEFINE_FN(name, _INTERNAL_mselect)(v, n, k, m, 0, VEC_INTERNAL_depth(n)); \
+    for (i = 0; i < m; i++)						\
+      out[i] = v[(vsize_t)((q[i] <= 0 ? 0 : q[i] >= 1 ? 1 : q[i]) * (n - 1) + 0.5)]; \
+    free(k);								\
+  }									\
+									\
+  static __inline__ __NONNULL__ void VEC_DEFINE_FN(name, _INTERNAL_siftmin)(VEC_type(T) a, vsize_t i, const vsize_t n) { \
+    vsize_t c;								\
+    T x;								\
+									\
+    for (x = a[i]; (c = 2*i + 1) < n; i = c) {				\
+      c += (c + 1 < n) && LT(a[c + 1], a[c]);				\
+      if (! LT(a[c], x))						\
+	break;								\
+      a[i] = a[c];							\
+    }									\
+    a[i] = x;								\
+  }									\
+									\
+  static __inline__ __NONNULL__ __WARN_UNUSED__ VEC_type(T) VEC_DEFINE_FN(name, _topk)(const VEC_type(T) v, vsize_t k) { \
+    /* Min-heap of the k greatest items so far; an item enters it only if greater than its root */ \
+    const vsize_t n = VEC_vused(v);					\
+    VEC_type(T) h;							\
+    vsize_t i, j, e;							\
+    bool any;								\
+    T x;								\
+									\
+    k = (k < n) ? k : n;						\
+    h = VEC_DEFINE_FN(name, _new)(k | !k);				\
+    if (! k)								\
+      return h;								\
+									\
+    memcpy(h, v, k * sizeof(T));					\
+    VEC_vusedSet(h, k);							\
+    for (i = k / 2; i-- > 0; )						\
+      VEC_DEFINE_FN(name, _INTERNAL_siftmin)(h, i, k);			\
+									\
+    for (i = k; i < n; i = e) {						\
+      e = (n - i > VEC_DEFINE_TOPKBLK) ? i + VEC_DEFINE_TOPKBLK : n;	\
+      for (any = false, j = i; j < e; j++)				\
+	any |= LT(h[0], v[j]);						\
+      if (! any)							\
+	continue;							\
+									\
+      for (j = i; j < e; j++) {						\
+	if (LT(h[0], v[j])) {						\
+	  h[0] = v[j];							\
+	  VEC_DEFINE_FN(name, _INTERNAL_siftmin)(h, 0, k);		\
+	}								\
+      }									\
+    }									\
+									\
+    /* Descending: move the minimum to the back */			\
+    for (e = k; e-- > 1; ) {						\
+      x = h[0], h[0] = h[e], h[e] = x;					\
+      VEC_DEFINE_FN(name, _INTERNAL_siftmin)(h, 0, e);			\
+    }									\
+    return h;								\
+  }									\
+									\
+  typedef VEC_type(T) VEC_DEFINE_FN(name, _INTERNAL_semicolon)
+
+#endif /* V_DEFINE_H */
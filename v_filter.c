@@ -0,0 +1,704 @@
+/* MVPG API Vector Type: Filter
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_filter.h"
+#include <math.h>
+
+#if !defined(VEC_FILTER_NOSIMD) && (defined(__AVX512F__) || defined(__AVX2__))
+    #include <immintrin.h>
+    #define FILTER_SIMD 1
+    #ifndef __AVX512F__
+        #define FILTER_LUT 1
+    #endif
+#endif
+
+/* Items per mask word, and bytes written past the last survivor by full-width stores */
+#define FILTER_BLK   64
+#define FILTER_SLACK 64
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef float    f32;
+typedef double   f64;
+
+/* Normalized predicate: an integer x matches if (x - lo) mod 2^bits <= span, a float if flo <= x <= fhi.
+ * The match is then inverted by neg (all ones for VEC_NE and VEC_OUT). Every VEC_cmp reduces to this form.
+ */
+typedef struct {
+  u64 lo, span;
+  f64 flo, fhi;
+  u64 neg;
+} filtNorm;
+
+__NONNULL__ static void filterNormalize(filtNorm *f, const VEC_pred *p) {
+  const VEC_kind k = (VEC_kind)p->vp_kind;
+  const unsigned bits = VEC_kindSize(k) << 3;
+  u64 w, min, max, lo, hi;
+  f64 a, b;
+  bool empty;
+
+  *f     = (filtNorm){0}; /* Each kind sets only its own bounds */
+  empty  = false;
+  f->neg = ((p->vp_cmp == VEC_NE) || (p->vp_cmp == VEC_OUT)) ? ~(u64)0 : 0;
+
+  if (VEC_kindFloat(k)) {
+    a = (k == VEC_F32) ? (f32)p->vp_lo.f : p->vp_lo.f;
+    b = (k == VEC_F32) ? (f32)p->vp_hi.f : p->vp_hi.f;
+
+    switch (p->vp_cmp) {
+    case VEC_EQ:
+    case VEC_NE:
+      b = a;
+      break;
+    case VEC_LT:
+      empty = (a == -INFINITY);
+      b = (k == VEC_F32) ? nextafterf((f32)a, -INFINITY) : nextafter(a, -INFINITY);
+      a = -INFINITY;
+      break;
+    case VEC_LE:
+      b = a;
+      a = -INFINITY;
+      break;
+    case VEC_GT:
+      empty = (a == INFINITY);
+      a = (k == VEC_F32) ? nextafterf((f32)a, INFINITY) : nextafter(a, INFINITY);
+      b = INFINITY;
+      break;
+    case VEC_GE:
+      b = INFINITY;
+      break;
+    default:
+      break;
+    }
+    /* NaN bounds never match */
+    f->flo = empty ? NAN : a;
+    f->fhi = empty ? NAN : b;
+    return;
+  }
+
+  w   = (bits == 64) ? ~(u64)0 : ((u64)1 << bits) - 1;
+  min = VEC_kindSigned(k) ? (w >> 1) + 1 : 0;
+  max = (min - 1) & w;
+  lo  = p->vp_lo.u & w;
+  hi  = p->vp_hi.u & w;
+
+  switch (p->vp_cmp) {
+  case VEC_EQ:
+  case VEC_NE:
+    hi = lo;
+    break;
+  case VEC_LT:
+    empty = (lo == min);
+    hi = (lo - 1) & w;
+    lo = min;
+    break;
+  case VEC_LE:
+    hi = lo;
+    lo = min;
+    break;
+  case VEC_GT:
+    empty = (lo == max);
+    lo = (lo + 1) & w;
+    hi = max;
+    break;
+  case VEC_GE:
+    hi = max;
+    break;
+  default:
+    /* Order of signed bounds: bias by min */
+    empty = ((lo - min) & w) > ((hi - min) & w);
+    break;
+  }
+
+  if (empty) {
+    /* Every item, inverted */
+    lo = 0;
+    hi = w;
+    f->neg = ~f->neg;
+  }
+  f->lo   = lo;
+  f->span = (hi - lo) & w;
+}
+
+
+/***********************************************************
+
+ * MASK (bit k of a block mask is item k of the block)
+
+************************************************************/
+
+#define FILTER_SCALARI(T)						\
+  __STATIC_FORCE_INLINE_F u64 filterScalar_##T(const T *s, vsize_t n, const filtNorm *f) { \
+    const T lo = (T)f->lo, span = (T)f->span;				\
+    vsize_t k;								\
+    u64 m;								\
+									\
+    for (k = m = 0; k < n; k++)						\
+      m |= (u64)((T)(s[k] - lo) <= span) << k;				\
+    return m;								\
+  }
+
+#define FILTER_SCALARF(T)						\
+  __STATIC_FORCE_INLINE_F u64 filterScalar_##T(const T *s, vsize_t n, const filtNorm *f) { \
+    const T lo = (T)f->flo, hi = (T)f->fhi;				\
+    vsize_t k;								\
+    u64 m;								\
+									\
+    for (k = m = 0; k < n; k++)						\
+      m |= (u64)((s[k] >= lo) & (s[k] <= hi)) << k;			\
+    return m;								\
+  }
+
+FILTER_SCALARI(u8)
+FILTER_SCALARI(u16)
+FILTER_SCALARI(u32)
+FILTER_SCALARI(u64)
+FILTER_SCALARF(f32)
+FILTER_SCALARF(f64)
+
+/* Full blocks */
+#if defined(FILTER_SIMD) && defined(__AVX512F__)
+__STATIC_FORCE_INLINE_F u64 filterBlock_u32(const u32 *s, const filtNorm *f) {
+  const __m512i lo = _mm512_set1_epi32((int)f->lo), span = _mm512_set1_epi32((int)f->span);
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 4; j++)
+    m |= (u64)_mm512_cmple_epu32_mask(_mm512_sub_epi32(_mm512_loadu_si512(s + 16*j), lo), span) << (16*j);
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_u64(const u64 *s, const filtNorm *f) {
+  const __m512i lo = _mm512_set1_epi64((long long)f->lo), span = _mm512_set1_epi64((long long)f->span);
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 8; j++)
+    m |= (u64)_mm512_cmple_epu64_mask(_mm512_sub_epi64(_mm512_loadu_si512(s + 8*j), lo), span) << (8*j);
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_f32(const f32 *s, const filtNorm *f) {
+  const __m512 lo = _mm512_set1_ps((f32)f->flo), hi = _mm512_set1_ps((f32)f->fhi);
+  __m512 x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 4; j++) {
+    x = _mm512_loadu_ps(s + 16*j);
+    m |= (u64)_mm512_mask_cmp_ps_mask(_mm512_cmp_ps_mask(x, lo, _CMP_GE_OQ), x, hi, _CMP_LE_OQ) << (16*j);
+  }
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_f64(const f64 *s, const filtNorm *f) {
+  const __m512d lo = _mm512_set1_pd(f->flo), hi = _mm512_set1_pd(f->fhi);
+  __m512d x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 8; j++) {
+    x = _mm512_loadu_pd(s + 8*j);
+    m |= (u64)_mm512_mask_cmp_pd_mask(_mm512_cmp_pd_mask(x, lo, _CMP_GE_OQ), x, hi, _CMP_LE_OQ) << (8*j);
+  }
+  return m;
+}
+
+    #ifdef __AVX512BW__
+__STATIC_FORCE_INLINE_F u64 filterBlock_u8(const u8 *s, const filtNorm *f) {
+  return _mm512_cmple_epu8_mask(_mm512_sub_epi8(_mm512_loadu_si512(s), _mm512_set1_epi8((char)f->lo)), _mm512_set1_epi8((char)f->span));
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_u16(const u16 *s, const filtNorm *f) {
+  const __m512i lo = _mm512_set1_epi16((short)f->lo), span = _mm512_set1_epi16((short)f->span);
+
+  return (u64)_mm512_cmple_epu16_mask(_mm512_sub_epi16(_mm512_loadu_si512(s), lo), span)
+    | ((u64)_mm512_cmple_epu16_mask(_mm512_sub_epi16(_mm512_loadu_si512(s + 32), lo), span) << 32);
+}
+    #else
+        #define filterBlock_u8(S, F)  filterScalar_u8(S, FILTER_BLK, F)
+        #define filterBlock_u16(S, F) filterScalar_u16(S, FILTER_BLK, F)
+    #endif
+
+#elif defined(FILTER_SIMD)
+/* AVX2 has signed compares only: x <= y (unsigned) is !((x ^ bias) > (y ^ bias)) */
+__STATIC_FORCE_INLINE_F u64 filterBlock_u8(const u8 *s, const filtNorm *f) {
+  const __m256i bias = _mm256_set1_epi8((char)0x80), lo = _mm256_set1_epi8((char)f->lo);
+  const __m256i span = _mm256_set1_epi8((char)(f->span ^ 0x80));
+  __m256i x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 2; j++) {
+    x = _mm256_xor_si256(_mm256_sub_epi8(_mm256_loadu_si256((const void *)(s + 32*j)), lo), bias);
+    m |= (u64)(u32)~_mm256_movemask_epi8(_mm256_cmpgt_epi8(x, span)) << (32*j);
+  }
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_u16(const u16 *s, const filtNorm *f) {
+  const __m256i bias = _mm256_set1_epi16((short)0x8000), lo = _mm256_set1_epi16((short)f->lo);
+  const __m256i span = _mm256_set1_epi16((short)(f->span ^ 0x8000));
+  __m256i a, b;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 2; j++) {
+    a = _mm256_xor_si256(_mm256_sub_epi16(_mm256_loadu_si256((const void *)(s + 32*j)), lo), bias);
+    b = _mm256_xor_si256(_mm256_sub_epi16(_mm256_loadu_si256((const void *)(s + 32*j + 16)), lo), bias);
+    /* Pack both compares to bytes; packs interleaves the 128 bits lanes, which the permute restores */
+    a = _mm256_permute4x64_epi64(_mm256_packs_epi16(_mm256_cmpgt_epi16(a, span), _mm256_cmpgt_epi16(b, span)), 0xd8);
+    m |= (u64)(u32)~_mm256_movemask_epi8(a) << (32*j);
+  }
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_u32(const u32 *s, const filtNorm *f) {
+  const __m256i bias = _mm256_set1_epi32((int)0x80000000), lo = _mm256_set1_epi32((int)f->lo);
+  const __m256i span = _mm256_set1_epi32((int)(f->span ^ 0x80000000));
+  __m256i x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 8; j++) {
+    x = _mm256_xor_si256(_mm256_sub_epi32(_mm256_loadu_si256((const void *)(s + 8*j)), lo), bias);
+    m |= (u64)(~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(x, span))) & 0xff) << (8*j);
+  }
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_u64(const u64 *s, const filtNorm *f) {
+  const __m256i bias = _mm256_set1_epi64x((long long)0x8000000000000000ull), lo = _mm256_set1_epi64x((long long)f->lo);
+  const __m256i span = _mm256_set1_epi64x((long long)(f->span ^ 0x8000000000000000ull));
+  __m256i x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 16; j++) {
+    x = _mm256_xor_si256(_mm256_sub_epi64(_mm256_loadu_si256((const void *)(s + 4*j)), lo), bias);
+    m |= (u64)(~_mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpgt_epi64(x, span))) & 0xf) << (4*j);
+  }
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_f32(const f32 *s, const filtNorm *f) {
+  const __m256 lo = _mm256_set1_ps((f32)f->flo), hi = _mm256_set1_ps((f32)f->fhi);
+  __m256 x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 8; j++) {
+    x = _mm256_loadu_ps(s + 8*j);
+    x = _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hi, _CMP_LE_OQ));
+    m |= (u64)_mm256_movemask_ps(x) << (8*j);
+  }
+  return m;
+}
+
+__STATIC_FORCE_INLINE_F u64 filterBlock_f64(const f64 *s, const filtNorm *f) {
+  const __m256d lo = _mm256_set1_pd(f->flo), hi = _mm256_set1_pd(f->fhi);
+  __m256d x;
+  vsize_t j;
+  u64 m;
+
+  for (j = m = 0; j < 16; j++) {
+    x = _mm256_loadu_pd(s + 4*j);
+    x = _mm256_and_pd(_mm256_cmp_pd(x, lo, _CMP_GE_OQ), _mm256_cmp_pd(x, hi, _CMP_LE_OQ));
+    m |= (u64)_mm256_movemask_pd(x) << (4*j);
+  }
+  return m;
+}
+
+#else
+    #define filterBlock_u8(S, F)  filterScalar_u8(S, FILTER_BLK, F)
+    #define filterBlock_u16(S, F) filterScalar_u16(S, FILTER_BLK, F)
+    #define filterBlock_u32(S, F) filterScalar_u32(S, FILTER_BLK, F)
+    #define filterBlock_u64(S, F) filterScalar_u64(S, FILTER_BLK, F)
+    #define filterBlock_f32(S, F) filterScalar_f32(S, FILTER_BLK, F)
+    #define filterBlock_f64(S, F) filterScalar_f64(S, FILTER_BLK, F)
+#endif
+
+
+/***********************************************************
+
+ * COMPACTION (matched items of a block to d, others to r unless NULL; returns the count matched)
+ * d may alias the block (d <= s), as every item is read before its slot can be written.
+
+************************************************************/
+
+#define FILTER_COMPACTSCALAR(T)						\
+  __STATIC_FORCE_INLINE_F vsize_t filterCompactScalar_##T(T *d, T *r, const T *s, u64 m, vsize_t n) { \
+    vsize_t k, w, x;							\
+    u64 b;								\
+    T t;								\
+									\
+    if (r == NULL) {							\
+      if ((vsize_t)POPCNT64(m) < (n >> 2)) {				\
+	/* Sparse */							\
+	for (w = 0; m; m &= m - 1)					\
+	  d[w++] = s[CTZ64(m)];						\
+	return w;							\
+      }									\
+      for (k = w = 0; k < n; k++) {					\
+	t = s[k];							\
+	d[w] = t;							\
+	w += (m >> k) & 1;						\
+      }									\
+      return w;								\
+    }									\
+    for (k = w = x = 0; k < n; k++) {					\
+      t = s[k];								\
+      b = (m >> k) & 1;							\
+      d[w] = t;								\
+      r[x] = t;								\
+      w += b;								\
+      x += b ^ 1;							\
+    }									\
+    return w;								\
+  }
+
+FILTER_COMPACTSCALAR(u8)
+FILTER_COMPACTSCALAR(u16)
+FILTER_COMPACTSCALAR(u32)
+FILTER_COMPACTSCALAR(u64)
+
+#ifdef FILTER_LUT
+/* Shuffle table: lanes of the set bits of an 8 bits mask, packed first (constant, so that no thread initializes it) */
+static const u8 filterLUT[256][8] = {
+  {0,0,0,0,0,0,0,0}, {0,0,0,0,0,0,0,0}, {1,0,0,0,0,0,0,0}, {0,1,0,0,0,0,0,0}, {2,0,0,0,0,0,0,0}, {0,2,0,0,0,0,0,0}, {1,2,0,0,0,0,0,0}, {0,1,2,0,0,0,0,0},
+  {3,0,0,0,0,0,0,0}, {0,3,0,0,0,0,0,0}, {1,3,0,0,0,0,0,0}, {0,1,3,0,0,0,0,0}, {2,3,0,0,0,0,0,0}, {0,2,3,0,0,0,0,0}, {1,2,3,0,0,0,0,0}, {0,1,2,3,0,0,0,0},
+  {4,0,0,0,0,0,0,0}, {0,4,0,0,0,0,0,0}, {1,4,0,0,0,0,0,0}, {0,1,4,0,0,0,0,0}, {2,4,0,0,0,0,0,0}, {0,2,4,0,0,0,0,0}, {1,2,4,0,0,0,0,0}, {0,1,2,4,0,0,0,0},
+  {3,4,0,0,0,0,0,0}, {0,3,4,0,0,0,0,0}, {1,3,4,0,0,0,0,0}, {0,1,3,4,0,0,0,0}, {2,3,4,0,0,0,0,0}, {0,2,3,4,0,0,0,0}, {1,2,3,4,0,0,0,0}, {0,1,2,3,4,0,0,0},
+  {5,0,0,0,0,0,0,0}, {0,5,0,0,0,0,0,0}, {1,5,0,0,0,0,0,0}, {0,1,5,0,0,0,0,0}, {2,5,0,0,0,0,0,0}, {0,2,5,0,0,0,0,0}, {1,2,5,0,0,0,0,0}, {0,1,2,5,0,0,0,0},
+  {3,5,0,0,0,0,0,0}, {0,3,5,0,0,0,0,0}, {1,3,5,0,0,0,0,0}, {0,1,3,5,0,0,0,0}, {2,3,5,0,0,0,0,0}, {0,2,3,5,0,0,0,0}, {1,2,3,5,0,0,0,0}, {0,1,2,3,5,0,0,0},
+  {4,5,0,0,0,0,0,0}, {0,4,5,0,0,0,0,0}, {1,4,5,0,0,0,0,0}, {0,1,4,5,0,0,0,0}, {2,4,5,0,0,0,0,0}, {0,2,4,5,0,0,0,0}, {1,2,4,5,0,0,0,0}, {0,1,2,4,5,0,0,0},
+  {3,4,5,0,0,0,0,0}, {0,3,4,5,0,0,0,0}, {1,3,4,5,0,0,0,0}, {0,1,3,4,5,0,0,0}, {2,3,4,5,0,0,0,0}, {0,2,3,4,5,0,0,0}, {1,2,3,4,5,0,0,0}, {0,1,2,3,4,5,0,0},
+  {6,0,0,0,0,0,0,0}, {0,6,0,0,0,0,0,0}, {1,6,0,0,0,0,0,0}, {0,1,6,0,0,0,0,0}, {2,6,0,0,0,0,0,0}, {0,2,6,0,0,0,0,0}, {1,2,6,0,0,0,0,0}, {0,1,2,6,0,0,0,0},
+  {3,6,0,0,0,0,0,0}, {0,3,6,0,0,0,0,0}, {1,3,6,0,0,0,0,0}, {0,1,3,6,0,0,0,0}, {2,3,6,0,0,0,0,0}, {0,2,3,6,0,0,0,0}, {1,2,3,6,0,0,0,0}, {0,1,2,3,6,0,0,0},
+  {4,6,0,0,0,0,0,0}, {0,4,6,0,0,0,0,0}, {1,4,6,0,0,0,0,0}, {0,1,4,6,0,0,0,0}, {2,4,6,0,0,0,0,0}, {0,2,4,6,0,0,0,0}, {1,2,4,6,0,0,0,0}, {0,1,2,4,6,0,0,0},
+  {3,4,6,0,0,0,0,0}, {0,3,4,6,0,0,0,0}, {1,3,4,6,0,0,0,0}, {0,1,3,4,6,0,0,0}, {2,3,4,6,0,0,0,0}, {0,2,3,4,6,0,0,0}, {1,2,3,4,6,0,0,0}, {0,1,2,3,4,6,0,0},
+  {5,6,0,0,0,0,0,0}, {0,5,6,0,0,0,0,0}, {1,5,6,0,0,0,0,0}, {0,1,5,6,0,0,0,0}, {2,5,6,0,0,0,0,0}, {0,2,5,6,0,0,0,0}, {1,2,5,6,0,0,0,0}, {0,1,2,5,6,0,0,0},
+  {3,5,6,0,0,0,0,0}, {0,3,5,6,0,0,0,0}, {1,3,5,6,0,0,0,0}, {0,1,3,5,6,0,0,0}, {2,3,5,6,0,0,0,0}, {0,2,3,5,6,0,0,0}, {1,2,3,5,6,0,0,0}, {0,1,2,3,5,6,0,0},
+  {4,5,6,0,0,0,0,0}, {0,4,5,6,0,0,0,0}, {1,4,5,6,0,0,0,0}, {0,1,4,5,6,0,0,0}, {2,4,5,6,0,0,0,0}, {0,2,4,5,6,0,0,0}, {1,2,4,5,6,0,0,0}, {0,1,2,4,5,6,0,0},
+  {3,4,5,6,0,0,0,0}, {0,3,4,5,6,0,0,0}, {1,3,4,5,6,0,0,0}, {0,1,3,4,5,6,0,0}, {2,3,4,5,6,0,0,0}, {0,2,3,4,5,6,0,0}, {1,2,3,4,5,6,0,0}, {0,1,2,3,4,5,6,0},
+  {7,0,0,0,0,0,0,0}, {0,7,0,0,0,0,0,0}, {1,7,0,0,0,0,0,0}, {0,1,7,0,0,0,0,0}, {2,7,0,0,0,0,0,0}, {0,2,7,0,0,0,0,0}, {1,2,7,0,0,0,0,0}, {0,1,2,7,0,0,0,0},
+  {3,7,0,0,0,0,0,0}, {0,3,7,0,0,0,0,0}, {1,3,7,0,0,0,0,0}, {0,1,3,7,0,0,0,0}, {2,3,7,0,0,0,0,0}, {0,2,3,7,0,0,0,0}, {1,2,3,7,0,0,0,0}, {0,1,2,3,7,0,0,0},
+  {4,7,0,0,0,0,0,0}, {0,4,7,0,0,0,0,0}, {1,4,7,0,0,0,0,0}, {0,1,4,7,0,0,0,0}, {2,4,7,0,0,0,0,0}, {0,2,4,7,0,0,0,0}, {1,2,4,7,0,0,0,0}, {0,1,2,4,7,0,0,0},
+  {3,4,7,0,0,0,0,0}, {0,3,4,7,0,0,0,0}, {1,3,4,7,0,0,0,0}, {0,1,3,4,7,0,0,0}, {2,3,4,7,0,0,0,0}, {0,2,3,4,7,0,0,0}, {1,2,3,4,7,0,0,0}, {0,1,2,3,4,7,0,0},
+  {5,7,0,0,0,0,0,0}, {0,5,7,0,0,0,0,0}, {1,5,7,0,0,0,0,0}, {0,1,5,7,0,0,0,0}, {2,5,7,0,0,0,0,0}, {0,2,5,7,0,0,0,0}, {1,2,5,7,0,0,0,0}, {0,1,2,5,7,0,0,0},
+  {3,5,7,0,0,0,0,0}, {0,3,5,7,0,0,0,0}, {1,3,5,7,0,0,0,0}, {0,1,3,5,7,0,0,0}, {2,3,5,7,0,0,0,0}, {0,2,3,5,7,0,0,0}, {1,2,3,5,7,0,0,0}, {0,1,2,3,5,7,0,0},
+  {4,5,7,0,0,0,0,0}, {0,4,5,7,0,0,0,0}, {1,4,5,7,0,0,0,0}, {0,1,4,5,7,0,0,0}, {2,4,5,7,0,0,0,0}, {0,2,4,5,7,0,0,0}, {1,2,4,5,7,0,0,0}, {0,1,2,4,5,7,0,0},
+  {3,4,5,7,0,0,0,0}, {0,3,4,5,7,0,0,0}, {1,3,4,5,7,0,0,0}, {0,1,3,4,5,7,0,0}, {2,3,4,5,7,0,0,0}, {0,2,3,4,5,7,0,0}, {1,2,3,4,5,7,0,0}, {0,1,2,3,4,5,7,0},
+  {6,7,0,0,0,0,0,0}, {0,6,7,0,0,0,0,0}, {1,6,7,0,0,0,0,0}, {0,1,6,7,0,0,0,0}, {2,6,7,0,0,0,0,0}, {0,2,6,7,0,0,0,0}, {1,2,6,7,0,0,0,0}, {0,1,2,6,7,0,0,0},
+  {3,6,7,0,0,0,0,0}, {0,3,6,7,0,0,0,0}, {1,3,6,7,0,0,0,0}, {0,1,3,6,7,0,0,0}, {2,3,6,7,0,0,0,0}, {0,2,3,6,7,0,0,0}, {1,2,3,6,7,0,0,0}, {0,1,2,3,6,7,0,0},
+  {4,6,7,0,0,0,0,0}, {0,4,6,7,0,0,0,0}, {1,4,6,7,0,0,0,0}, {0,1,4,6,7,0,0,0}, {2,4,6,7,0,0,0,0}, {0,2,4,6,7,0,0,0}, {1,2,4,6,7,0,0,0}, {0,1,2,4,6,7,0,0},
+  {3,4,6,7,0,0,0,0}, {0,3,4,6,7,0,0,0}, {1,3,4,6,7,0,0,0}, {0,1,3,4,6,7,0,0}, {2,3,4,6,7,0,0,0}, {0,2,3,4,6,7,0,0}, {1,2,3,4,6,7,0,0}, {0,1,2,3,4,6,7,0},
+  {5,6,7,0,0,0,0,0}, {0,5,6,7,0,0,0,0}, {1,5,6,7,0,0,0,0}, {0,1,5,6,7,0,0,0}, {2,5,6,7,0,0,0,0}, {0,2,5,6,7,0,0,0}, {1,2,5,6,7,0,0,0}, {0,1,2,5,6,7,0,0},
+  {3,5,6,7,0,0,0,0}, {0,3,5,6,7,0,0,0}, {1,3,5,6,7,0,0,0}, {0,1,3,5,6,7,0,0}, {2,3,5,6,7,0,0,0}, {0,2,3,5,6,7,0,0}, {1,2,3,5,6,7,0,0}, {0,1,2,3,5,6,7,0},
+  {4,5,6,7,0,0,0,0}, {0,4,5,6,7,0,0,0}, {1,4,5,6,7,0,0,0}, {0,1,4,5,6,7,0,0}, {2,4,5,6,7,0,0,0}, {0,2,4,5,6,7,0,0}, {1,2,4,5,6,7,0,0}, {0,1,2,4,5,6,7,0},
+  {3,4,5,6,7,0,0,0}, {0,3,4,5,6,7,0,0}, {1,3,4,5,6,7,0,0}, {0,1,3,4,5,6,7,0}, {2,3,4,5,6,7,0,0}, {0,2,3,4,5,6,7,0}, {1,2,3,4,5,6,7,0}, {0,1,2,3,4,5,6,7}
+};
+
+__STATIC_FORCE_INLINE_F __m256i filterShuffle(__m256i x, unsigned m) {
+  return _mm256_permutevar8x32_epi32(x, _mm256_cvtepu8_epi32(_mm_loadl_epi64((const void *)filterLUT[m])));
+}
+
+/* A 4 bits mask of 64 bits lanes as an 8 bits mask of 32 bits lanes */
+    #define FILTER_DBL(M) ((((M) & 1) * 3) | (((M) & 2) * 6) | (((M) & 4) * 12) | (((M) & 8) * 24))
+#endif
+
+#if defined(FILTER_SIMD) && defined(__AVX512F__)
+__STATIC_FORCE_INLINE_F vsize_t filterCompact_u32(u32 *d, u32 *r, const u32 *s, u64 m, vsize_t n) {
+  __m512i x;
+  __mmask16 k;
+  vsize_t j, w;
+
+  if (n < FILTER_BLK)
+    return filterCompactScalar_u32(d, r, s, m, n);
+
+  for (j = w = 0; j < 4; j++) {
+    k = (__mmask16)(m >> (16*j));
+    x = _mm512_loadu_si512(s + 16*j);
+    /* Compress to a register and store it whole: a compressing store to memory is microcoded on some cores */
+    _mm512_storeu_si512(d + w, _mm512_maskz_compress_epi32(k, x));
+    if (r != NULL)
+      _mm512_storeu_si512(r + (16*j - w), _mm512_maskz_compress_epi32((__mmask16)~k, x));
+    w += POPCNT64(k);
+  }
+  return w;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t filterCompact_u64(u64 *d, u64 *r, const u64 *s, u64 m, vsize_t n) {
+  __m512i x;
+  __mmask8 k;
+  vsize_t j, w;
+
+  if (n < FILTER_BLK)
+    return filterCompactScalar_u64(d, r, s, m, n);
+
+  for (j = w = 0; j < 8; j++) {
+    k = (__mmask8)(m >> (8*j));
+    x = _mm512_loadu_si512(s + 8*j);
+    _mm512_storeu_si512(d + w, _mm512_maskz_compress_epi64(k, x));
+    if (r != NULL)
+      _mm512_storeu_si512(r + (8*j - w), _mm512_maskz_compress_epi64((__mmask8)~k, x));
+    w += POPCNT64(k);
+  }
+  return w;
+}
+
+    #ifdef __AVX512VBMI2__
+__STATIC_FORCE_INLINE_F vsize_t filterCompact_u8(u8 *d, u8 *r, const u8 *s, u64 m, vsize_t n) {
+  __m512i x;
+
+  if (n < FILTER_BLK)
+    return filterCompactScalar_u8(d, r, s, m, n);
+
+  x = _mm512_loadu_si512(s);
+  _mm512_storeu_si512(d, _mm512_maskz_compress_epi8(m, x));
+  if (r != NULL)
+    _mm512_storeu_si512(r, _mm512_maskz_compress_epi8(~m, x));
+  return POPCNT64(m);
+}
+
+__STATIC_FORCE_INLINE_F vsize_t filterCompact_u16(u16 *d, u16 *r, const u16 *s, u64 m, vsize_t n) {
+  __m512i x;
+  __mmask32 k;
+  vsize_t j, w;
+
+  if (n < FILTER_BLK)
+    return filterCompactScalar_u16(d, r, s, m, n);
+
+  for (j = w = 0; j < 2; j++) {
+    k = (__mmask32)(m >> (32*j));
+    x = _mm512_loadu_si512(s + 32*j);
+    _mm512_storeu_si512(d + w, _mm512_maskz_compress_epi16(k, x));
+    if (r != NULL)
+      _mm512_storeu_si512(r + (32*j - w), _mm512_maskz_compress_epi16(~k, x));
+    w += POPCNT64(k);
+  }
+  return w;
+}
+    #endif
+
+#elif defined(FILTER_LUT)
+__STATIC_FORCE_INLINE_F vsize_t filterCompact_u32(u32 *d, u32 *r, const u32 *s, u64 m, vsize_t n) {
+  __m256i x;
+  unsigned k;
+  vsize_t j, w;
+
+  if (n < FILTER_BLK)
+    return filterCompactScalar_u32(d, r, s, m, n);
+
+  for (j = w = 0; j < 8; j++) {
+    k = (m >> (8*j)) & 0xff;
+    x = _mm256_loadu_si256((const void *)(s + 8*j));
+    _mm256_storeu_si256((void *)(d + w), filterShuffle(x, k));
+    if (r != NULL)
+      _mm256_storeu_si256((void *)(r + (8*j - w)), filterShuffle(x, k ^ 0xff));
+    w += POPCNT64(k);
+  }
+  return w;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t filterCompact_u64(u64 *d, u64 *r, const u64 *s, u64 m, vsize_t n) {
+  __m256i x;
+  unsigned k;
+  vsize_t j, w;
+
+  if (n < FILTER_BLK)
+    return filterCompactScalar_u64(d, r, s, m, n);
+
+  for (j = w = 0; j < 16; j++) {
+    k = (m >> (4*j)) & 0xf;
+    x = _mm256_loadu_si256((const void *)(s + 4*j));
+    _mm256_storeu_si256((void *)(d + w), filterShuffle(x, FILTER_DBL(k)));
+    if (r != NULL)
+      _mm256_storeu_si256((void *)(r + (4*j - w)), filterShuffle(x, FILTER_DBL(k ^ 0xf)));
+    w += POPCNT64(k);
+  }
+  return w;
+}
+#endif
+
+#if !defined(FILTER_SIMD)
+    #define filterCompact_u32 filterCompactScalar_u32
+    #define filterCompact_u64 filterCompactScalar_u64
+#endif
+#if !defined(FILTER_SIMD) || !defined(__AVX512VBMI2__)
+    #define filterCompact_u8  filterCompactScalar_u8
+    #define filterCompact_u16 filterCompactScalar_u16
+#endif
+
+/* Other sizes (VEC_select) */
+__STATIC_FORCE_INLINE_F vsize_t filterCompactN(char *d, const char *s, u64 m, vsize_t dt) {
+  vsize_t w;
+
+  for (w = 0; m; m &= m - 1, w++)
+    memmove(d + w*dt, s + CTZ64(m)*dt, dt);
+  return w;
+}
+
+
+/***********************************************************
+
+ * DRIVER
+
+************************************************************/
+
+/* Block by block: mask of each block to mask (unless NULL), then compaction to d (unless NULL) and r */
+#define FILTER_RUN(K, T, C)						\
+  static vsize_t filterRun_##K(C *d, C *r, const C *s, vsize_t n, const filtNorm *f, u64 *mask) { \
+    vsize_t i, b, w;							\
+    u64 m;								\
+									\
+    for (i = w = 0; i < n; i += b) {					\
+      b = ((n - i) < FILTER_BLK) ? (n - i) : FILTER_BLK;		\
+      m = (b == FILTER_BLK) ? filterBlock_##K((const T *)(s + i), f) : filterScalar_##K((const T *)(s + i), b, f); \
+      m = (m ^ f->neg) & (~(u64)0 >> (FILTER_BLK - b));			\
+									\
+      if (mask != NULL)							\
+	mask[i / FILTER_BLK] = m;					\
+      if (d != NULL)							\
+	w += filterCompact_##C(d + w, r ? r + (i - w) : NULL, s + i, m, b); \
+    }									\
+    return w;								\
+  }
+
+FILTER_RUN(u8, u8, u8)
+FILTER_RUN(u16, u16, u16)
+FILTER_RUN(u32, u32, u32)
+FILTER_RUN(u64, u64, u64)
+FILTER_RUN(f32, f32, u32)
+FILTER_RUN(f64, f64, u64)
+
+static vsize_t filterRun(void *d, void *r, const void *s, vsize_t n, const VEC_pred *p, u64 *mask) {
+  filtNorm f;
+
+  filterNormalize(&f, p);
+
+  switch (p->vp_kind) {
+  case VEC_I8:
+  case VEC_U8:
+    return filterRun_u8(d, r, s, n, &f, mask);
+  case VEC_I16:
+  case VEC_U16:
+    return filterRun_u16(d, r, s, n, &f, mask);
+  case VEC_I32:
+  case VEC_U32:
+    return filterRun_u32(d, r, s, n, &f, mask);
+  case VEC_I64:
+  case VEC_U64:
+    return filterRun_u64(d, r, s, n, &f, mask);
+  case VEC_F32:
+    return filterRun_f32(d, r, s, n, &f, mask);
+  default:
+    return filterRun_f64(d, r, s, n, &f, mask);
+  }
+}
+
+/* Destination of at least cap items, emptied */
+static void *filterReserve(void *dst, vsize_t cap, vsize_t dt) {
+  if (dst == NULL)
+    return VEC_newFrmSize(cap, dt);
+
+  VEC_assert(VEC_vdtype(dst) == dt, "VEC_filter: type mismatch");
+  VEC_vusedSet(dst, 0);
+  if (VEC_vsize(dst) < cap)
+    dst = VEC_INTERNAL_resize(dst, cap);
+  return dst;
+}
+
+
+/***********************************************************
+
+ * API
+
+************************************************************/
+
+void *VEC_filter(void *dst, const void *src, const VEC_pred *p) {
+  const vsize_t n = VEC_used(src), dt = VEC_vdtype(src);
+
+  VEC_assert(VEC_kindSize(p->vp_kind) == dt, "VEC_filter: kind does not match the item size");
+
+  dst = filterReserve(dst, n + FILTER_SLACK / dt, dt);
+  VEC_vusedSet(dst, filterRun(dst, NULL, src, n, p, NULL));
+
+  return dst;
+}
+
+__NONNULL__ vsize_t VEC_partition(void *v, const VEC_pred *p) {
+  /* Matching items are compacted in v, the others to a scratch vector of n items, then copied after them */
+  const vsize_t n = VEC_used(v), dt = VEC_vdtype(v);
+  void *r;
+  vsize_t w;
+
+  VEC_assert(VEC_kindSize(p->vp_kind) == dt, "VEC_partition: kind does not match the item size");
+
+  r = VEC_newFrmSize(n + FILTER_SLACK / dt, dt);
+  w = filterRun(v, r, v, n, p, NULL);
+  mvpgMemcpy((char *)v + w*dt, r, (n - w)*dt);
+  VEC_destroy(r);
+
+  return w;
+}
+
+uint64_t *VEC_filterMask(uint64_t *mask, const void *src, const VEC_pred *p) {
+  const vsize_t n = VEC_used(src), nw = (n + FILTER_BLK - 1) / FILTER_BLK;
+
+  VEC_assert(VEC_kindSize(p->vp_kind) == VEC_vdtype(src), "VEC_filterMask: kind does not match the item size");
+
+  mask = filterReserve(mask, nw, sizeof(u64));
+  filterRun(NULL, NULL, src, n, p, mask);
+  VEC_vusedSet(mask, nw);
+
+  return mask;
+}
+
+#define FILTER_SELECT(T)						\
+  for (i = w = 0; i < n; i += b) {					\
+    b = ((n - i) < FILTER_BLK) ? (n - i) : FILTER_BLK;			\
+    w += filterCompact_##T((T *)dst + w, NULL, (const T *)src + i, mask[i / FILTER_BLK] & (~(u64)0 >> (FILTER_BLK - b)), b); \
+  }
+
+void *VEC_select(void *dst, const void *src, const uint64_t *mask) {
+  const vsize_t n = VEC_used(src), dt = VEC_vdtype(src);
+  vsize_t i, b, w;
+
+  VEC_assert(VEC_used(mask) >= (n + FILTER_BLK - 1) / FILTER_BLK, "VEC_select: mask is shorter than the vector");
+
+  dst = filterReserve(dst, n + FILTER_SLACK / dt + 1, dt);
+
+  switch (dt) {
+  case sizeof(u8):
+    FILTER_SELECT(u8);
+    break;
+  case sizeof(u16):
+    FILTER_SELECT(u16);
+    break;
+  case sizeof(u32):
+    FILTER_SELECT(u32);
+    break;
+  case sizeof(u64):
+    FILTER_SELECT(u64);
+    break;
+  default:
+    for (i = w = 0; i < n; i += b) {
+      b = ((n - i) < FILTER_BLK) ? (n - i) : FILTER_BLK;
+      w += filterCompactN((char *)dst + w*dt, (const char *)src + i*dt, mask[i / FILTER_BLK] & (~(u64)0 >> (FILTER_BLK - b)), dt);
+    }
+    break;
+  }
+  VEC_vusedSet(dst, w);
+
+  return dst;
+}
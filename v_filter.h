@@ -0,0 +1,79 @@
+/* MVPG API Vector Type: Filter
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_FILTER_H
+#define V_FILTER_H
+
+#include "v_base.h"
+
+/*                    FILTER / PARTITION (STREAM COMPACTION BY PREDICATE)
+ *
+ * VEC_filter(D, S, P):     D = items of S matching P, in order
+ * VEC_partition(V, P):     stable partition of V (through a scratch vector of its size); matching items first, returns their count
+ * VEC_filterMask(M, S, P): bit vector of S matching P (bit i of M[i / 64] is item i)
+ * VEC_select(D, S, M):     D = items of S whose bit is set in M (any dtype)
+ *
+ * A predicate compares items of kind vp_kind with vp_lo (and vp_hi for VEC_IN/VEC_OUT, an inclusive range).
+ * Bounds are converted to the item type first (integers are truncated, doubles are rounded to float for VEC_F32).
+ * Float comparisons follow C: NaN matches VEC_NE and VEC_OUT only.
+ *
+ * D and M may be NULL, in which case they are created; else they are overwritten and grown if needed. They are returned, as with VEC_INTERNAL_resize.
+ * The destination is reserved once, with a slack of one SIMD register, so that survivors are written with full-width stores.
+ * With AVX-512 (compile time), 4 and 8 bytes items are compacted with compress; with AVX2, with a shuffle table (VEC_FILTER_NOSIMD disables both).
+ */
+
+typedef enum {
+  VEC_EQ, VEC_NE, VEC_LT, VEC_LE, VEC_GT, VEC_GE, VEC_IN, VEC_OUT
+} VEC_cmp;
+
+typedef struct {
+  VEC_scalar vp_lo, vp_hi; /* Bounds (vp_hi: VEC_IN and VEC_OUT only) */
+  uint8_t    vp_cmp;       /* VEC_cmp */
+  uint8_t    vp_kind;      /* VEC_kind */
+} VEC_pred;
+
+void    *VEC_filter     (void *dst, const void *src, const VEC_pred *p);
+vsize_t  VEC_partition  (void *v, const VEC_pred *p);
+uint64_t *VEC_filterMask(uint64_t *mask, const void *src, const VEC_pred *p);
+void    *VEC_select     (void *dst, const void *src, const uint64_t *mask);
+
+/* Predicates on integers (unsigned bounds above INT64_MAX may be passed converted) and on floats */
+__STATIC_FORCE_INLINE_F VEC_pred VEC_predInt(VEC_kind k, VEC_cmp op, int64_t lo, int64_t hi) {
+  VEC_pred p;
+
+  VEC_assert(! VEC_kindFloat(k), "VEC_predInt: float kind");
+  p.vp_lo.i = lo;
+  p.vp_hi.i = hi;
+  p.vp_cmp  = op;
+  p.vp_kind = k;
+  return p;
+}
+
+__STATIC_FORCE_INLINE_F VEC_pred VEC_predFlt(VEC_kind k, VEC_cmp op, double lo, double hi) {
+  VEC_pred p;
+
+  VEC_assert(VEC_kindFloat(k), "VEC_predFlt: integer kind");
+  p.vp_lo.f = lo;
+  p.vp_hi.f = hi;
+  p.vp_cmp  = op;
+  p.vp_kind = k;
+  return p;
+}
+
+/* Set bits of a bit vector */
+__STATIC_FORCE_INLINE_F __NONNULL__ vsize_t VEC_maskCount(const uint64_t *mask) {
+  vsize_t i, c;
+
+  for (i = c = 0; i < VEC_used(mask); i++)
+    c += POPCNT64(mask[i]);
+  return c;
+}
+
+#endif /* V_FILTER_H */
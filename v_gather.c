@@ -0,0 +1,476 @@
+/* MVPG API Vector Type: Gather/Scatter
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_gather.h"
+#include <stdatomic.h>
+#if !__WINDOWS__
+    #include <unistd.h>
+#endif
+
+#if !defined(VEC_GATHER_NOSIMD) && (defined(__AVX512F__) || defined(__AVX2__))
+    #include <immintrin.h>
+    #define GATHER_SIMD 1
+#endif
+
+#define PFD VEC_GATHER_PFDIST
+
+/* Partitioned path: buckets per pass (bounded for the TLB) and default LLC size if it can't be probed */
+#define GATHER_MAXBUCKETS 1024
+#define GATHER_DEFLLC     (8ul << 20)
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+
+static vsize_t gatherLLC(void) {
+  /* Probed once; threads that race to probe store the same size, so relaxed order is enough */
+  static _Atomic vsize_t llc;
+  vsize_t c;
+  long sz;
+
+  if (VEC_GATHER_LLC)
+    return VEC_GATHER_LLC;
+
+  if (! (c = atomic_load_explicit(&llc, memory_order_relaxed))) {
+    sz = -1;
+#ifdef _SC_LEVEL3_CACHE_SIZE
+    sz = sysconf(_SC_LEVEL3_CACHE_SIZE);
+#endif
+    c = sz > 0 ? (vsize_t)sz : GATHER_DEFLLC;
+    atomic_store_explicit(&llc, c, memory_order_relaxed);
+  }
+  return c;
+}
+
+
+/***********************************************************
+
+ * SIMD (returns the count of items done; the scalar loops finish the rest)
+
+************************************************************/
+
+#ifdef GATHER_SIMD
+    #ifdef __AVX512F__
+        #define GATHER_PF16(P, X, I, RW) for (vsize_t k_ = 0; k_ < 16; k_++) PREFETCH((P) + (X)[(I) + PFD + k_], RW)
+        #define GATHER_PF8(P, X, I, RW)  for (vsize_t k_ = 0; k_ < 8; k_++) PREFETCH((P) + (X)[(I) + PFD + k_], RW)
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u32_u32(u32 *d, const u32 *s, const u32 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 16 + PFD <= n; i += 16) {
+    GATHER_PF16(s, x, i, 0);
+    _mm512_storeu_si512(d + i, _mm512_i32gather_epi32(_mm512_loadu_si512(x + i), (const void *)s, 4));
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u32_u64(u32 *d, const u32 *s, const u64 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(s, x, i, 0);
+    _mm256_storeu_si256((void *)(d + i), _mm512_i64gather_epi32(_mm512_loadu_si512(x + i), (const void *)s, 4));
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u64_u32(u64 *d, const u64 *s, const u32 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(s, x, i, 0);
+    _mm512_storeu_si512(d + i, _mm512_i32gather_epi64(_mm256_loadu_si256((const void *)(x + i)), (const void *)s, 8));
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u64_u64(u64 *d, const u64 *s, const u64 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(s, x, i, 0);
+    _mm512_storeu_si512(d + i, _mm512_i64gather_epi64(_mm512_loadu_si512(x + i), (const void *)s, 8));
+  }
+  return i;
+}
+
+/* Conflicting lanes of a scatter are written in lane order, as the scalar loop does */
+__STATIC_FORCE_INLINE_F vsize_t scatterSimd_u32_u32(u32 *d, const u32 *s, const u32 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 16 + PFD <= n; i += 16) {
+    GATHER_PF16(d, x, i, 1);
+    _mm512_i32scatter_epi32((void *)d, _mm512_loadu_si512(x + i), _mm512_loadu_si512(s + i), 4);
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t scatterSimd_u32_u64(u32 *d, const u32 *s, const u64 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(d, x, i, 1);
+    _mm512_i64scatter_epi32((void *)d, _mm512_loadu_si512(x + i), _mm256_loadu_si256((const void *)(s + i)), 4);
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t scatterSimd_u64_u32(u64 *d, const u64 *s, const u32 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(d, x, i, 1);
+    _mm512_i32scatter_epi64((void *)d, _mm256_loadu_si256((const void *)(x + i)), _mm512_loadu_si512(s + i), 8);
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t scatterSimd_u64_u64(u64 *d, const u64 *s, const u64 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(d, x, i, 1);
+    _mm512_i64scatter_epi64((void *)d, _mm512_loadu_si512(x + i), _mm512_loadu_si512(s + i), 8);
+  }
+  return i;
+}
+    #else /* AVX2: gathers only */
+        #define GATHER_PF8(P, X, I, RW)  for (vsize_t k_ = 0; k_ < 8; k_++) PREFETCH((P) + (X)[(I) + PFD + k_], RW)
+        #define GATHER_PF4(P, X, I, RW)  for (vsize_t k_ = 0; k_ < 4; k_++) PREFETCH((P) + (X)[(I) + PFD + k_], RW)
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u32_u32(u32 *d, const u32 *s, const u32 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 8 + PFD <= n; i += 8) {
+    GATHER_PF8(s, x, i, 0);
+    _mm256_storeu_si256((void *)(d + i), _mm256_i32gather_epi32((const void *)s, _mm256_loadu_si256((const void *)(x + i)), 4));
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u32_u64(u32 *d, const u32 *s, const u64 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 4 + PFD <= n; i += 4) {
+    GATHER_PF4(s, x, i, 0);
+    _mm_storeu_si128((void *)(d + i), _mm256_i64gather_epi32((const void *)s, _mm256_loadu_si256((const void *)(x + i)), 4));
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u64_u32(u64 *d, const u64 *s, const u32 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 4 + PFD <= n; i += 4) {
+    GATHER_PF4(s, x, i, 0);
+    _mm256_storeu_si256((void *)(d + i), _mm256_i32gather_epi64((const void *)s, _mm_loadu_si128((const void *)(x + i)), 8));
+  }
+  return i;
+}
+
+__STATIC_FORCE_INLINE_F vsize_t gatherSimd_u64_u64(u64 *d, const u64 *s, const u64 *x, vsize_t n) {
+  vsize_t i;
+
+  for (i = 0; i + 4 + PFD <= n; i += 4) {
+    GATHER_PF4(s, x, i, 0);
+    _mm256_storeu_si256((void *)(d + i), _mm256_i64gather_epi64((const void *)s, _mm256_loadu_si256((const void *)(x + i)), 8));
+  }
+  return i;
+}
+    #endif
+#endif
+
+#ifndef GATHER_SIMD
+    #define gatherSimd_u32_u32(...) 0
+    #define gatherSimd_u32_u64(...) 0
+    #define gatherSimd_u64_u32(...) 0
+    #define gatherSimd_u64_u64(...) 0
+#endif
+#if !defined(GATHER_SIMD) || !defined(__AVX512F__)
+    #define scatterSimd_u32_u32(...) 0
+    #define scatterSimd_u32_u64(...) 0
+    #define scatterSimd_u64_u32(...) 0
+    #define scatterSimd_u64_u64(...) 0
+#endif
+
+/* No SIMD for 1 and 2 bytes items */
+#define gatherSimd_u8_u32(...)   0
+#define gatherSimd_u8_u64(...)   0
+#define gatherSimd_u16_u32(...)  0
+#define gatherSimd_u16_u64(...)  0
+#define scatterSimd_u8_u32(...)  0
+#define scatterSimd_u8_u64(...)  0
+#define scatterSimd_u16_u32(...) 0
+#define scatterSimd_u16_u64(...) 0
+
+
+/***********************************************************
+
+ * DIRECT GATHER/SCATTER
+
+************************************************************/
+
+/* Hardware gathers/scatters take signed indices: 32 bits indices are only used if the vector (span items) has less than 2^31 items */
+#define GATHER_SIMDOK(I, SPAN) ((sizeof(I) == 8) || ((SPAN) <= INT32_MAX))
+
+#define GATHER_DEF(T, I)						\
+  static void gather_##T##_##I(T *d, const T *s, const I *x, vsize_t n, vsize_t span) { \
+    vsize_t i;								\
+									\
+    i = GATHER_SIMDOK(I, span) ? gatherSimd_##T##_##I(d, s, x, n) : 0; \
+    for (; i + PFD < n; i++) {						\
+      PREFETCH(s + x[i + PFD], 0);					\
+      d[i] = s[x[i]];							\
+    }									\
+    for (; i < n; i++)							\
+      d[i] = s[x[i]];							\
+  }									\
+									\
+  static void scatter_##T##_##I(T *d, const T *s, const I *x, vsize_t n, vsize_t span) { \
+    vsize_t i;								\
+									\
+    i = GATHER_SIMDOK(I, span) ? scatterSimd_##T##_##I(d, s, x, n) : 0; \
+    for (; i + PFD < n; i++) {						\
+      PREFETCH(d + x[i + PFD], 1);					\
+      d[x[i]] = s[i];							\
+    }									\
+    for (; i < n; i++)							\
+      d[x[i]] = s[i];							\
+  }
+
+GATHER_DEF(u8,  u32)
+GATHER_DEF(u8,  u64)
+GATHER_DEF(u16, u32)
+GATHER_DEF(u16, u64)
+GATHER_DEF(u32, u32)
+GATHER_DEF(u32, u64)
+GATHER_DEF(u64, u32)
+GATHER_DEF(u64, u64)
+
+#define GATHER_DEFN(I)							\
+  static void gatherN_##I(char *d, const char *s, const I *x, vsize_t n, vsize_t dt) { \
+    vsize_t i;								\
+									\
+    for (i = 0; i < n; i++) {						\
+      if (i + PFD < n)							\
+	PREFETCH(s + x[i + PFD] * dt, 0);				\
+      memcpy(d + i * dt, s + x[i] * dt, dt);				\
+    }									\
+  }									\
+									\
+  static void scatterN_##I(char *d, const char *s, const I *x, vsize_t n, vsize_t dt) { \
+    vsize_t i;								\
+									\
+    for (i = 0; i < n; i++) {						\
+      if (i + PFD < n)							\
+	PREFETCH(d + x[i + PFD] * dt, 1);				\
+      memcpy(d + x[i] * dt, s + i * dt, dt);				\
+    }									\
+  }
+
+GATHER_DEFN(u32)
+GATHER_DEFN(u64)
+
+#define GATHER_DISPATCH(OP, D, S, X, N, SP, DT, I)			\
+  switch (DT) {								\
+  case 1:  OP##_u8_##I (D, S, X, N, SP); break;				\
+  case 2:  OP##_u16_##I(D, S, X, N, SP); break;				\
+  case 4:  OP##_u32_##I(D, S, X, N, SP); break;				\
+  case 8:  OP##_u64_##I(D, S, X, N, SP); break;				\
+  default: OP##N_##I   (D, S, X, N, DT);				\
+  }
+
+
+/***********************************************************
+
+ * PARTITIONED GATHER/SCATTER
+
+************************************************************/
+
+/* The positions 0..n (n <= UINT32_MAX) are bucketed by (x[i] >> shift), keeping their order within a bucket.
+ * Items are then moved bucket by bucket, reading the indices through the positions.
+ */
+#define GATHER_DEFBUCKET(I)						\
+  static void bucket_##I(const I *x, vsize_t n, unsigned shift, vsize_t nb, u32 *pos) { \
+    vsize_t i, b, sum, *off;						\
+									\
+    off = VEC_new(nb, vsize_t);						\
+    for (i = 0; i < n; i++)						\
+      off[x[i] >> shift]++;						\
+    for (b = sum = 0; b < nb; b++)					\
+      sum += off[b], off[b] = sum - off[b];				\
+									\
+    for (i = 0; i < n; i++)						\
+      pos[off[x[i] >> shift]++] = i;					\
+    VEC_destroy(off);							\
+  }
+
+GATHER_DEFBUCKET(u32)
+GATHER_DEFBUCKET(u64)
+
+#define GATHER_DEFPART(T, I)						\
+  static void gatherP_##T##_##I(T *d, const T *s, const I *x, const u32 *pos, vsize_t n) { \
+    vsize_t k, p;							\
+									\
+    for (k = 0; k < n; k++) {						\
+      if (k + PFD < n)							\
+	PREFETCH(d + pos[k + PFD], 1);					\
+      p = pos[k];							\
+      d[p] = s[x[p]];							\
+    }									\
+  }									\
+									\
+  static void scatterP_##T##_##I(T *d, const T *s, const I *x, const u32 *pos, vsize_t n) { \
+    vsize_t k, p;							\
+									\
+    for (k = 0; k < n; k++) {						\
+      if (k + PFD < n)							\
+	PREFETCH(s + pos[k + PFD], 0);					\
+      p = pos[k];							\
+      d[x[p]] = s[p];							\
+    }									\
+  }
+
+GATHER_DEFPART(u8,  u32)
+GATHER_DEFPART(u8,  u64)
+GATHER_DEFPART(u16, u32)
+GATHER_DEFPART(u16, u64)
+GATHER_DEFPART(u32, u32)
+GATHER_DEFPART(u32, u64)
+GATHER_DEFPART(u64, u32)
+GATHER_DEFPART(u64, u64)
+
+#define GATHER_DEFPARTN(I)						\
+  static void gatherPN_##I(char *d, const char *s, const I *x, const u32 *pos, vsize_t n, vsize_t dt) { \
+    vsize_t k;								\
+									\
+    for (k = 0; k < n; k++)						\
+      memcpy(d + pos[k] * dt, s + x[pos[k]] * dt, dt);			\
+  }									\
+									\
+  static void scatterPN_##I(char *d, const char *s, const I *x, const u32 *pos, vsize_t n, vsize_t dt) { \
+    vsize_t k;								\
+									\
+    for (k = 0; k < n; k++)						\
+      memcpy(d + x[pos[k]] * dt, s + pos[k] * dt, dt);			\
+  }
+
+GATHER_DEFPARTN(u32)
+GATHER_DEFPARTN(u64)
+
+#define GATHER_DISPATCHP(OP, D, S, X, P, N, DT, I)			\
+  switch (DT) {								\
+  case 1:  OP##P_u8_##I (D, S, X, P, N); break;				\
+  case 2:  OP##P_u16_##I(D, S, X, P, N); break;				\
+  case 4:  OP##P_u32_##I(D, S, X, P, N); break;				\
+  case 8:  OP##P_u64_##I(D, S, X, P, N); break;				\
+  default: OP##PN_##I   (D, S, X, P, N, DT);				\
+  }
+
+__NONNULL__ static bool gatherPartitioned(void *d, const void *s, const void *idx, vsize_t span, vsize_t dt, bool scatter) {
+  /* Bucketed path, taken if the randomly accessed vector (span items) is several times the LLC and is accessed often enough;
+   * returns false if not taken.
+   */
+  const vsize_t n = VEC_used(idx), llc = gatherLLC();
+  vsize_t nb;
+  unsigned shift;
+  u32 *pos;
+
+  if (!VEC_GATHER_PARTLLC || (span * dt <= VEC_GATHER_PARTLLC * llc) || (n < span / 4) || (n > UINT32_MAX))
+    return false;
+
+  /* A bucket’s window of the vector takes half the LLC */
+  for (shift = 0; ((vsize_t)2 << shift) * dt <= llc; shift++)
+    PASS;
+  while ((nb = (span >> shift) + 1) > GATHER_MAXBUCKETS)
+    shift++;
+
+  pos = VEC_new(n, u32);
+  if (VEC_vdtype(idx) == sizeof(u32)) {
+    bucket_u32(idx, n, shift, nb, pos);
+    if (scatter) {
+      GATHER_DISPATCHP(scatter, d, s, idx, pos, n, dt, u32);
+    }
+    else {
+      GATHER_DISPATCHP(gather, d, s, idx, pos, n, dt, u32);
+    }
+  }
+  else {
+    bucket_u64(idx, n, shift, nb, pos);
+    if (scatter) {
+      GATHER_DISPATCHP(scatter, d, s, idx, pos, n, dt, u64);
+    }
+    else {
+      GATHER_DISPATCHP(gather, d, s, idx, pos, n, dt, u64);
+    }
+  }
+  VEC_destroy(pos);
+
+  return true;
+}
+
+
+/***********************************************************
+
+ * API
+
+************************************************************/
+
+void *VEC_gather(void *dst, const void *src, const void *idx) {
+  const vsize_t n = VEC_used(idx), dt = VEC_vdtype(src);
+
+  VEC_assert((VEC_vdtype(idx) == sizeof(u32)) || (VEC_vdtype(idx) == sizeof(u64)), "VEC_gather: index vector must be of uint32_t or uint64_t");
+
+  if (dst == NULL) {
+    dst = VEC_newFrmSize(n, dt);
+  }
+  else {
+    VEC_assert(VEC_vdtype(dst) == dt, "VEC_gather: type mismatch");
+    VEC_vusedSet(dst, 0);
+    if (VEC_vsize(dst) < n)
+      dst = VEC_INTERNAL_resize(dst, n);
+  }
+
+  if (! gatherPartitioned(dst, src, idx, VEC_used(src), dt, false)) {
+    if (VEC_vdtype(idx) == sizeof(u32)) {
+      GATHER_DISPATCH(gather, dst, src, idx, n, VEC_used(src), dt, u32);
+    }
+    else {
+      GATHER_DISPATCH(gather, dst, src, idx, n, VEC_used(src), dt, u64);
+    }
+  }
+  VEC_vusedSet(dst, n);
+
+  return dst;
+}
+
+void *VEC_scatter(void *dst, const void *src, const void *idx) {
+  const vsize_t n = VEC_used(idx), dt = VEC_vdtype(src);
+
+  VEC_assert((VEC_vdtype(idx) == sizeof(u32)) || (VEC_vdtype(idx) == sizeof(u64)), "VEC_scatter: index vector must be of uint32_t or uint64_t");
+  VEC_assert(n <= VEC_used(src), "VEC_scatter: more indices than items");
+
+  if (dst == NULL) {
+    dst = VEC_newFrmSize(VEC_used(src), dt);
+    VEC_vusedSet(dst, VEC_used(src));
+  }
+  VEC_assert(VEC_vdtype(dst) == dt, "VEC_scatter: type mismatch");
+
+  if (! gatherPartitioned(dst, src, idx, VEC_used(dst), dt, true)) {
+    if (VEC_vdtype(idx) == sizeof(u32)) {
+      GATHER_DISPATCH(scatter, dst, src, idx, n, VEC_used(dst), dt, u32);
+    }
+    else {
+      GATHER_DISPATCH(scatter, dst, src, idx, n, VEC_used(dst), dt, u64);
+    }
+  }
+  return dst;
+}
@@ -0,0 +1,48 @@
+/* MVPG API Vector Type: Gather/Scatter
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_GATHER_H
+#define V_GATHER_H
+
+#include "v_base.h"
+
+/*                    GATHER / SCATTER (REORDER BY INDEX VECTOR)
+ *
+ * VEC_gather(D, S, I):  D[i] = S[I[i]]   for i < VEC_used(I)
+ * VEC_scatter(D, S, I): D[I[i]] = S[i]   for i < VEC_used(I)
+ *
+ * I is a VEC_type(uint32_t) or VEC_type(uint64_t). Indices are not bound-checked.
+ * Gather: D may be NULL, in which case it is created; else it is grown if needed. D holds VEC_used(I) items on return.
+ * Scatter: D must hold every index; if NULL, it is created with VEC_used(S) items (I is a permutation).
+ * Returns D, which may have moved, as with VEC_INTERNAL_resize.
+ *
+ * Element sizes 1, 2, 4 and 8 are specialized; others are copied with memcpy.
+ * With AVX2/AVX-512 (compile time), 4 and 8 bytes items are gathered with hardware gathers (scatters: AVX-512 only).
+ * Define VEC_GATHER_NOSIMD to use the scalar loops.
+ *
+ * Each loop prefetches VEC_GATHER_PFDIST items ahead. When the randomly accessed vector spans more than VEC_GATHER_PARTLLC times
+ * the last-level cache (VEC_GATHER_LLC bytes, or probed if 0), the indices are first radix-bucketed by their high bits,
+ * so that each bucket accesses a cache-sized window of the vector. The bucketed path costs 4 bytes per index; VEC_GATHER_PARTLLC 0 disables it.
+ */
+
+#ifndef VEC_GATHER_PFDIST
+    #define VEC_GATHER_PFDIST 16
+#endif
+#ifndef VEC_GATHER_LLC
+    #define VEC_GATHER_LLC 0
+#endif
+#ifndef VEC_GATHER_PARTLLC
+    #define VEC_GATHER_PARTLLC 4
+#endif
+
+void *VEC_gather  (void *dst, const void *src, const void *idx);
+void *VEC_scatter (void *dst, const void *src, const void *idx);
+
+#endif /* V_GATHER_H */
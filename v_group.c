@@ -0,0 +1,422 @@
+/* MVPG API Vector Type: Unique/Group By
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_group.h"
+
+#define GROUP_SEED          0x9e3779b97f4a7c15ull
+#define GROUP_MINTABLE      16
+#define GROUP_MAXPARTITIONS 1024
+
+typedef uint64_t u64;
+
+/* Groups of a table (or partition): first occurrence and aggregate of each, in order of first occurrence */
+typedef struct {
+  VEC_type(vsize_t)    first;
+  VEC_type(VEC_scalar) agg; /* NULL for VEC_unique */
+} grpList;
+
+typedef struct {
+  const char *keys, *vals;
+  vsize_t     n, dt;
+  VEC_kind    vk;
+  VEC_agg     agg;
+  bool        aggregate, values; /* values: the aggregate reads vals */
+
+  /* Partitioned */
+  unsigned    shift;    /* Partition of a key: hash >> shift */
+  size_t      np, nt;   /* Partitions, threads */
+  vsize_t     chunk;    /* Keys per thread while partitioning */
+  vsize_t    *hist;     /* [nt][np] counts, then write offsets */
+  vsize_t    *pstart;   /* [np + 1] first position of each partition */
+  u64        *pkey;     /* Key bits, by partition */
+  vsize_t    *pidx;     /* Key index, by partition */
+  VEC_scalar *pval;     /* Value (if values), by partition */
+  uint8_t    *isfirst;  /* First occurrence flags */
+  grpList    *lists;    /* [np] */
+  int         phase;
+} grpJob;
+
+/* Hash of key bits (fmix64) */
+__STATIC_FORCE_INLINE_F u64 grpMix(u64 x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdull;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ull;
+  return x ^ (x >> 33);
+}
+
+/* Key bits (keys up to 8 bytes) or hash (longer keys) */
+__STATIC_FORCE_INLINE_F u64 grpKey(const char *k, vsize_t dt) {
+  u64 x;
+
+  if (dt > sizeof(x))
+    return MvpgInclude_Hash64(k, dt, GROUP_SEED);
+
+  x = 0;
+  memcpy(&x, k, dt);
+  return x;
+}
+
+/* Value i, widened */
+__STATIC_FORCE_INLINE_F VEC_scalar grpValue(const grpJob *j, vsize_t i) {
+  VEC_scalar x;
+
+  switch (j->vk) {
+  case VEC_I8:  x.i = ((const int8_t *)j->vals)[i];   break;
+  case VEC_U8:  x.u = ((const uint8_t *)j->vals)[i];  break;
+  case VEC_I16: x.i = ((const int16_t *)j->vals)[i];  break;
+  case VEC_U16: x.u = ((const uint16_t *)j->vals)[i]; break;
+  case VEC_I32: x.i = ((const int32_t *)j->vals)[i];  break;
+  case VEC_U32: x.u = ((const uint32_t *)j->vals)[i]; break;
+  case VEC_I64: x.i = ((const int64_t *)j->vals)[i];  break;
+  case VEC_U64: x.u = ((const uint64_t *)j->vals)[i]; break;
+  case VEC_F32: x.f = ((const float *)j->vals)[i];    break;
+  default:      x.f = ((const double *)j->vals)[i];   break;
+  }
+  return x;
+}
+
+__STATIC_FORCE_INLINE_F void grpAccumulate(const grpJob *j, VEC_scalar *a, VEC_scalar x) {
+  if (j->agg == VEC_AGG_COUNT) {
+    a->u++;
+    return;
+  }
+
+  if (j->agg == VEC_AGG_SUM) {
+    if (VEC_kindFloat(j->vk))
+      a->f += x.f;
+    else
+      a->u += x.u;
+  }
+  else if (VEC_kindFloat(j->vk)) {
+    if ((j->agg == VEC_AGG_MIN) ? (x.f < a->f) : (x.f > a->f))
+      a->f = x.f;
+  }
+  else if (VEC_kindSigned(j->vk)) {
+    if ((j->agg == VEC_AGG_MIN) ? (x.i < a->i) : (x.i > a->i))
+      a->i = x.i;
+  }
+  else if ((j->agg == VEC_AGG_MIN) ? (x.u < a->u) : (x.u > a->u)) {
+    a->u = x.u;
+  }
+}
+
+
+/***********************************************************
+
+ * TABLE
+
+************************************************************/
+
+typedef struct {
+  VEC_type(u64)     sk; /* Key bits or hash */
+  VEC_type(vsize_t) sg; /* Group + 1, 0 for an empty slot (blocks are zeroed) */
+  vsize_t           mask;
+} grpTable;
+
+static void grpTableInit(grpTable *t, vsize_t cap) {
+  t->sk   = VEC_new(cap, u64);
+  t->sg   = VEC_new(cap, vsize_t);
+  t->mask = cap - 1;
+}
+
+static void grpTableGrow(grpTable *t) {
+  /* Double the table; slots are placed again by the hash of their key */
+  grpTable o = *t;
+  vsize_t i, h;
+
+  grpTableInit(t, (o.mask + 1) << 1);
+  for (i = 0; i <= o.mask; i++) {
+    if (! o.sg[i])
+      continue;
+
+    for (h = grpMix(o.sk[i]) & t->mask; t->sg[h]; h = (h + 1) & t->mask)
+      PASS;
+    t->sk[h] = o.sk[i];
+    t->sg[h] = o.sg[i];
+  }
+  VEC_destroy(o.sk);
+  VEC_destroy(o.sg);
+}
+
+static bool grpBuild(const grpJob *j, grpList *l, const vsize_t *idx, const u64 *pkey, const VEC_scalar *pval, vsize_t n, vsize_t maxg) {
+  /* Groups of n keys: key idx[r] of bits pkey[r] and value pval[r] (idx NULL: key r, read from the vectors, as are pkey and pval if NULL).
+   * The table is kept at most half full. Returns false, leaving l empty, if there are more than maxg groups (maxg 0: no limit).
+   */
+  const vsize_t dt = j->dt;
+  grpTable t;
+  VEC_scalar a, x;
+  vsize_t r, i, h, g;
+  u64 key;
+
+  grpTableInit(&t, GROUP_MINTABLE);
+  l->first = VEC_new(GROUP_MINTABLE, vsize_t);
+  l->agg   = j->aggregate ? VEC_new(GROUP_MINTABLE, VEC_scalar) : NULL;
+  x.u      = 0;
+
+  for (r = 0; r < n; r++) {
+    i   = idx ? idx[r] : r;
+    key = pkey ? pkey[r] : grpKey(j->keys + i*dt, dt);
+    if (j->values)
+      x = pval ? pval[r] : grpValue(j, i);
+
+    for (h = grpMix(key) & t.mask; (g = t.sg[h]); h = (h + 1) & t.mask) {
+      if ((t.sk[h] == key) && ((dt <= sizeof(u64)) || !memcmp(j->keys + l->first[g - 1]*dt, j->keys + i*dt, dt)))
+	break;
+    }
+
+    if (g) {
+      if (j->aggregate)
+	grpAccumulate(j, l->agg + g - 1, x);
+      continue;
+    }
+
+    t.sk[h] = key;
+    VEC_push(l->first, i);
+    t.sg[h] = VEC_used(l->first);
+
+    if (j->aggregate) {
+      a = x;
+      if (j->agg == VEC_AGG_COUNT)
+	a.u = 1;
+      VEC_push(l->agg, a);
+    }
+
+    if ((VEC_used(l->first) << 1) > t.mask) {
+      if (maxg && (VEC_used(l->first) > maxg))
+	break;
+      grpTableGrow(&t);
+    }
+  }
+  VEC_destroy(t.sk);
+  VEC_destroy(t.sg);
+
+  if (r < n) {
+    VEC_destroy(l->first);
+    VEC_destroy(l->agg);
+    return false;
+  }
+  return true;
+}
+
+
+/***********************************************************
+
+ * PARTITIONED (histogram, scatter and build phases, each split among threads)
+ * Keys are scattered with their bits and values, so that each partition is built from sequential reads.
+
+************************************************************/
+
+__STATIC_FORCE_INLINE_F size_t grpPartition(const grpJob *j, u64 key) {
+  return grpMix(key) >> j->shift;
+}
+
+static void grpPhase(void *a, size_t t) {
+  grpJob *j = a;
+  vsize_t *hist = j->hist + t*j->np;
+  const vsize_t lo = t * j->chunk, hi = (lo + j->chunk < j->n) ? lo + j->chunk : j->n;
+  vsize_t i, o, r, e;
+  size_t p;
+  u64 key;
+
+  switch (j->phase) {
+  case 0:
+    for (i = lo; i < hi; i++)
+      hist[grpPartition(j, grpKey(j->keys + i*j->dt, j->dt))]++;
+    break;
+  case 1:
+    /* Keys stay in index order within a partition, as thread t writes after threads < t */
+    for (i = lo; i < hi; i++) {
+      key = grpKey(j->keys + i*j->dt, j->dt);
+      o   = hist[grpPartition(j, key)]++;
+
+      j->pkey[o] = key;
+      j->pidx[o] = i;
+      if (j->values)
+	j->pval[o] = grpValue(j, i);
+    }
+    break;
+  default:
+    for (p = t; p < j->np; p += j->nt) {
+      o = j->pstart[p];
+      grpBuild(j, j->lists + p, j->pidx + o, j->pkey + o, j->values ? j->pval + o : NULL, j->pstart[p + 1] - o, 0);
+      for (r = 0, e = VEC_used(j->lists[p].first); r < e; r++)
+	j->isfirst[j->lists[p].first[r]] = 1;
+    }
+    break;
+  }
+}
+
+static void grpPartitioned(grpJob *j) {
+  vsize_t off, c;
+  size_t p, t, max, bits;
+
+  for (bits = 1; (((vsize_t)1 << bits) < (j->n / VEC_GROUP_PARTITEMS)) && (((size_t)1 << bits) < GROUP_MAXPARTITIONS); bits++)
+    PASS;
+  max = VEC_GROUP_THREADS ? VEC_GROUP_THREADS : MvpgInclude_Ncpu();
+  max = (max < MVPG_MAXTHREADS) ? max : MVPG_MAXTHREADS;
+
+  j->np    = (size_t)1 << bits;
+  j->shift = 64 - bits;
+  j->nt    = (max < j->np) ? max : j->np;
+  j->chunk = (j->n + j->nt - 1) / j->nt;
+
+  j->hist    = calloc(j->nt * j->np, sizeof(vsize_t));
+  j->pstart  = malloc((j->np + 1) * sizeof(vsize_t));
+  j->pkey    = malloc(j->n * sizeof(u64));
+  j->pidx    = malloc(j->n * sizeof(vsize_t));
+  j->pval    = j->values ? malloc(j->n * sizeof(VEC_scalar)) : NULL;
+  j->isfirst = calloc(j->n, 1);
+  j->lists   = malloc(j->np * sizeof(grpList));
+  VEC_assert(j->hist && j->pstart && j->pkey && j->pidx && (j->pval || !j->values) && j->isfirst && j->lists, "VEC_groupby: out of memory");
+
+  j->phase = 0;
+  MvpgInclude_Parallel(grpPhase, j, j->nt);
+
+  for (p = off = 0; p < j->np; p++) {
+    j->pstart[p] = off;
+    for (t = 0; t < j->nt; t++) {
+      c = j->hist[t*j->np + p];
+      j->hist[t*j->np + p] = off;
+      off += c;
+    }
+  }
+  j->pstart[j->np] = off;
+
+  j->phase = 1;
+  MvpgInclude_Parallel(grpPhase, j, j->nt);
+  j->phase = 2;
+  MvpgInclude_Parallel(grpPhase, j, j->nt);
+}
+
+static void grpPartitionedFree(grpJob *j) {
+  size_t p;
+
+  for (p = 0; p < j->np; p++) {
+    VEC_destroy(j->lists[p].first);
+    VEC_destroy(j->lists[p].agg);
+  }
+  free(j->hist);
+  free(j->pstart);
+  free(j->pkey);
+  free(j->pidx);
+  free(j->pval);
+  free(j->isfirst);
+  free(j->lists);
+}
+
+
+/***********************************************************
+
+ * API
+
+************************************************************/
+
+/* Output vector of at least cap items, emptied */
+static void *grpReserve(void *v, vsize_t cap, vsize_t dt) {
+  if (v == NULL)
+    return VEC_newFrmSize(cap | !cap, dt);
+
+  VEC_assert(VEC_vdtype(v) == dt, "VEC_groupby: type mismatch");
+  VEC_vusedSet(v, 0);
+  if (VEC_vsize(v) < cap)
+    v = VEC_INTERNAL_resize(v, cap);
+  return v;
+}
+
+static vsize_t grpRun(void **gkeys, VEC_scalar **gagg, grpJob *j) {
+  /* Groups to *gkeys (and *gagg), in order of first occurrence. One table is tried first; past VEC_GROUP_PARTMIN groups
+   * it would fall out of cache, so the keys are partitioned instead.
+   */
+  grpList l;
+  vsize_t *cur, i, g, ng;
+  size_t p;
+
+  j->values = j->aggregate && (j->agg != VEC_AGG_COUNT);
+
+  if (grpBuild(j, &l, NULL, NULL, NULL, j->n, (j->n > VEC_GROUP_PARTMIN) ? VEC_GROUP_PARTMIN : 0)) {
+    ng     = VEC_used(l.first);
+    *gkeys = grpReserve(*gkeys, ng, j->dt);
+    for (g = 0; g < ng; g++)
+      memcpy((char *)*gkeys + g*j->dt, j->keys + l.first[g]*j->dt, j->dt);
+    VEC_vusedSet(*gkeys, ng);
+
+    if (j->aggregate) {
+      *gagg = grpReserve(*gagg, ng, sizeof(VEC_scalar));
+      memcpy(*gagg, l.agg, ng * sizeof(VEC_scalar));
+      VEC_vusedSet(*gagg, ng);
+    }
+    VEC_destroy(l.first);
+    VEC_destroy(l.agg);
+    return ng;
+  }
+
+  grpPartitioned(j);
+
+  for (p = ng = 0; p < j->np; p++)
+    ng += VEC_used(j->lists[p].first);
+  *gkeys = grpReserve(*gkeys, ng, j->dt);
+  if (j->aggregate)
+    *gagg = grpReserve(*gagg, ng, sizeof(VEC_scalar));
+
+  /* Merge: each partition lists its groups in order of first occurrence, so the next group of key i's partition is key i's */
+  cur = calloc(j->np, sizeof(vsize_t));
+  VEC_assert(cur != NULL, "VEC_groupby: out of memory");
+
+  for (i = g = 0; i < j->n; i++) {
+    if (! j->isfirst[i])
+      continue;
+
+    memcpy((char *)*gkeys + g*j->dt, j->keys + i*j->dt, j->dt);
+    if (j->aggregate) {
+      p = grpPartition(j, grpKey(j->keys + i*j->dt, j->dt));
+      (*gagg)[g] = j->lists[p].agg[cur[p]++];
+    }
+    g++;
+  }
+  VEC_vusedSet(*gkeys, ng);
+  if (j->aggregate)
+    VEC_vusedSet(*gagg, ng);
+
+  free(cur);
+  grpPartitionedFree(j);
+  return ng;
+}
+
+void *VEC_unique(void *dst, const void *keys) {
+  grpJob j;
+
+  memset(&j, 0, sizeof(j));
+  j.keys = keys;
+  j.n    = VEC_used(keys);
+  j.dt   = VEC_vdtype(keys);
+
+  grpRun(&dst, NULL, &j);
+  return dst;
+}
+
+vsize_t VEC_groupby(void **gkeys, VEC_scalar **gagg, const void *keys, const void *vals, VEC_kind vk, VEC_agg agg) {
+  grpJob j;
+
+  VEC_assert((gkeys != NULL) && (gagg != NULL) && (keys != NULL), "VEC_groupby: NULL argument");
+  VEC_assert((agg == VEC_AGG_COUNT) || ((vals != NULL) && (VEC_used(vals) >= VEC_used(keys)) && (VEC_vdtype(vals) == VEC_kindSize(vk))),
+	     "VEC_groupby: values do not match the keys");
+
+  memset(&j, 0, sizeof(j));
+  j.keys      = keys;
+  j.vals      = vals;
+  j.n         = VEC_used(keys);
+  j.dt        = VEC_vdtype(keys);
+  j.vk        = vk;
+  j.agg       = agg;
+  j.aggregate = true;
+
+  return grpRun(gkeys, gagg, &j);
+}
@@ -0,0 +1,48 @@
+/* MVPG API Vector Type: Unique/Group By
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_GROUP_H
+#define V_GROUP_H
+
+#include "v_base.h"
+
+/*                    UNIQUE / GROUP BY (HASHING)
+ *
+ * VEC_unique(D, K):                   D = first occurrence of each key of K, in order of first occurrence
+ * VEC_groupby(GK, GA, K, V, VK, AGG): GK = keys as above, GA[g] = aggregate of the values V of the keys equal to GK[g]; returns the count of groups
+ *
+ * Keys are compared by their bytes, whatever their dtype (so for float keys, 0.0 and -0.0 differ and equal NaNs are equal).
+ * V holds VEC_used(K) items of kind VK; it may be NULL for VEC_AGG_COUNT. Aggregates are VEC_scalar, widened from VK:
+ * member i for signed kinds, u for unsigned kinds and counts, f for floats. Integer sums wrap.
+ * D, *GK and *GA may be NULL, in which case they are created; else they are overwritten and grown if needed.
+ *
+ * Keys are hashed into an open-addressing table (linear probing, at most half full). Past VEC_GROUP_PARTMIN groups, the table would fall
+ * out of cache, so the keys are radix-partitioned by hash instead (with their values), each partition holding about VEC_GROUP_PARTITEMS keys.
+ * Partitions are then built by up to VEC_GROUP_THREADS threads (0: one per processor), and merged back in order of first occurrence.
+ */
+
+#ifndef VEC_GROUP_PARTMIN
+    #define VEC_GROUP_PARTMIN (1ul << 16)
+#endif
+#ifndef VEC_GROUP_PARTITEMS
+    #define VEC_GROUP_PARTITEMS (1ul << 14)
+#endif
+#ifndef VEC_GROUP_THREADS
+    #define VEC_GROUP_THREADS 0
+#endif
+
+typedef enum {
+  VEC_AGG_SUM, VEC_AGG_COUNT, VEC_AGG_MIN, VEC_AGG_MAX
+} VEC_agg;
+
+void    *VEC_unique  (void *dst, const void *keys);
+vsize_t  VEC_groupby (void **gkeys, VEC_scalar **gagg, const void *keys, const void *vals, VEC_kind vk, VEC_agg agg);
+
+#endif /* V_GROUP_H */
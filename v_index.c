@@ -0,0 +1,340 @@
+/* MVPG API Vector Type: Sorted Index
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_index.h"
+
+#if !defined(VEC_INDEX_NOSIMD) && defined(__AVX2__)
+    #include <immintrin.h>
+    #define INDEX_SIMD 1
+#endif
+
+/* Bytes per node (a cache line) */
+#define INDEX_NODE 64
+
+/* Keys per node, for keys of W bits */
+#define INDEX_B(W) (INDEX_NODE * 8 / (W))
+
+typedef int8_t  i8;
+typedef int16_t i16;
+typedef int32_t i32;
+typedef int64_t i64;
+
+
+/***********************************************************
+
+ * KEYS (order preserving signed integers)
+
+************************************************************/
+
+static i64 idxNorm(VEC_kind k, const void *p) {
+  union { i8 i8; i16 i16; i32 i32; i64 i64; } v;
+
+  memcpy(&v, p, VEC_kindSize(k));
+  switch (k) {
+  case VEC_I8:  return v.i8;
+  case VEC_U8:  return (i8)(v.i8 ^ INT8_MIN);
+  case VEC_I16: return v.i16;
+  case VEC_U16: return (i16)(v.i16 ^ INT16_MIN);
+  case VEC_I32: return v.i32;
+  case VEC_U32: return v.i32 ^ INT32_MIN;
+  case VEC_I64: return v.i64;
+  case VEC_U64: return v.i64 ^ INT64_MIN;
+  case VEC_F32:
+    /* -0 is 0; negative floats order reversed by their magnitude bits */
+    v.i32 = (v.i32 == INT32_MIN) ? 0 : v.i32;
+    return (v.i32 < 0) ? v.i32 ^ INT32_MAX : v.i32;
+  case VEC_F64:
+    v.i64 = (v.i64 == INT64_MIN) ? 0 : v.i64;
+    return (v.i64 < 0) ? v.i64 ^ INT64_MAX : v.i64;
+  default: break; /* VEC_indexBuild rejects it */
+  }
+  return 0;
+}
+
+static i64 idxNormScalar(VEC_kind k, VEC_scalar x) {
+  union { int8_t i8; uint8_t u8; int16_t i16; uint16_t u16; int32_t i32; uint32_t u32; int64_t i64; uint64_t u64; float f32; double f64; } v;
+
+  switch (k) {
+  case VEC_I8:  v.i8  = (int8_t)x.i;   break;
+  case VEC_U8:  v.u8  = (uint8_t)x.u;  break;
+  case VEC_I16: v.i16 = (int16_t)x.i;  break;
+  case VEC_U16: v.u16 = (uint16_t)x.u; break;
+  case VEC_I32: v.i32 = (int32_t)x.i;  break;
+  case VEC_U32: v.u32 = (uint32_t)x.u; break;
+  case VEC_I64: v.i64 = x.i;           break;
+  case VEC_U64: v.u64 = x.u;           break;
+  case VEC_F32: v.f32 = (float)x.f;    break;
+  default:      v.f64 = x.f;
+  }
+  return idxNorm(k, &v);
+}
+
+static void idxStore(char *p, unsigned w, i64 v) {
+  switch (w) {
+  case 1:  *(i8 *)p  = (i8)v;  break;
+  case 2:  *(i16 *)p = (i16)v; break;
+  case 4:  *(i32 *)p = (i32)v; break;
+  default: *(i64 *)p = v;
+  }
+}
+
+
+/***********************************************************
+
+ * BUILD
+
+************************************************************/
+
+typedef struct {
+  const char *s;
+  char       *t;
+  vsize_t    *pos;
+  vsize_t     n, nb, i;
+  unsigned    b, w;
+  VEC_kind    k;
+  i64         prev, pad;
+} idxBuilder;
+
+static void idxFill(idxBuilder *b, vsize_t k) {
+  /* In order: child j, then key j of node k, so that keys are laid in sorted order */
+  vsize_t slot;
+  unsigned j;
+  i64 v;
+
+  if (k >= b->nb)
+    return;
+
+  for (j = 0; j < b->b; j++) {
+    idxFill(b, k * (b->b + 1) + j + 1);
+    slot = k * b->b + j;
+    if (b->i < b->n) {
+      v = idxNorm(b->k, b->s + b->i * b->w);
+      VEC_assert(v >= b->prev, "VEC_indexBuild: vector not sorted");
+      b->prev = v;
+      idxStore(b->t + slot * b->w, b->w, v);
+      b->pos[slot] = b->i++;
+    }
+    else {
+      idxStore(b->t + slot * b->w, b->w, b->pad);
+      b->pos[slot] = b->n;
+    }
+  }
+  idxFill(b, k * (b->b + 1) + b->b + 1);
+}
+
+VEC_index VEC_indexBuild(const void *sorted, VEC_kind k) {
+  const unsigned w = VEC_kindSize(k), bk = INDEX_NODE / w;
+  VEC_index ix;
+  idxBuilder b;
+  vsize_t slots;
+
+  VEC_assert(VEC_kindValid(k), "VEC_indexBuild: unknown kind");
+  VEC_assert(VEC_vdtype(sorted) == w, "VEC_indexBuild: dtype does not match kind");
+
+  ix.ix_n      = VEC_vused(sorted);
+  ix.ix_blocks = (ix.ix_n + bk - 1) / bk;
+  ix.ix_kind   = k;
+  ix.ix_width  = w;
+
+  /* One spare node to align the first to a cache line */
+  slots = ix.ix_blocks * bk;
+  ix.ix_tree  = VEC_newFrmSize(slots + bk, w);
+  ix.ix_nodes = (char *)(((uintptr_t)ix.ix_tree + INDEX_NODE - 1) & ~(uintptr_t)(INDEX_NODE - 1));
+  ix.ix_pos   = VEC_new(slots | !slots, vsize_t);
+  VEC_vusedSet(ix.ix_tree, slots + bk);
+  VEC_vusedSet(ix.ix_pos, slots);
+
+  b.s    = sorted;
+  b.t    = ix.ix_nodes;
+  b.pos  = ix.ix_pos;
+  b.n    = ix.ix_n;
+  b.nb   = ix.ix_blocks;
+  b.i    = 0;
+  b.b    = bk;
+  b.w    = w;
+  b.k    = k;
+  b.prev = INT64_MIN;
+  b.pad  = (i64)((1ull << (8 * w - 1)) - 1);
+  idxFill(&b, 0);
+
+  return ix;
+}
+
+void VEC_indexDestroy(VEC_index *ix) {
+  VEC_destroy(ix->ix_tree);
+  VEC_destroy(ix->ix_pos);
+  ix->ix_nodes = NULL;
+}
+
+
+/***********************************************************
+
+ * SEARCH
+
+************************************************************/
+
+/* Rank of x in node p (B keys, ascending): count of keys < x, or <= x if upper */
+#ifdef INDEX_SIMD
+#define INDEX_SET1_8(x)  _mm256_set1_epi8(x)
+#define INDEX_SET1_16(x) _mm256_set1_epi16(x)
+#define INDEX_SET1_32(x) _mm256_set1_epi32(x)
+#define INDEX_SET1_64(x) _mm256_set1_epi64x(x)
+
+/* movemask yields W / 8 bits per key */
+#define INDEX_RANK(W)							\
+  __STATIC_FORCE_INLINE_F unsigned idxRank##W(const i##W *p, i##W x, bool upper) { \
+    const __m256i X = INDEX_SET1_##W(x);				\
+    const __m256i a = _mm256_load_si256((const __m256i *)(const void *)p); \
+    const __m256i b = _mm256_load_si256((const __m256i *)(const void *)p + 1); \
+    uint32_t ma, mb;							\
+									\
+    if (upper) {							\
+      ma = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi##W(a, X));	\
+      mb = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi##W(b, X));	\
+      return INDEX_B(W) - (POPCNT64(ma) + POPCNT64(mb)) / (W / 8);	\
+    }									\
+    ma = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi##W(X, a));	\
+    mb = (uint32_t)_mm256_movemask_epi8(_mm256_cmpgt_epi##W(X, b));	\
+    return (POPCNT64(ma) + POPCNT64(mb)) / (W / 8);			\
+  }
+#else
+#define INDEX_RANK(W)							\
+  __STATIC_FORCE_INLINE_F unsigned idxRank##W(const i##W *p, i##W x, bool upper) { \
+    unsigned i, c;							\
+									\
+    if (upper)								\
+      for (c = i = 0; i < INDEX_B(W); i++)				\
+	c += p[i] <= x;							\
+    else								\
+      for (c = i = 0; i < INDEX_B(W); i++)				\
+	c += p[i] < x;							\
+    return c;								\
+  }
+#endif
+
+/* Slot of the first key >= x (> x if upper), along the path of x; VSIZE_MAX if none */
+#define INDEX_SEARCH(W)							\
+  static vsize_t idxSearch##W(const VEC_index *ix, i##W x, bool upper) { \
+    const i##W *t = (const i##W *)(const void *)ix->ix_nodes;		\
+    vsize_t k, r;							\
+    unsigned i;								\
+									\
+    for (k = 0, r = VSIZE_MAX; k < ix->ix_blocks; k = k * (INDEX_B(W) + 1) + i + 1) { \
+      i = idxRank##W(t + k * INDEX_B(W), x, upper);			\
+      if (i < INDEX_B(W))						\
+	r = k * INDEX_B(W) + i;						\
+    }									\
+    return r;								\
+  }									\
+									\
+  /* Queries walk down together, each prefetching its next node */	\
+  static void idxBatch##W(const VEC_index *ix, const i##W *q, vsize_t *d, vsize_t n, bool upper) { \
+    const i##W *t = (const i##W *)(const void *)ix->ix_nodes;		\
+    vsize_t k[VEC_INDEX_BATCH], r[VEC_INDEX_BATCH];			\
+    vsize_t j, m, e;							\
+    unsigned i;								\
+    bool active;							\
+									\
+    for (j = 0; j < n; j += m) {					\
+      m = (n - j < VEC_INDEX_BATCH) ? n - j : VEC_INDEX_BATCH;		\
+      for (e = 0; e < m; e++)						\
+	k[e] = 0, r[e] = VSIZE_MAX;					\
+									\
+      do {								\
+	for (active = false, e = 0; e < m; e++) {			\
+	  if (k[e] >= ix->ix_blocks)					\
+	    continue;							\
+	  i = idxRank##W(t + k[e] * INDEX_B(W), q[j + e], upper);	\
+	  if (i < INDEX_B(W))						\
+	    r[e] = k[e] * INDEX_B(W) + i;				\
+	  k[e] = k[e] * (INDEX_B(W) + 1) + i + 1;			\
+	  if (k[e] < ix->ix_blocks)					\
+	    PREFETCH(t + k[e] * INDEX_B(W), 0), active = true;		\
+	}								\
+      } while (active);							\
+									\
+      for (e = 0; e < m; e++)						\
+	d[j + e] = (r[e] == VSIZE_MAX) ? ix->ix_n : ix->ix_pos[r[e]];	\
+    }									\
+  }
+
+INDEX_RANK(8)
+INDEX_RANK(16)
+INDEX_RANK(32)
+INDEX_RANK(64)
+
+INDEX_SEARCH(8)
+INDEX_SEARCH(16)
+INDEX_SEARCH(32)
+INDEX_SEARCH(64)
+
+static vsize_t idxFind(const VEC_index *ix, VEC_scalar x, bool upper) {
+  const i64 v = idxNormScalar(ix->ix_kind, x);
+  vsize_t r;
+
+  switch (ix->ix_width) {
+  case 1:  r = idxSearch8(ix, (i8)v, upper);   break;
+  case 2:  r = idxSearch16(ix, (i16)v, upper); break;
+  case 4:  r = idxSearch32(ix, (i32)v, upper); break;
+  default: r = idxSearch64(ix, v, upper);
+  }
+  return (r == VSIZE_MAX) ? ix->ix_n : ix->ix_pos[r];
+}
+
+vsize_t VEC_indexLower(const VEC_index *ix, VEC_scalar x) {
+  return idxFind(ix, x, false);
+}
+
+vsize_t VEC_indexUpper(const VEC_index *ix, VEC_scalar x) {
+  return idxFind(ix, x, true);
+}
+
+vsize_t VEC_indexRange(const VEC_index *ix, VEC_scalar lo, VEC_scalar hi, vsize_t *first) {
+  const vsize_t l = idxFind(ix, lo, false), h = idxFind(ix, hi, true);
+
+  if (first != NULL)
+    *first = l;
+  return (h > l) ? h - l : 0;
+}
+
+void *VEC_indexBatch(void *dst, const VEC_index *ix, const void *q, bool upper) {
+  /* Queries are normalized by blocks into a buffer of the key width, then looked up */
+  const vsize_t n = VEC_vused(q), w = ix->ix_width;
+  i64 buf[VEC_INDEX_BATCH * 8];
+  vsize_t i, j, m;
+  char *b = (char *)buf;
+
+  VEC_assert(VEC_vdtype(q) == w, "VEC_indexBatch: dtype does not match the index");
+
+  if (dst == NULL)
+    dst = VEC_new(n | !n, vsize_t);
+  else {
+    VEC_assert(VEC_vdtype(dst) == sizeof(vsize_t), "VEC_indexBatch: type mismatch");
+    VEC_vusedSet(dst, 0);
+    if (VEC_vsize(dst) < n)
+      dst = VEC_INTERNAL_resize(dst, n);
+  }
+
+  for (i = 0; i < n; i += m) {
+    m = (n - i < VEC_INDEX_BATCH * 8) ? n - i : VEC_INDEX_BATCH * 8;
+    for (j = 0; j < m; j++)
+      idxStore(b + j * w, w, idxNorm(ix->ix_kind, (const char *)q + (i + j) * w));
+
+    switch (w) {
+    case 1:  idxBatch8(ix, (const i8 *)buf, (vsize_t *)dst + i, m, upper);   break;
+    case 2:  idxBatch16(ix, (const i16 *)buf, (vsize_t *)dst + i, m, upper); break;
+    case 4:  idxBatch32(ix, (const i32 *)buf, (vsize_t *)dst + i, m, upper); break;
+    default: idxBatch64(ix, (const i64 *)buf, (vsize_t *)dst + i, m, upper);
+    }
+  }
+  VEC_vusedSet(dst, n);
+
+  return dst;
+}
@@ -0,0 +1,55 @@
+/* MVPG API Vector Type: Sorted Index
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_INDEX_H
+#define V_INDEX_H
+
+#include "v_base.h"
+
+/*                    SORTED INDEX (STATIC B-TREE)
+ *
+ * VEC_indexBuild(S, K):        index of the sorted (ascending, NaN free) vector S of kind K. S is copied; it may be freed after.
+ * VEC_indexLower(IX, X):       first position of S holding a key >= X (VEC_used(S) if none), as std::lower_bound
+ * VEC_indexUpper(IX, X):       first position of S holding a key > X, as std::upper_bound
+ * VEC_indexRange(IX, L, H, F): count of the keys in [L, H]; *F (if not NULL) = VEC_indexLower(IX, L)
+ * VEC_indexBatch(D, IX, Q, U): D[i] = VEC_indexLower (VEC_indexUpper if U) of the key Q[i], for the vector Q of kind K.
+ *                              D is a vector of vsize_t; it may be NULL, in which case it is created, else it is overwritten and grown if needed.
+ * VEC_indexDestroy(IX)
+ *
+ * X, L and H are VEC_scalar of the kind of the index (member i for signed kinds, u for unsigned kinds, f for floats), converted to the kind.
+ *
+ * The keys are laid out in an implicit B-tree (S-tree) of one cache line per node, in a 64 bytes aligned VEC vector: node k holds
+ * B = 64 / sizeof(key) keys, and its children are the nodes k * (B + 1) + 1 ... k * (B + 1) + B + 1. A lookup thus reads one line per level
+ * (log_(B+1)(n) levels, against log2(n) scattered reads for a binary search). Keys are stored as order preserving signed integers (unsigned
+ * keys with their sign bit flipped, floats by their bits, negative ones with the other bits flipped), so that nodes of every kind are
+ * ranked by the same signed comparisons, 32 bytes at a time with AVX2 (VEC_INDEX_NOSIMD disables it).
+ * Batched lookups walk VEC_INDEX_BATCH queries down the tree together, prefetching the next node of each, so that their cache misses overlap.
+ */
+
+#ifndef VEC_INDEX_BATCH
+    #define VEC_INDEX_BATCH 16
+#endif
+
+typedef struct {
+  void    *ix_tree;   /* VEC vector holding the nodes */
+  char    *ix_nodes;  /* First node, 64 bytes aligned, in ix_tree */
+  vsize_t *ix_pos;    /* VEC vector: position in the sorted vector of the key of each node slot (n for padding) */
+  vsize_t  ix_n, ix_blocks;
+  uint8_t  ix_kind, ix_width;
+} VEC_index;
+
+VEC_index  VEC_indexBuild   (const void *sorted, VEC_kind k);
+vsize_t    VEC_indexLower   (const VEC_index *ix, VEC_scalar x);
+vsize_t    VEC_indexUpper   (const VEC_index *ix, VEC_scalar x);
+vsize_t    VEC_indexRange   (const VEC_index *ix, VEC_scalar lo, VEC_scalar hi, vsize_t *first);
+void      *VEC_indexBatch   (void *dst, const VEC_index *ix, const void *q, bool upper);
+void       VEC_indexDestroy (VEC_index *ix);
+
+#endif /* V_INDEX_H */
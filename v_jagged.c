@@ -0,0 +1,164 @@
+/* MVPG API Vector Type: Jagged Array
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_jagged.h"
+
+
+/***********************************************************
+
+ * BUILD
+
+************************************************************/
+
+VEC_jagged VEC_jaggedNew(vsize_t dtype, vsize_t rows, vsize_t items) {
+  VEC_jagged j;
+
+  j.jg_values  = VEC_newFrmSize(items, dtype);
+  j.jg_offsets = VEC_new(rows + 1, vsize_t);
+  j.jg_offsets[0] = 0;
+  VEC_vusedSet(j.jg_offsets, 1);
+
+  return j;
+}
+
+void VEC_jaggedPush(VEC_jagged *j, const void *items, vsize_t n) {
+  const vsize_t dt = VEC_vdtype(j->jg_values), used = VEC_vused(j->jg_values);
+
+  if (VEC_vsize(j->jg_values) - used < n)
+    j->jg_values = VEC_INTERNAL_resize(j->jg_values, n);
+  if (VEC_vsize(j->jg_offsets) == VEC_vused(j->jg_offsets))
+    j->jg_offsets = VEC_INTERNAL_resize(j->jg_offsets, 1);
+
+  if (n)
+    mvpgMemcpy((char *)j->jg_values + used * dt, items, n * dt);
+  VEC_vusedSet(j->jg_values, used + n);
+  j->jg_offsets[VEC_vusedPostIncr(j->jg_offsets)] = used + n;
+}
+
+void VEC_jaggedDestroy(VEC_jagged *j) {
+  VEC_destroy(j->jg_values);
+  VEC_destroy(j->jg_offsets);
+}
+
+
+/***********************************************************
+
+ * NESTED FORM
+
+************************************************************/
+
+VEC_jagged VEC_jaggedFromNested(const void *nested, vsize_t dtype) {
+  /* Sizes first, so that the values are allocated once */
+  void *const *rows = (void *const *)nested;
+  const vsize_t nr = VEC_vused(nested);
+  vsize_t r, n, total;
+  VEC_jagged j;
+  char *p;
+
+  VEC_assert(VEC_vdtype(nested) == sizeof(void *), "VEC_jaggedFromNested: not a vector of pointers");
+
+  for (total = r = 0; r < nr; r++) {
+    if (rows[r] != NULL) {
+      VEC_assert(VEC_vdtype(rows[r]) == dtype, "VEC_jaggedFromNested: type mismatch");
+      total += VEC_vused(rows[r]);
+    }
+  }
+
+  j = VEC_jaggedNew(dtype, nr, total);
+  p = j.jg_values;
+  for (total = r = 0; r < nr; r++) {
+    n = (rows[r] != NULL) ? VEC_vused(rows[r]) : 0;
+    if (n)
+      mvpgMemcpy(p + total * dtype, rows[r], n * dtype);
+    j.jg_offsets[r + 1] = (total += n);
+  }
+  VEC_vusedSet(j.jg_values, total);
+  VEC_vusedSet(j.jg_offsets, nr + 1);
+
+  return j;
+}
+
+void *VEC_jaggedToNested(const VEC_jagged *j) {
+  const vsize_t nr = VEC_jaggedRows(*j), dt = VEC_vdtype(j->jg_values);
+  vsize_t r, n;
+  void **rows;
+
+  rows = VEC_new(nr, void *);
+  for (r = 0; r < nr; r++) {
+    n = VEC_jaggedLen(*j, r);
+    rows[r] = VEC_newFrmSize(n, dt);
+    mvpgMemcpy(rows[r], (const char *)j->jg_values + j->jg_offsets[r] * dt, n * dt);
+    VEC_vusedSet(rows[r], n);
+  }
+  VEC_vusedSet(rows, nr);
+
+  return rows;
+}
+
+
+/***********************************************************
+
+ * PER-ROW (PARALLEL)
+
+************************************************************/
+
+typedef struct {
+  const VEC_jagged *j;
+  VEC_jaggedFn      fn;
+  void             *arg;
+  vsize_t           first[MVPG_MAXTHREADS + 1]; /* First row of each thread */
+} jaggedJob;
+
+static void jaggedRows(void *a, size_t t) {
+  const jaggedJob *job = a;
+  const vsize_t dt = VEC_vdtype(job->j->jg_values), *off = job->j->jg_offsets;
+  char *v = job->j->jg_values;
+  vsize_t r;
+
+  for (r = job->first[t]; r < job->first[t + 1]; r++)
+    job->fn(v + off[r] * dt, off[r + 1] - off[r], r, job->arg);
+}
+
+static vsize_t jaggedLowerBound(const vsize_t *off, vsize_t n, vsize_t x) {
+  /* First row r in [0, n) whose offset is at least x */
+  vsize_t lo = 0, m;
+
+  while (n) {
+    m = n / 2;
+    if (off[lo + m] < x)
+      lo += m + 1, n -= m + 1;
+    else
+      n = m;
+  }
+  return lo;
+}
+
+void VEC_jaggedForEach(const VEC_jagged *j, VEC_jaggedFn fn, void *arg) {
+  const vsize_t nr = VEC_jaggedRows(*j), total = VEC_vused(j->jg_values);
+  jaggedJob job;
+  size_t nt, max, t;
+
+  max = VEC_JAGGED_THREADS ? VEC_JAGGED_THREADS : MvpgInclude_Ncpu();
+  max = (max < MVPG_MAXTHREADS) ? max : MVPG_MAXTHREADS;
+  nt  = (total * VEC_vdtype(j->jg_values)) / VEC_JAGGED_PARMIN;
+  nt  = nt < 1 ? 1 : (nt < max ? nt : max);
+  nt  = (nt < nr) ? nt : (nr | !nr);
+
+  /* Split at the rows starting nearest to equal shares of the items */
+  job.j   = j;
+  job.fn  = fn;
+  job.arg = arg;
+  job.first[0]  = 0;
+  job.first[nt] = nr;
+  for (t = 1; t < nt; t++)
+    job.first[t] = jaggedLowerBound(j->jg_offsets, nr, (vsize_t)((double)total * t / nt));
+
+  MvpgInclude_Parallel(jaggedRows, &job, nt);
+}
@@ -0,0 +1,62 @@
+/* MVPG API Vector Type: Jagged Array
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_JAGGED_H
+#define V_JAGGED_H
+
+#include "v_base.h"
+
+/*                    JAGGED ARRAY (COMPRESSED ROWS)
+ *
+ * A vector of vectors stored flat: jg_values holds the items of every row, row after row, and row R is
+ * jg_values[jg_offsets[R] .. jg_offsets[R + 1]). Both are VEC vectors; jg_offsets holds rows + 1 items, the first being 0.
+ * Rows are read in place (VEC_jaggedRow), so traversal does not chase a pointer per row, and the whole array is two allocations.
+ *
+ * VEC_jaggedNew(DT, R, N):          empty array of items of DT bytes, with room for R rows of N items in all
+ * VEC_jaggedPush(J, P, N):          append a row of the N items at P
+ * VEC_jaggedFromNested(V, DT):      array of the rows of V, a vector of pointers to vectors of DT bytes items (a NULL pointer is an empty row)
+ * VEC_jaggedToNested(J):            vector of pointers to new vectors, one per row (the nested form above)
+ * VEC_jaggedForEach(J, F, A):       F(row, length, index, A) for every row, by up to VEC_JAGGED_THREADS threads (0: one per processor)
+ *                                   when the array holds more than VEC_JAGGED_PARMIN bytes per thread. Threads take rows of about the same count of items.
+ * VEC_jaggedDestroy(J):             free both vectors
+ */
+
+#ifndef VEC_JAGGED_THREADS
+    #define VEC_JAGGED_THREADS 0
+#endif
+#ifndef VEC_JAGGED_PARMIN
+    #define VEC_JAGGED_PARMIN (1ul << 20)
+#endif
+
+typedef struct {
+  void    *jg_values;
+  vsize_t *jg_offsets;
+} VEC_jagged;
+
+typedef void (*VEC_jaggedFn)(void *row, vsize_t len, vsize_t r, void *arg);
+
+#define VEC_jaggedRows(J)					\
+  ( VEC_vused((J).jg_offsets) - 1 )
+
+#define VEC_jaggedLen(J, R)					\
+  ( (J).jg_offsets[(R) + 1] - (J).jg_offsets[R] )
+
+/* First item of row R, of type T */
+#define VEC_jaggedRow(J, T, R)					\
+  ( (T *)(J).jg_values + (J).jg_offsets[R] )
+
+VEC_jagged  VEC_jaggedNew        (vsize_t dtype, vsize_t rows, vsize_t items);
+void        VEC_jaggedPush       (VEC_jagged *j, const void *items, vsize_t n);
+VEC_jagged  VEC_jaggedFromNested (const void *nested, vsize_t dtype);
+void       *VEC_jaggedToNested   (const VEC_jagged *j);
+void        VEC_jaggedForEach    (const VEC_jagged *j, VEC_jaggedFn fn, void *arg);
+void        VEC_jaggedDestroy    (VEC_jagged *j);
+
+#endif /* V_JAGGED_H */
@@ -0,0 +1,470 @@
+/* MVPG API Vector Type: Matrix
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_matrix.h"
+
+#if !defined(VEC_MAT_NOSIMD) && (defined(__AVX512F__) || defined(__AVX2__))
+    #include <immintrin.h>
+    #define MAT_SIMD 1
+#endif
+
+/* Rows of the register tile of the product kernel */
+#define MAT_MR 6
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef float    f32;
+typedef double   f64;
+
+
+/***********************************************************
+
+ * ALLOCATION
+
+************************************************************/
+
+static vsize_t matStride(vsize_t n, vsize_t dt) {
+  /* Pad n items to a whole number of MVPG_ALLOC_MEMALIGN bytes, if items tile it */
+  const vsize_t a = MVPG_ALLOC_MEMALIGN / dt;
+
+  if ((MVPG_ALLOC_MEMALIGN % dt) || (a < 2))
+    return n;
+  return (n + a - 1) / a * a;
+}
+
+static void matShape(void *m, vsize_t rows, vsize_t cols, VEC_order order) {
+  const vsize_t major = (order == VEC_ROWMAJOR) ? rows : cols;
+  const vsize_t minor = (order == VEC_ROWMAJOR) ? cols : rows;
+
+  VEC_matRows(m)   = rows;
+  VEC_matCols(m)   = cols;
+  VEC_matStride(m) = matStride(minor, VEC_vdtype(m));
+  VEC_matDataType(m)->__order = order;
+  VEC_vusedSet(m, __bsafeUnsignedMull(major, VEC_matStride(m)));
+}
+
+void *VEC_matNew(vsize_t rows, vsize_t cols, vsize_t dtype, VEC_order order) {
+  const vsize_t minor = (order == VEC_ROWMAJOR) ? cols : rows;
+  const vsize_t size  = __bsafeUnsignedMull((order == VEC_ROWMAJOR) ? rows : cols, matStride(minor, dtype));
+  void *m;
+
+  VEC_assert(dtype, "VEC_matNew: null dtype");
+  /* The header keeps the items aligned (checked when compiled) */
+  MvpgMacro_Ignore(sizeof(char[(sizeof(VEC_matData_) % MVPG_ALLOC_MEMALIGN == 0) ? 1 : -1]));
+
+  m = mvpgAlloc(__bsafeUnsignedMulAddl(dtype, size, sizeof(VEC_matData_)), sizeof(VEC_matData_));
+#ifdef VEC_COMPACT_HEADER
+  /* The extended header always ends with a full vector header */
+  VEC_peektag(m)->__flags = VEC_HDR_FULL;
+#endif
+  VEC_INTERNAL_init(m, size, dtype);
+  matShape(m, rows, cols, order);
+
+  return m;
+}
+
+void *VEC_matFromVec(const void *v, vsize_t rows, vsize_t cols, VEC_order order) {
+  const vsize_t dt = VEC_vdtype(v);
+  const vsize_t major = (order == VEC_ROWMAJOR) ? rows : cols;
+  const vsize_t minor = (order == VEC_ROWMAJOR) ? cols : rows;
+  vsize_t i;
+  char *m;
+
+  VEC_assert(__bsafeUnsignedMull(rows, cols) <= VEC_vused(v), "VEC_matFromVec: vector too short");
+
+  m = VEC_matNew(rows, cols, dt, order);
+  for (i = 0; i < major; i++)
+    mvpgMemcpy(m + i * VEC_matStride(m) * dt, (const char *)v + i * minor * dt, minor * dt);
+
+  return m;
+}
+
+static void *matReserve(void *dst, vsize_t rows, vsize_t cols, vsize_t dt, VEC_order order) {
+  /* Reshape dst if it holds the new shape, else recreate it */
+  const vsize_t minor = (order == VEC_ROWMAJOR) ? cols : rows;
+
+  if (dst != NULL) {
+    VEC_assert(VEC_vdtype(dst) == dt, "VEC_mat: type mismatch");
+    if (VEC_vsize(dst) >= __bsafeUnsignedMull((order == VEC_ROWMAJOR) ? rows : cols, matStride(minor, dt))) {
+      matShape(dst, rows, cols, order);
+      return dst;
+    }
+    VEC_matDestroy(dst);
+  }
+  return VEC_matNew(rows, cols, dt, order);
+}
+
+
+/***********************************************************
+
+ * TRANSPOSE
+
+************************************************************/
+
+/* Storage transpose: item (i, j) of the r x c source (stride ls) to item (j, i) of the destination (stride ld). A column major matrix
+ * is stored as the row major matrix of its transpose, so both orders reduce to this.
+ */
+typedef struct {
+  const char *s;
+  char       *d;
+  vsize_t     ls, ld, dt;
+} matTrans;
+
+#define MAT_TILE(T)							\
+  static void matTile_##T(const matTrans *t, vsize_t i0, vsize_t i1, vsize_t j0, vsize_t j1) { \
+    const T *s = (const T *)t->s;					\
+    T *d = (T *)t->d;							\
+    vsize_t i, j;							\
+									\
+    for (j = j0; j < j1; j++)						\
+      for (i = i0; i < i1; i++)						\
+	d[j * t->ld + i] = s[i * t->ls + j];				\
+  }
+
+MAT_TILE(u8)
+MAT_TILE(u16)
+MAT_TILE(u32)
+MAT_TILE(u64)
+
+#ifdef MAT_SIMD
+__STATIC_FORCE_INLINE_F void matBlock_u32(u32 *d, vsize_t ld, const u32 *s, vsize_t ls) {
+  /* 8 x 8: pairs of rows interleaved by items, then by pairs, then by halves */
+  __m256 r0, r1, r2, r3, r4, r5, r6, r7, t0, t1, t2, t3, t4, t5, t6, t7;
+
+  r0 = _mm256_loadu_ps((const float *)(s + 0 * ls));
+  r1 = _mm256_loadu_ps((const float *)(s + 1 * ls));
+  r2 = _mm256_loadu_ps((const float *)(s + 2 * ls));
+  r3 = _mm256_loadu_ps((const float *)(s + 3 * ls));
+  r4 = _mm256_loadu_ps((const float *)(s + 4 * ls));
+  r5 = _mm256_loadu_ps((const float *)(s + 5 * ls));
+  r6 = _mm256_loadu_ps((const float *)(s + 6 * ls));
+  r7 = _mm256_loadu_ps((const float *)(s + 7 * ls));
+
+  t0 = _mm256_unpacklo_ps(r0, r1), t1 = _mm256_unpackhi_ps(r0, r1);
+  t2 = _mm256_unpacklo_ps(r2, r3), t3 = _mm256_unpackhi_ps(r2, r3);
+  t4 = _mm256_unpacklo_ps(r4, r5), t5 = _mm256_unpackhi_ps(r4, r5);
+  t6 = _mm256_unpacklo_ps(r6, r7), t7 = _mm256_unpackhi_ps(r6, r7);
+
+  r0 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(1, 0, 1, 0)), r1 = _mm256_shuffle_ps(t0, t2, _MM_SHUFFLE(3, 2, 3, 2));
+  r2 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(1, 0, 1, 0)), r3 = _mm256_shuffle_ps(t1, t3, _MM_SHUFFLE(3, 2, 3, 2));
+  r4 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(1, 0, 1, 0)), r5 = _mm256_shuffle_ps(t4, t6, _MM_SHUFFLE(3, 2, 3, 2));
+  r6 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(1, 0, 1, 0)), r7 = _mm256_shuffle_ps(t5, t7, _MM_SHUFFLE(3, 2, 3, 2));
+
+  _mm256_storeu_ps((float *)(d + 0 * ld), _mm256_permute2f128_ps(r0, r4, 0x20));
+  _mm256_storeu_ps((float *)(d + 1 * ld), _mm256_permute2f128_ps(r1, r5, 0x20));
+  _mm256_storeu_ps((float *)(d + 2 * ld), _mm256_permute2f128_ps(r2, r6, 0x20));
+  _mm256_storeu_ps((float *)(d + 3 * ld), _mm256_permute2f128_ps(r3, r7, 0x20));
+  _mm256_storeu_ps((float *)(d + 4 * ld), _mm256_permute2f128_ps(r0, r4, 0x31));
+  _mm256_storeu_ps((float *)(d + 5 * ld), _mm256_permute2f128_ps(r1, r5, 0x31));
+  _mm256_storeu_ps((float *)(d + 6 * ld), _mm256_permute2f128_ps(r2, r6, 0x31));
+  _mm256_storeu_ps((float *)(d + 7 * ld), _mm256_permute2f128_ps(r3, r7, 0x31));
+}
+
+__STATIC_FORCE_INLINE_F void matBlock_u64(u64 *d, vsize_t ld, const u64 *s, vsize_t ls) {
+  /* 4 x 4: pairs of rows interleaved by items, then by halves */
+  __m256d r0, r1, r2, r3, t0, t1, t2, t3;
+
+  r0 = _mm256_loadu_pd((const double *)(s + 0 * ls));
+  r1 = _mm256_loadu_pd((const double *)(s + 1 * ls));
+  r2 = _mm256_loadu_pd((const double *)(s + 2 * ls));
+  r3 = _mm256_loadu_pd((const double *)(s + 3 * ls));
+
+  t0 = _mm256_unpacklo_pd(r0, r1), t1 = _mm256_unpackhi_pd(r0, r1);
+  t2 = _mm256_unpacklo_pd(r2, r3), t3 = _mm256_unpackhi_pd(r2, r3);
+
+  _mm256_storeu_pd((double *)(d + 0 * ld), _mm256_permute2f128_pd(t0, t2, 0x20));
+  _mm256_storeu_pd((double *)(d + 1 * ld), _mm256_permute2f128_pd(t1, t3, 0x20));
+  _mm256_storeu_pd((double *)(d + 2 * ld), _mm256_permute2f128_pd(t0, t2, 0x31));
+  _mm256_storeu_pd((double *)(d + 3 * ld), _mm256_permute2f128_pd(t1, t3, 0x31));
+}
+
+/* Whole B x B blocks in registers, the remainder through matTile */
+#define MAT_TILESIMD(T, B)						\
+  static void matTileSimd_##T(const matTrans *t, vsize_t i0, vsize_t i1, vsize_t j0, vsize_t j1) { \
+    const T *s = (const T *)t->s;					\
+    T *d = (T *)t->d;							\
+    const vsize_t ie = i0 + (i1 - i0) / B * B, je = j0 + (j1 - j0) / B * B; \
+    vsize_t i, j;							\
+									\
+    for (i = i0; i < ie; i += B)					\
+      for (j = j0; j < je; j += B)					\
+	matBlock_##T(d + j * t->ld + i, t->ld, s + i * t->ls + j, t->ls); \
+    matTile_##T(t, i0, ie, je, j1);					\
+    matTile_##T(t, ie, i1, j0, j1);					\
+  }
+
+MAT_TILESIMD(u32, 8)
+MAT_TILESIMD(u64, 4)
+#else
+    #define matTileSimd_u32 matTile_u32
+    #define matTileSimd_u64 matTile_u64
+#endif
+
+static void matTileAny(const matTrans *t, vsize_t i0, vsize_t i1, vsize_t j0, vsize_t j1) {
+  const vsize_t dt = t->dt;
+  vsize_t i, j;
+
+  for (j = j0; j < j1; j++)
+    for (i = i0; i < i1; i++)
+      memcpy(t->d + (j * t->ld + i) * dt, t->s + (i * t->ls + j) * dt, dt);
+}
+
+static void matTransRec(const matTrans *t, vsize_t i0, vsize_t i1, vsize_t j0, vsize_t j1) {
+  vsize_t h;
+
+  /* Halve the larger side (at a multiple of 8, so that register blocks stay whole) until the tile fits in cache */
+  while ((i1 - i0 > VEC_MAT_TILE) || (j1 - j0 > VEC_MAT_TILE)) {
+    if (i1 - i0 >= j1 - j0) {
+      h = i0 + (((i1 - i0) / 2 + 7) & ~(vsize_t)7);
+      matTransRec(t, i0, h, j0, j1);
+      i0 = h;
+    }
+    else {
+      h = j0 + (((j1 - j0) / 2 + 7) & ~(vsize_t)7);
+      matTransRec(t, i0, i1, j0, h);
+      j0 = h;
+    }
+  }
+
+  switch (t->dt) {
+  case 1: matTile_u8(t, i0, i1, j0, j1); break;
+  case 2: matTile_u16(t, i0, i1, j0, j1); break;
+  case 4: matTileSimd_u32(t, i0, i1, j0, j1); break;
+  case 8: matTileSimd_u64(t, i0, i1, j0, j1); break;
+  default: matTileAny(t, i0, i1, j0, j1);
+  }
+}
+
+void *VEC_matTranspose(void *dst, const void *src) {
+  const VEC_order order = VEC_matOrder(src);
+  matTrans t;
+
+  VEC_assert(dst != src, "VEC_matTranspose: in place transpose");
+
+  dst = matReserve(dst, VEC_matCols(src), VEC_matRows(src), VEC_vdtype(src), order);
+  t.s  = src;
+  t.d  = dst;
+  t.ls = VEC_matStride(src);
+  t.ld = VEC_matStride(dst);
+  t.dt = VEC_vdtype(src);
+
+  if (order == VEC_ROWMAJOR)
+    matTransRec(&t, 0, VEC_matRows(src), 0, VEC_matCols(src));
+  else
+    matTransRec(&t, 0, VEC_matCols(src), 0, VEC_matRows(src));
+
+  return dst;
+}
+
+
+/***********************************************************
+
+ * PRODUCT
+
+************************************************************/
+
+/* Registers of the kernel: MAT_VW_T items of type T each */
+#if defined(MAT_SIMD) && defined(__AVX512F__)
+    #define MAT_VW_f32 16
+    #define MAT_VW_f64 8
+    typedef __m512  matV_f32;
+    typedef __m512d matV_f64;
+    #define matLoad_f32(P)       _mm512_loadu_ps(P)
+    #define matLoad_f64(P)       _mm512_loadu_pd(P)
+    #define matStore_f32(P, X)   _mm512_storeu_ps(P, X)
+    #define matStore_f64(P, X)   _mm512_storeu_pd(P, X)
+    #define matSet1_f32(X)       _mm512_set1_ps(X)
+    #define matSet1_f64(X)       _mm512_set1_pd(X)
+    #define matZero_f32()        _mm512_setzero_ps()
+    #define matZero_f64()        _mm512_setzero_pd()
+    #define matFma_f32(A, B, C)  _mm512_fmadd_ps(A, B, C)
+    #define matFma_f64(A, B, C)  _mm512_fmadd_pd(A, B, C)
+#elif defined(MAT_SIMD)
+    #define MAT_VW_f32 8
+    #define MAT_VW_f64 4
+    typedef __m256  matV_f32;
+    typedef __m256d matV_f64;
+    #define matLoad_f32(P)       _mm256_loadu_ps(P)
+    #define matLoad_f64(P)       _mm256_loadu_pd(P)
+    #define matStore_f32(P, X)   _mm256_storeu_ps(P, X)
+    #define matStore_f64(P, X)   _mm256_storeu_pd(P, X)
+    #define matSet1_f32(X)       _mm256_set1_ps(X)
+    #define matSet1_f64(X)       _mm256_set1_pd(X)
+    #define matZero_f32()        _mm256_setzero_ps()
+    #define matZero_f64()        _mm256_setzero_pd()
+    #ifdef __FMA__
+        #define matFma_f32(A, B, C)  _mm256_fmadd_ps(A, B, C)
+        #define matFma_f64(A, B, C)  _mm256_fmadd_pd(A, B, C)
+    #else
+        #define matFma_f32(A, B, C)  _mm256_add_ps(_mm256_mul_ps(A, B), C)
+        #define matFma_f64(A, B, C)  _mm256_add_pd(_mm256_mul_pd(A, B), C)
+    #endif
+#else
+    #define MAT_VW_f32 1
+    #define MAT_VW_f64 1
+    typedef f32 matV_f32;
+    typedef f64 matV_f64;
+    #define matLoad_f32(P)       (*(P))
+    #define matLoad_f64(P)       (*(P))
+    #define matStore_f32(P, X)   (*(P) = (X))
+    #define matStore_f64(P, X)   (*(P) = (X))
+    #define matSet1_f32(X)       (X)
+    #define matSet1_f64(X)       (X)
+    #define matZero_f32()        0
+    #define matZero_f64()        0
+    #define matFma_f32(A, B, C)  ((A) * (B) + (C))
+    #define matFma_f64(A, B, C)  ((A) * (B) + (C))
+#endif
+
+/* Columns of the register tile */
+#define MAT_NR(T) (2 * MAT_VW_##T)
+
+/* Operand view: item (i, j) is p[i * rs + j * cs] */
+#define MAT_OPERAND(T)				\
+  typedef struct {				\
+    T       *p;					\
+    vsize_t  rs, cs;				\
+  } matOp_##T;
+
+/* Row i of the register tile: c_i += a[i] * b */
+#define MAT_FMAROW(T, i)						\
+  x = matSet1_##T(a[i]);						\
+  c##i##0 = matFma_##T(x, b0, c##i##0);					\
+  c##i##1 = matFma_##T(x, b1, c##i##1);
+
+#define MAT_STOREROW(T, i)						\
+  matStore_##T(t + i * MAT_NR(T), c##i##0);				\
+  matStore_##T(t + i * MAT_NR(T) + MAT_VW_##T, c##i##1);
+
+#define MAT_GEMM(T)							\
+  MAT_OPERAND(T)							\
+									\
+  /* Rows [i, i + mc) and columns [p, p + kc) of A, by panels of MAT_MR rows stored column after column (zero padded) */ \
+  static void matPackA_##T(T *pa, const matOp_##T *a, vsize_t i, vsize_t mc, vsize_t p, vsize_t kc) { \
+    vsize_t r, q, k;							\
+									\
+    for (r = 0; r < mc; r += MAT_MR)					\
+      for (q = 0; q < kc; q++)						\
+	for (k = 0; k < MAT_MR; k++)					\
+	  *pa++ = (r + k < mc) ? a->p[(i + r + k) * a->rs + (p + q) * a->cs] : 0; \
+  }									\
+									\
+  /* Rows [p, p + kc) and columns [j, j + nc) of B, by panels of MAT_NR columns stored row after row (zero padded) */ \
+  static void matPackB_##T(T *pb, const matOp_##T *b, vsize_t p, vsize_t kc, vsize_t j, vsize_t nc) { \
+    vsize_t c, q, k;							\
+									\
+    for (c = 0; c < nc; c += MAT_NR(T))					\
+      for (q = 0; q < kc; q++)						\
+	for (k = 0; k < MAT_NR(T); k++)					\
+	  *pb++ = (c + k < nc) ? b->p[(p + q) * b->rs + (j + c + k) * b->cs] : 0; \
+  }									\
+									\
+  /* t (MAT_MR x MAT_NR) = packed panel a times packed panel b */	\
+  static void matKernel_##T(vsize_t kc, const T *a, const T *b, T *t) {	\
+    matV_##T c00, c01, c10, c11, c20, c21, c30, c31, c40, c41, c50, c51; \
+    matV_##T b0, b1, x;							\
+									\
+    c00 = c01 = c10 = c11 = c20 = c21 = matZero_##T();			\
+    c30 = c31 = c40 = c41 = c50 = c51 = matZero_##T();			\
+    for (; kc; kc--, a += MAT_MR, b += MAT_NR(T)) {			\
+      b0 = matLoad_##T(b);						\
+      b1 = matLoad_##T(b + MAT_VW_##T);					\
+      MAT_FMAROW(T, 0) MAT_FMAROW(T, 1) MAT_FMAROW(T, 2)		\
+      MAT_FMAROW(T, 3) MAT_FMAROW(T, 4) MAT_FMAROW(T, 5)		\
+    }									\
+    MAT_STOREROW(T, 0) MAT_STOREROW(T, 1) MAT_STOREROW(T, 2)		\
+    MAT_STOREROW(T, 3) MAT_STOREROW(T, 4) MAT_STOREROW(T, 5)		\
+  }									\
+									\
+  /* c (m x n) = a (m x k) b (k x n) */					\
+  static void matGemm_##T(const matOp_##T *c, const matOp_##T *a, const matOp_##T *b, vsize_t m, vsize_t n, vsize_t k) { \
+    T t[MAT_MR * MAT_NR(T)], *pa, *pb, *o;				\
+    vsize_t jc, pc, ic, jr, ir, nc, kc, mc, mr, nr, i, j;		\
+									\
+    if (! k) {								\
+      for (i = 0; i < m; i++)						\
+	for (j = 0; j < n; j++)						\
+	  c->p[i * c->rs + j * c->cs] = 0;				\
+      return;								\
+    }									\
+									\
+    pa = mvpgAlloc((VEC_MAT_MC + MAT_MR) * VEC_MAT_KC * sizeof(T), 0);	\
+    pb = mvpgAlloc((VEC_MAT_NC + MAT_NR(T)) * VEC_MAT_KC * sizeof(T), 0); \
+									\
+    for (jc = 0; jc < n; jc += nc) {					\
+      nc = (n - jc < VEC_MAT_NC) ? n - jc : VEC_MAT_NC;			\
+      for (pc = 0; pc < k; pc += kc) {					\
+	kc = (k - pc < VEC_MAT_KC) ? k - pc : VEC_MAT_KC;		\
+	matPackB_##T(pb, b, pc, kc, jc, nc);				\
+									\
+	for (ic = 0; ic < m; ic += mc) {				\
+	  mc = (m - ic < VEC_MAT_MC) ? m - ic : VEC_MAT_MC;		\
+	  matPackA_##T(pa, a, ic, mc, pc, kc);				\
+									\
+	  for (jr = 0; jr < nc; jr += MAT_NR(T)) {			\
+	    nr = (nc - jr < MAT_NR(T)) ? nc - jr : MAT_NR(T);		\
+	    for (ir = 0; ir < mc; ir += MAT_MR) {			\
+	      mr = (mc - ir < MAT_MR) ? mc - ir : MAT_MR;		\
+	      matKernel_##T(kc, pa + ir * kc, pb + jr * kc, t);		\
+									\
+	      /* The first panel of k sets c, the next ones accumulate */ \
+	      for (i = 0; i < mr; i++) {				\
+		o = c->p + (ic + ir + i) * c->rs + (jc + jr) * c->cs;	\
+		if (pc)							\
+		  for (j = 0; j < nr; j++)				\
+		    o[j * c->cs] += t[i * MAT_NR(T) + j];		\
+		else							\
+		  for (j = 0; j < nr; j++)				\
+		    o[j * c->cs] = t[i * MAT_NR(T) + j];		\
+	      }								\
+	    }								\
+	  }								\
+	}								\
+      }									\
+    }									\
+    mvpgDealloc(pa);							\
+    mvpgDealloc(pb);							\
+  }
+
+MAT_GEMM(f32)
+MAT_GEMM(f64)
+
+/* Operand of matrix m: row major items are (i, j) -> i * stride + j, column major ones (i, j) -> j * stride + i */
+#define MAT_OPOF(o, m)							\
+  ( (o).p  = (void *)(m),						\
+    (o).rs = (VEC_matOrder(m) == VEC_ROWMAJOR) ? VEC_matStride(m) : 1,	\
+    (o).cs = (VEC_matOrder(m) == VEC_ROWMAJOR) ? 1 : VEC_matStride(m) )
+
+void *VEC_matMul(void *dst, const void *a, const void *b, VEC_kind k) {
+  const vsize_t m = VEC_matRows(a), n = VEC_matCols(b), kk = VEC_matCols(a);
+
+  VEC_assert(VEC_kindFloat(k), "VEC_matMul: not a float kind");
+  VEC_assert((VEC_vdtype(a) == VEC_kindSize(k)) && (VEC_vdtype(b) == VEC_kindSize(k)), "VEC_matMul: dtype does not match kind");
+  VEC_assert(VEC_matRows(b) == kk, "VEC_matMul: shape mismatch");
+  VEC_assert((dst != a) && (dst != b), "VEC_matMul: destination is an operand");
+
+  dst = matReserve(dst, m, n, VEC_kindSize(k), VEC_matOrder(a));
+
+  if (k == VEC_F32) {
+    matOp_f32 oc, oa, ob;
+
+    MAT_OPOF(oc, dst), MAT_OPOF(oa, a), MAT_OPOF(ob, b);
+    matGemm_f32(&oc, &oa, &ob, m, n, kk);
+  }
+  else {
+    matOp_f64 oc, oa, ob;
+
+    MAT_OPOF(oc, dst), MAT_OPOF(oa, a), MAT_OPOF(ob, b);
+    matGemm_f64(&oc, &oa, &ob, m, n, kk);
+  }
+  return dst;
+}
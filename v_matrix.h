@@ -0,0 +1,122 @@
+/* MVPG API Vector Type: Matrix
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_MATRIX_H
+#define V_MATRIX_H
+
+#include "v_base.h"
+
+/*                    MATRIX (2-D VECTOR)
+ *
+ * A matrix is a VEC vector of its items, preceded by an extended header (VEC_matData_) holding its shape. Its items are stored by rows
+ * (VEC_ROWMAJOR) or by columns (VEC_COLMAJOR); consecutive rows (columns) are VEC_matStride(M) items apart, the stride being padded so that
+ * each of them starts on a MVPG_ALLOC_MEMALIGN boundary. VEC_used(M) = rows (columns) * stride.
+ * Generic VEC macros that do not reallocate apply to a matrix; it is freed with VEC_matDestroy, never with VEC_destroy, and never resized.
+ *
+ * VEC_matNew(R, C, DT, O):         new zeroed R x C matrix of items of DT bytes, in order O
+ * VEC_matFromVec(V, R, C, O):      new matrix copied from the dense (unpadded) vector V of R * C items, in order O
+ * VEC_matTranspose(D, S):          D = transpose of S, in the order of S
+ * VEC_matMul(D, A, B, K):          D = A B, for float kinds K (F32, F64); D has the order of A, A and B may differ in order
+ * VEC_matRow(M, I), VEC_matCol(M, J): view of row I (column J) of M, without copy
+ *
+ * D may be NULL, in which case it is created; else it is reshaped, or recreated if it is too small, and returned. D may not be S, A or B.
+ *
+ * Transposition recurses on the larger side of the matrix (cache oblivious) down to VEC_MAT_TILE x VEC_MAT_TILE tiles,
+ * transposed in 8 x 8 (4 x 4) blocks of registers for 4 (8) bytes items (AVX2/AVX-512 at compile time; VEC_MAT_NOSIMD disables it).
+ * The product is blocked as in GotoBLAS: VEC_MAT_KC x VEC_MAT_NC panels of B and VEC_MAT_MC x VEC_MAT_KC blocks of A are packed to
+ * contiguous buffers, then multiplied by a register tile kernel of 6 rows by 2 SIMD registers.
+ */
+
+#ifndef VEC_MAT_TILE
+    #define VEC_MAT_TILE 32
+#endif
+#ifndef VEC_MAT_MC
+    #define VEC_MAT_MC 144
+#endif
+#ifndef VEC_MAT_KC
+    #define VEC_MAT_KC 256
+#endif
+#ifndef VEC_MAT_NC
+    #define VEC_MAT_NC 4096
+#endif
+
+typedef enum {
+  VEC_ROWMAJOR, VEC_COLMAJOR
+} VEC_order;
+
+/* Extended header: the matrix shape, then the vector header (so that the VEC macros find it just before the items).
+ * Its size is a multiple of MVPG_ALLOC_MEMALIGN, so that the items keep the alignment of the block.
+ */
+typedef struct {
+  vsize_t       __rows, __cols;
+  vsize_t       __stride; /* Items between consecutive rows (VEC_ROWMAJOR) or columns (VEC_COLMAJOR) */
+  vsize_t       __order;
+  vsize_t       __rsrv;
+  VEC_metaData_ __vec;
+} VEC_matData_;
+
+/* Strided view: item I is ((T *)v_data)[I * v_step], I < v_len */
+typedef struct {
+  void    *v_data;
+  vsize_t  v_len, v_step, v_dtype;
+} VEC_view;
+
+#define VEC_matDataType(M)						\
+  ( (VEC_matData_ *)(void *)((char *)(M) - sizeof(VEC_matData_)) )
+
+#define VEC_matRows(M)   VEC_matDataType(M)->__rows
+#define VEC_matCols(M)   VEC_matDataType(M)->__cols
+#define VEC_matStride(M) VEC_matDataType(M)->__stride
+#define VEC_matOrder(M)  ((VEC_order)VEC_matDataType(M)->__order)
+
+/* Item (I, J) of M, of type T */
+#define VEC_matAt(M, T, I, J)						\
+  ( ((T *)(M))[VEC_matOrder(M) == VEC_ROWMAJOR ? (I) * VEC_matStride(M) + (J) : (J) * VEC_matStride(M) + (I)] )
+
+#define VEC_viewAt(W, T, I)			\
+  ( ((T *)(W).v_data)[(I) * (W).v_step] )
+
+#define VEC_matDestroy(M)						\
+  MvpgMacro_Ignore(M != NULL ? mvpgDealloc(VEC_matDataType(M)), (void)(M = NULL) : PASS)
+
+void *VEC_matNew       (vsize_t rows, vsize_t cols, vsize_t dtype, VEC_order order);
+void *VEC_matFromVec   (const void *v, vsize_t rows, vsize_t cols, VEC_order order);
+void *VEC_matTranspose (void *dst, const void *src);
+void *VEC_matMul       (void *dst, const void *a, const void *b, VEC_kind k);
+
+__STATIC_FORCE_INLINE_F __NONNULL__ VEC_view VEC_INTERNAL_matLine(const void *m, vsize_t i, bool row) {
+  /* Row i (row) or column i of m: along the storage order, the items of a line are contiguous */
+  const vsize_t dt = VEC_vdtype(m), stride = VEC_matStride(m);
+  VEC_view w;
+
+  w.v_dtype = dt;
+  w.v_len   = row ? VEC_matCols(m) : VEC_matRows(m);
+  if (row == (VEC_matOrder(m) == VEC_ROWMAJOR)) {
+    w.v_data = (char *)m + i * stride * dt;
+    w.v_step = 1;
+  }
+  else {
+    w.v_data = (char *)m + i * dt;
+    w.v_step = stride;
+  }
+  return w;
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ VEC_view VEC_matRow(const void *m, vsize_t i) {
+  VEC_assert(i < VEC_matRows(m), "VEC_matRow: row out of range");
+  return VEC_INTERNAL_matLine(m, i, true);
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ VEC_view VEC_matCol(const void *m, vsize_t j) {
+  VEC_assert(j < VEC_matCols(m), "VEC_matCol: column out of range");
+  return VEC_INTERNAL_matLine(m, j, false);
+}
+
+#endif /* V_MATRIX_H */
@@ -0,0 +1,178 @@
+/* MVPG API Vector Type: Growth Profiler
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_profile.h"
+
+#ifdef VEC_PROFILE
+
+#if !__WINDOWS__
+    #include <pthread.h>
+static pthread_mutex_t profLock = PTHREAD_MUTEX_INITIALIZER;
+    #define PROF_LOCK()   pthread_mutex_lock(&profLock)
+    #define PROF_UNLOCK() pthread_mutex_unlock(&profLock)
+#else
+    #define PROF_LOCK()   PASS
+    #define PROF_UNLOCK() PASS
+#endif
+
+/* Sites a header tag can hold; site 0 collects the others */
+#ifdef VEC_COMPACT_HEADER
+    #define PROF_SITES (1u << 8)
+#else
+    #define PROF_SITES (1u << 16)
+#endif
+#define PROF_SLOTS (PROF_SITES << 1)
+
+typedef struct {
+  const char   *ps_file;
+  unsigned int  ps_line;
+  vsize_t       ps_news, ps_frees, ps_resizes;
+  vsize_t       ps_copied;  /* Bytes copied by growth */
+  vsize_t       ps_initcap; /* Sum of the initial capacities */
+  vsize_t       ps_peak;    /* Largest used count seen */
+  vsize_t       ps_used;    /* Sums of used and capacity, on destroy */
+  vsize_t       ps_cap;
+} profSite;
+
+/* Sites, and an open-addressing table of site ids (0: empty slot) by file and line */
+static profSite profSites[PROF_SITES];
+static uint32_t profSlots[PROF_SLOTS];
+static uint32_t profN = 1;
+
+#ifndef VEC_PROFILE_NOEXIT
+static void profExit(void) {
+  VEC_profileReport(stderr);
+}
+#endif
+
+__NONNULL__ static vsize_t profSite_(const char *file, unsigned int line) {
+  /* Id of the site file:line, registered on first use. __FILE__ may be a distinct string in each unit, so it is compared by contents */
+  uint64_t h;
+
+  h = MvpgInclude_Hash64(file, strlen(file), line);
+  for (h &= PROF_SLOTS - 1; profSlots[h]; h = (h + 1) & (PROF_SLOTS - 1)) {
+    const profSite *s = profSites + profSlots[h];
+
+    if ((s->ps_line == line) && ((s->ps_file == file) || !strcmp(s->ps_file, file)))
+      return profSlots[h];
+  }
+  if (profN == PROF_SITES)
+    return 0;
+
+#ifndef VEC_PROFILE_NOEXIT
+  if (profN == 1)
+    atexit(profExit);
+#endif
+  profSites[profN].ps_file = file;
+  profSites[profN].ps_line = line;
+  profSlots[h] = profN;
+  return profN++;
+}
+
+__NONNULL__ void *VEC_INTERNAL_profileNew(void *v, const char *file, unsigned int line) {
+  vsize_t id;
+
+  PROF_LOCK();
+  id = profSite_(file, line);
+  profSites[id].ps_news++;
+  profSites[id].ps_initcap += VEC_vsize(v);
+  PROF_UNLOCK();
+
+  VEC_vsite(v) = id;
+  return v;
+}
+
+__NONNULL__ void VEC_INTERNAL_profileGrow(const void *v, vsize_t used, vsize_t size, bool moved) {
+  /* v grew from used items to hold size more: the vector is about to hold used + size */
+  profSite *s = profSites + VEC_vsite(v);
+
+  PROF_LOCK();
+  s->ps_resizes++;
+  s->ps_copied += moved ? used * VEC_vdtype(v) : 0;
+  s->ps_peak    = used + size > s->ps_peak ? used + size : s->ps_peak;
+  PROF_UNLOCK();
+}
+
+__NONNULL__ void VEC_INTERNAL_profileUsed(const void *v, vsize_t used) {
+  profSite *s = profSites + VEC_vsite(v);
+
+  PROF_LOCK();
+  s->ps_peak = used > s->ps_peak ? used : s->ps_peak;
+  PROF_UNLOCK();
+}
+
+__NONNULL__ void VEC_INTERNAL_profileFree(const void *v) {
+  profSite *s = profSites + VEC_vsite(v);
+  const vsize_t used = VEC_vused(v);
+
+  PROF_LOCK();
+  s->ps_frees++;
+  s->ps_used += used;
+  s->ps_cap  += VEC_vsize(v);
+  s->ps_peak  = used > s->ps_peak ? used : s->ps_peak;
+  PROF_UNLOCK();
+}
+
+static int profCmp(const void *a, const void *b) {
+  /* Most bytes copied first, then most resizes */
+  const profSite *x = profSites + *(const uint32_t *)a, *y = profSites + *(const uint32_t *)b;
+
+  if (x->ps_copied != y->ps_copied)
+    return x->ps_copied < y->ps_copied ? 1 : -1;
+  return (x->ps_resizes < y->ps_resizes) - (x->ps_resizes > y->ps_resizes);
+}
+
+__NONNULL__ void VEC_profileReport(FILE *f) {
+  static uint32_t order[PROF_SITES];
+  const profSite *s;
+  vsize_t i, n, init, rec;
+  char site[64];
+
+  PROF_LOCK();
+  for (i = n = 0; i < profN; i++) {
+    if (profSites[i].ps_news || profSites[i].ps_resizes || profSites[i].ps_frees)
+      order[n++] = i;
+  }
+  qsort(order, n, sizeof *order, profCmp);
+
+  fprintf(f, "VEC growth profile: %lu sites\n", n);
+  fprintf(f, "%-40s %10s %10s %14s %10s %10s %9s %12s\n",
+          "site", "vectors", "resizes", "copied", "init cap", "peak used", "used/cap", "recommended");
+
+  for (i = 0; i < n; i++) {
+    s = profSites + order[i];
+    if (order[i])
+      snprintf(site, sizeof site, "%s:%u", s->ps_file, s->ps_line);
+    else
+      snprintf(site, sizeof site, "(untracked)");
+
+    init = s->ps_news ? s->ps_initcap / s->ps_news : 0;
+    rec  = s->ps_resizes || (s->ps_used * VEC_PROFILE_WASTE < s->ps_cap) ? s->ps_peak : init;
+
+    fprintf(f, "%-40s %10lu %10lu %14lu %10lu %10lu %8.1f%% %11lu%s\n",
+            site, s->ps_news, s->ps_resizes, s->ps_copied, init, s->ps_peak,
+            s->ps_cap ? 100.0 * s->ps_used / s->ps_cap : 0.0, rec, rec != init ? "*" : " ");
+  }
+  PROF_UNLOCK();
+}
+
+void VEC_profileReset(void) {
+  vsize_t i;
+
+  PROF_LOCK();
+  for (i = 0; i < profN; i++) {
+    profSites[i].ps_news = profSites[i].ps_frees = profSites[i].ps_resizes = 0;
+    profSites[i].ps_copied = profSites[i].ps_initcap = profSites[i].ps_peak = 0;
+    profSites[i].ps_used = profSites[i].ps_cap = 0;
+  }
+  PROF_UNLOCK();
+}
+
+#endif /* VEC_PROFILE */
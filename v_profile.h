@@ -0,0 +1,42 @@
+/* MVPG API Vector Type: Growth Profiler
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_PROFILE_H
+#define V_PROFILE_H
+
+#include "v_base.h"
+
+/*                    GROWTH PROFILER (VEC_PROFILE)
+ *
+ * Compile every unit with VEC_PROFILE defined to enable it (see v_base.h); without it, these are no-ops.
+ *
+ * VEC_profileReport(F):  write the sites to the stream F, by bytes copied on growth, then by resizes
+ * VEC_profileReset():    clear the counters (sites are kept)
+ *
+ * For each site: vectors created, resizes, bytes copied by growth (blocks that moved), initial capacity (mean), peak used
+ * (the largest count of items seen on a resize, with the items it makes room for, a realloc / shrink, or a destroy),
+ * used / capacity of the destroyed vectors, and the recommended initial capacity: the peak, when the site resized or used less than 1 / VEC_PROFILE_WASTE of its capacity.
+ * The report is written to stderr at exit, unless VEC_PROFILE_NOEXIT is defined.
+ * Counters are updated under a lock, so vectors may be created and grown by several threads.
+ */
+
+#ifndef VEC_PROFILE_WASTE
+    #define VEC_PROFILE_WASTE 4
+#endif
+
+#ifdef VEC_PROFILE
+void VEC_profileReport (FILE *f);
+void VEC_profileReset  (void);
+#else
+    #define VEC_profileReport(F) MvpgMacro_Ignore(F)
+    #define VEC_profileReset()   PASS
+#endif
+
+#endif /* V_PROFILE_H */
@@ -0,0 +1,139 @@
+/* MVPG API Vector Type: RCU Snapshots
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_rcu.h"
+
+/* Retired version record (rt_vec == 0) or vector (rt_vec == 1), with the epoch it was retired in */
+typedef struct {
+  void     *rt_ptr;
+  uint64_t  rt_epoch;
+  uint8_t   rt_vec;
+} rcuRetired;
+
+__NONNULL__ static VEC_rcuSnap *rcuSnap(const void *v, vsize_t len) {
+  VEC_rcuSnap *s = malloc(sizeof *s);
+
+  VEC_assert(s != NULL, "VEC_rcu: out of memory");
+  s->rs_data = v;
+  s->rs_len  = len;
+  return s;
+}
+
+__NONNULL__ static void rcuRetire(VEC_rcu *r, void *p, uint64_t epoch, uint8_t vec) {
+  rcuRetired *rt;
+
+  if (VEC_vsize(r->rc_retired) == VEC_vused(r->rc_retired))
+    r->rc_retired = VEC_INTERNAL_resize(r->rc_retired, 1);
+
+  rt = (rcuRetired *)r->rc_retired + VEC_vusedPostIncr(r->rc_retired);
+  rt->rt_ptr   = p;
+  rt->rt_epoch = epoch;
+  rt->rt_vec   = vec;
+}
+
+__NONNULL__ static void rcuFree(rcuRetired *rt) {
+  if (rt->rt_vec)
+    VEC_destroy(rt->rt_ptr);
+  else
+    free(rt->rt_ptr);
+}
+
+__NONNULL__ static void rcuSwap(VEC_rcu *r, VEC_rcuSnap *s) {
+  /* Publish s; the former version (and its vector, if s has another) is retired in the epoch that ends here */
+  VEC_rcuSnap *old;
+  uint64_t e;
+
+  old = atomic_exchange(&r->rc_cur, s);
+  e   = atomic_fetch_add(&r->rc_epoch, 1);
+
+  if (old->rs_data != s->rs_data)
+    rcuRetire(r, (void *)old->rs_data, e, 1);
+  rcuRetire(r, old, e, 0);
+  VEC_rcuReclaim(r);
+}
+
+__NONNULL__ void VEC_rcuInit(VEC_rcu *r, void *v, vsize_t nreaders) {
+  VEC_assert(nreaders > 0, "VEC_rcuInit: no reader");
+
+  /* Slots on their own cache lines: the block is over-allocated by a line, and the slots start at the first boundary in it */
+  r->rc_nslots  = nreaders;
+  r->rc_slotblk = mvpgAlloc(__bsafeUnsignedMulAddl(nreaders, sizeof(VEC_rcuSlot), sizeof(VEC_rcuSlot)), 0);
+  r->rc_slots   = (VEC_rcuSlot *)NXTMUL((uintptr_t)r->rc_slotblk, sizeof(VEC_rcuSlot));
+  r->rc_retired = VEC_new(8, rcuRetired);
+  atomic_init(&r->rc_cur, rcuSnap(v, VEC_vused(v)));
+  atomic_init(&r->rc_epoch, 1); /* A slot holding 0 is clear */
+  atomic_init(&r->rc_nreg, 0);
+}
+
+__NONNULL__ vsize_t VEC_rcuRegister(VEC_rcu *r) {
+  const vsize_t id = atomic_fetch_add(&r->rc_nreg, 1);
+
+  VEC_assert(id < r->rc_nslots, "VEC_rcuRegister: more readers than VEC_rcuInit allowed");
+  return id;
+}
+
+__NONNULL__ void VEC_rcuPublish(VEC_rcu *r, void *v) {
+  rcuSwap(r, rcuSnap(v, VEC_vused(v)));
+}
+
+__NONNULL__ void VEC_rcuAppend(VEC_rcu *r, const void *p, vsize_t n) {
+  const VEC_rcuSnap *cur = atomic_load_explicit(&r->rc_cur, memory_order_relaxed);
+  char *v = (char *)cur->rs_data, *w;
+  const vsize_t dt = VEC_vdtype(v), len = cur->rs_len;
+  vsize_t cap;
+
+  if (VEC_vsize(v) - len < n) {
+    /* Readers may hold v: copy to a new vector, never grow v in place */
+    for (cap = VEC_vsize(v) | !VEC_vsize(v); cap - len < n; cap = __bsafeUnsignedMull(cap, 2))
+      PASS;
+    w = VEC_newFrmSize(cap, dt);
+    mvpgMemcpy(w, v, __bsafeUnsignedMull(len, dt));
+    v = w;
+  }
+  mvpgMemcpy(v + len * dt, p, __bsafeUnsignedMull(n, dt));
+  VEC_vusedSet(v, len + n);
+  rcuSwap(r, rcuSnap(v, len + n));
+}
+
+__NONNULL__ void VEC_rcuReclaim(VEC_rcu *r) {
+  rcuRetired *rt = r->rc_retired;
+  uint64_t min, e;
+  vsize_t i, k;
+
+  /* Oldest epoch a reader entered in */
+  for (i = 0, min = UINT64_MAX; i < r->rc_nslots; i++) {
+    e = atomic_load(&r->rc_slots[i].rs_epoch);
+    min = e && (e < min) ? e : min;
+  }
+
+  for (i = k = 0; i < VEC_vused(rt); i++) {
+    if (rt[i].rt_epoch < min)
+      rcuFree(rt + i);
+    else
+      rt[k++] = rt[i];
+  }
+  VEC_vusedSet(rt, k);
+}
+
+__NONNULL__ void VEC_rcuDestroy(VEC_rcu *r) {
+  rcuRetired *rt = r->rc_retired;
+  VEC_rcuSnap *cur = atomic_load(&r->rc_cur);
+  void *v = (void *)cur->rs_data; /* Owned by r: readers only see it const */
+  vsize_t i;
+
+  for (i = 0; i < VEC_vused(rt); i++)
+    rcuFree(rt + i);
+  VEC_destroy(r->rc_retired);
+
+  VEC_destroy(v);
+  free(cur);
+  mvpgDealloc(r->rc_slotblk);
+  r->rc_slots = r->rc_slotblk = NULL;
+}
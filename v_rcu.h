@@ -0,0 +1,77 @@
+/* MVPG API Vector Type: RCU Snapshots
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_RCU_H
+#define V_RCU_H
+
+#include "v_base.h"
+#include <stdatomic.h>
+
+/*                    RCU SNAPSHOTS (ONE WRITER, MANY READERS)
+ *
+ * A VEC_rcu publishes versions of a vector: a version is an immutable (data, length) record, swapped atomically.
+ *
+ * VEC_rcuInit(R, V, N):      R publishes V (which it owns from then on), for at most N reader threads
+ * VEC_rcuRegister(R):        id of a new reader (once per reader thread)
+ * VEC_rcuRead(R, ID):        snapshot of the current version; it stays valid until VEC_rcuDone(R, ID). Wait-free
+ * VEC_rcuPublish(R, V):      writer: publish the rebuilt vector V (R owns it), retiring the current one
+ * VEC_rcuAppend(R, P, N):    writer: append the N items at P, and publish
+ * VEC_rcuReclaim(R):         writer: free the retired versions no reader may hold (done by Publish and Append)
+ * VEC_rcuDestroy(R):         free every version, once no reader is left
+ *
+ * Readers read rs_len items from rs_data, and must neither modify them nor read the vector header (the writer updates its count).
+ * A reader holds one snapshot at a time: VEC_rcuRead announces the global epoch in the reader slot, then loads the version;
+ * VEC_rcuDone clears the slot. A retired version is tagged with the epoch it was retired in, then the epoch is advanced;
+ * it is freed when every slot is clear or holds a later epoch (epoch-based reclamation), so a reader never waits on the writer.
+ * Append writes past the published length, which readers do not read, and publishes a longer version of the same vector;
+ * when the capacity is exhausted, the items are copied to a vector of twice the capacity, and the former one is retired
+ * (never reallocated in place). Appends cost amortized O(1) item copies.
+ */
+
+/* Version: immutable once published */
+typedef struct {
+  const void *rs_data; /* Items (a VEC vector) */
+  vsize_t     rs_len;  /* Items of this version */
+} VEC_rcuSnap;
+
+/* Reader slot: the epoch it entered in (0: no snapshot held), one cache line each */
+typedef struct {
+  _Atomic uint64_t rs_epoch;
+  char             rs_pad[64 - sizeof(uint64_t)];
+} VEC_rcuSlot;
+
+typedef struct {
+  _Atomic(VEC_rcuSnap *) rc_cur;
+  _Atomic uint64_t       rc_epoch;
+  _Atomic vsize_t        rc_nreg;
+  vsize_t                rc_nslots;
+  VEC_rcuSlot           *rc_slots;   /* 64 bytes aligned, in rc_slotblk */
+  void                  *rc_slotblk;
+  void                  *rc_retired; /* Writer only: retired versions and vectors */
+} VEC_rcu;
+
+void    VEC_rcuInit     (VEC_rcu *r, void *v, vsize_t nreaders);
+vsize_t VEC_rcuRegister (VEC_rcu *r);
+void    VEC_rcuPublish  (VEC_rcu *r, void *v);
+void    VEC_rcuAppend   (VEC_rcu *r, const void *p, vsize_t n);
+void    VEC_rcuReclaim  (VEC_rcu *r);
+void    VEC_rcuDestroy  (VEC_rcu *r);
+
+__STATIC_FORCE_INLINE_F __NONNULL__ VEC_rcuSnap VEC_rcuRead(VEC_rcu *r, vsize_t id) {
+  /* The announcement is ordered before the load of the version (both sequentially consistent) */
+  atomic_store(&r->rc_slots[id].rs_epoch, atomic_load_explicit(&r->rc_epoch, memory_order_acquire));
+  return *atomic_load(&r->rc_cur);
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void VEC_rcuDone(VEC_rcu *r, vsize_t id) {
+  atomic_store_explicit(&r->rc_slots[id].rs_epoch, 0, memory_order_release);
+}
+
+#endif /* V_RCU_H */
@@ -0,0 +1,395 @@
+/* MVPG API Vector Type: Scan
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_scan.h"
+
+#if !defined(VEC_SCAN_NOSIMD) && (defined(__AVX512F__) || defined(__AVX2__))
+    #include <immintrin.h>
+    #define SCAN_SIMD 1
+#endif
+
+/* Chunks of the threaded scan are multiples of this many items (whole cache lines) */
+#define SCAN_ALIGN 64
+
+typedef uint8_t  u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef float    f32;
+typedef double   f64;
+
+
+/***********************************************************
+
+ * SERIAL (returns the carry: c plus the sum of the n items)
+
+************************************************************/
+
+#define SCAN_SERIAL(T)							\
+  __STATIC_FORCE_INLINE_F T scanSerial_##T(T *d, const T *s, vsize_t n, T c, bool excl) { \
+    vsize_t i;								\
+    T x;								\
+									\
+    if (excl) {								\
+      for (i = 0; i < n; i++) {						\
+	x = s[i];							\
+	d[i] = c;							\
+	c += x;								\
+      }									\
+    }									\
+    else {								\
+      for (i = 0; i < n; i++)						\
+	d[i] = (c += s[i]);						\
+    }									\
+    return c;								\
+  }
+
+/* Sum of n items, on 8 accumulators so that it vectorizes */
+#define SCAN_SUM(T)							\
+  __STATIC_FORCE_INLINE_F T scanSum_##T(const T *s, vsize_t n) {	\
+    T a[8] = {0};							\
+    vsize_t i, j;							\
+									\
+    for (i = 0; i + 8 <= n; i += 8)					\
+      for (j = 0; j < 8; j++)						\
+	a[j] += s[i + j];						\
+    for (; i < n; i++)							\
+      a[0] += s[i];							\
+    return (T)(((a[0] + a[1]) + (a[2] + a[3])) + ((a[4] + a[5]) + (a[6] + a[7]))); \
+  }
+
+SCAN_SERIAL(u8)
+SCAN_SERIAL(u16)
+SCAN_SERIAL(u32)
+SCAN_SERIAL(u64)
+SCAN_SERIAL(f32)
+SCAN_SERIAL(f64)
+
+SCAN_SUM(u8)
+SCAN_SUM(u16)
+SCAN_SUM(u32)
+SCAN_SUM(u64)
+SCAN_SUM(f32)
+SCAN_SUM(f64)
+
+
+/***********************************************************
+
+ * SIMD (a register is scanned in log2(lanes) shifted adds; returns the count of items done, the serial loop finishes the rest)
+ * scanReg: inclusive scan of a register, scanShift: shifted up by one lane (exclusive), scanLast: last lane broadcast
+
+************************************************************/
+
+#ifdef SCAN_SIMD
+    #ifdef __AVX512F__
+        #define SCAN_ALIGNR32(X, S) _mm512_alignr_epi32(X, _mm512_setzero_si512(), 16 - (S))
+        #define SCAN_ALIGNR64(X, S) _mm512_alignr_epi64(X, _mm512_setzero_si512(), 8 - (S))
+
+__STATIC_FORCE_INLINE_F __m512i scanReg_u32(__m512i x) {
+  x = _mm512_add_epi32(x, SCAN_ALIGNR32(x, 1));
+  x = _mm512_add_epi32(x, SCAN_ALIGNR32(x, 2));
+  x = _mm512_add_epi32(x, SCAN_ALIGNR32(x, 4));
+  return _mm512_add_epi32(x, SCAN_ALIGNR32(x, 8));
+}
+
+__STATIC_FORCE_INLINE_F __m512i scanReg_u64(__m512i x) {
+  x = _mm512_add_epi64(x, SCAN_ALIGNR64(x, 1));
+  x = _mm512_add_epi64(x, SCAN_ALIGNR64(x, 2));
+  return _mm512_add_epi64(x, SCAN_ALIGNR64(x, 4));
+}
+
+__STATIC_FORCE_INLINE_F __m512 scanReg_f32(__m512 x) {
+  x = _mm512_add_ps(x, _mm512_castsi512_ps(SCAN_ALIGNR32(_mm512_castps_si512(x), 1)));
+  x = _mm512_add_ps(x, _mm512_castsi512_ps(SCAN_ALIGNR32(_mm512_castps_si512(x), 2)));
+  x = _mm512_add_ps(x, _mm512_castsi512_ps(SCAN_ALIGNR32(_mm512_castps_si512(x), 4)));
+  return _mm512_add_ps(x, _mm512_castsi512_ps(SCAN_ALIGNR32(_mm512_castps_si512(x), 8)));
+}
+
+__STATIC_FORCE_INLINE_F __m512d scanReg_f64(__m512d x) {
+  x = _mm512_add_pd(x, _mm512_castsi512_pd(SCAN_ALIGNR64(_mm512_castpd_si512(x), 1)));
+  x = _mm512_add_pd(x, _mm512_castsi512_pd(SCAN_ALIGNR64(_mm512_castpd_si512(x), 2)));
+  return _mm512_add_pd(x, _mm512_castsi512_pd(SCAN_ALIGNR64(_mm512_castpd_si512(x), 4)));
+}
+
+        #define scanShift_u32(Y) SCAN_ALIGNR32(Y, 1)
+        #define scanShift_u64(Y) SCAN_ALIGNR64(Y, 1)
+        #define scanShift_f32(Y) _mm512_castsi512_ps(SCAN_ALIGNR32(_mm512_castps_si512(Y), 1))
+        #define scanShift_f64(Y) _mm512_castsi512_pd(SCAN_ALIGNR64(_mm512_castpd_si512(Y), 1))
+
+        #define scanLast_u32(Y) _mm512_permutexvar_epi32(_mm512_set1_epi32(15), Y)
+        #define scanLast_u64(Y) _mm512_permutexvar_epi64(_mm512_set1_epi64(7), Y)
+        #define scanLast_f32(Y) _mm512_permutexvar_ps(_mm512_set1_epi32(15), Y)
+        #define scanLast_f64(Y) _mm512_permutexvar_pd(_mm512_set1_epi64(7), Y)
+
+        #define SCAN_LDI(P)    _mm512_loadu_si512(P)
+        #define SCAN_STI(P, X) _mm512_storeu_si512(P, X)
+
+        #define SCAN_DEF_u32 __m512i, 16, SCAN_LDI, SCAN_STI, _mm512_add_epi32, _mm512_set1_epi32((int)c0), (u32)_mm_cvtsi128_si32(_mm512_castsi512_si128(c))
+        #define SCAN_DEF_u64 __m512i, 8, SCAN_LDI, SCAN_STI, _mm512_add_epi64, _mm512_set1_epi64((long long)c0), (u64)_mm_cvtsi128_si64(_mm512_castsi512_si128(c))
+        #define SCAN_DEF_f32 __m512, 16, _mm512_loadu_ps, _mm512_storeu_ps, _mm512_add_ps, _mm512_set1_ps(c0), _mm512_cvtss_f32(c)
+        #define SCAN_DEF_f64 __m512d, 8, _mm512_loadu_pd, _mm512_storeu_pd, _mm512_add_pd, _mm512_set1_pd(c0), _mm512_cvtsd_f64(c)
+    #else
+/* AVX2 shifts bytes within 128 bits lanes only: the low lane total is then added to the high lane */
+        #define SCAN_LANE(T) _mm256_permute2x128_si256(T, T, 0x08)
+
+__STATIC_FORCE_INLINE_F __m256i scanReg_u32(__m256i x) {
+  x = _mm256_add_epi32(x, _mm256_slli_si256(x, 4));
+  x = _mm256_add_epi32(x, _mm256_slli_si256(x, 8));
+  return _mm256_add_epi32(x, SCAN_LANE(_mm256_shuffle_epi32(x, 0xff)));
+}
+
+__STATIC_FORCE_INLINE_F __m256i scanReg_u64(__m256i x) {
+  x = _mm256_add_epi64(x, _mm256_slli_si256(x, 8));
+  return _mm256_add_epi64(x, SCAN_LANE(_mm256_shuffle_epi32(x, 0xee)));
+}
+
+__STATIC_FORCE_INLINE_F __m256 scanReg_f32(__m256 x) {
+  __m256i y;
+
+  x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 4)));
+  x = _mm256_add_ps(x, _mm256_castsi256_ps(_mm256_slli_si256(_mm256_castps_si256(x), 8)));
+  y = _mm256_shuffle_epi32(_mm256_castps_si256(x), 0xff);
+  return _mm256_add_ps(x, _mm256_castsi256_ps(SCAN_LANE(y)));
+}
+
+__STATIC_FORCE_INLINE_F __m256d scanReg_f64(__m256d x) {
+  __m256i y;
+
+  x = _mm256_add_pd(x, _mm256_castsi256_pd(_mm256_slli_si256(_mm256_castpd_si256(x), 8)));
+  y = _mm256_shuffle_epi32(_mm256_castpd_si256(x), 0xee);
+  return _mm256_add_pd(x, _mm256_castsi256_pd(SCAN_LANE(y)));
+}
+
+        #define SCAN_SHIFT32(Y) _mm256_blend_epi32(_mm256_permutevar8x32_epi32(Y, _mm256_setr_epi32(0, 0, 1, 2, 3, 4, 5, 6)), _mm256_setzero_si256(), 0x01)
+        #define SCAN_SHIFT64(Y) _mm256_blend_epi32(_mm256_permute4x64_epi64(Y, 0x90), _mm256_setzero_si256(), 0x03)
+
+        #define scanShift_u32(Y) SCAN_SHIFT32(Y)
+        #define scanShift_u64(Y) SCAN_SHIFT64(Y)
+        #define scanShift_f32(Y) _mm256_castsi256_ps(SCAN_SHIFT32(_mm256_castps_si256(Y)))
+        #define scanShift_f64(Y) _mm256_castsi256_pd(SCAN_SHIFT64(_mm256_castpd_si256(Y)))
+
+        #define scanLast_u32(Y) _mm256_permutevar8x32_epi32(Y, _mm256_set1_epi32(7))
+        #define scanLast_u64(Y) _mm256_permute4x64_epi64(Y, 0xff)
+        #define scanLast_f32(Y) _mm256_permutevar8x32_ps(Y, _mm256_set1_epi32(7))
+        #define scanLast_f64(Y) _mm256_permute4x64_pd(Y, 0xff)
+
+        #define SCAN_LDI(P)    _mm256_loadu_si256((const void *)(P))
+        #define SCAN_STI(P, X) _mm256_storeu_si256((void *)(P), X)
+
+        #define SCAN_DEF_u32 __m256i, 8, SCAN_LDI, SCAN_STI, _mm256_add_epi32, _mm256_set1_epi32((int)c0), (u32)_mm_cvtsi128_si32(_mm256_castsi256_si128(c))
+        #define SCAN_DEF_u64 __m256i, 4, SCAN_LDI, SCAN_STI, _mm256_add_epi64, _mm256_set1_epi64x((long long)c0), (u64)_mm_cvtsi128_si64(_mm256_castsi256_si128(c))
+        #define SCAN_DEF_f32 __m256, 8, _mm256_loadu_ps, _mm256_storeu_ps, _mm256_add_ps, _mm256_set1_ps(c0), _mm256_cvtss_f32(c)
+        #define SCAN_DEF_f64 __m256d, 4, _mm256_loadu_pd, _mm256_storeu_pd, _mm256_add_pd, _mm256_set1_pd(c0), _mm256_cvtsd_f64(c)
+    #endif
+
+/* c holds the carry in every lane */
+#define SCAN_SIMDLOOP(T, V, W, LD, ST, ADD, SET1, GET)			\
+  __STATIC_FORCE_INLINE_F vsize_t scanSimd_##T(T *d, const T *s, vsize_t n, T *carry, bool excl) { \
+    const T c0 = *carry;						\
+    V c, y;								\
+    vsize_t i;								\
+									\
+    c = SET1;								\
+    for (i = 0; i + W <= n; i += W) {					\
+      y = scanReg_##T(LD(s + i));					\
+      ST(d + i, ADD(c, excl ? scanShift_##T(y) : y));			\
+      c = ADD(c, scanLast_##T(y));					\
+    }									\
+    *carry = GET;							\
+    return i;								\
+  }
+
+#define SCAN_SIMDDEF(T, ...) SCAN_SIMDLOOP(T, __VA_ARGS__)
+
+SCAN_SIMDDEF(u32, SCAN_DEF_u32)
+SCAN_SIMDDEF(u64, SCAN_DEF_u64)
+SCAN_SIMDDEF(f32, SCAN_DEF_f32)
+SCAN_SIMDDEF(f64, SCAN_DEF_f64)
+#else
+    #define scanSimd_u32(D, S, N, C, E) 0
+    #define scanSimd_u64(D, S, N, C, E) 0
+    #define scanSimd_f32(D, S, N, C, E) 0
+    #define scanSimd_f64(D, S, N, C, E) 0
+#endif
+#define scanSimd_u8(D, S, N, C, E)  0
+#define scanSimd_u16(D, S, N, C, E) 0
+
+
+/***********************************************************
+
+ * THREADED (two passes over chunks: sums, then scans from the sum of the preceding chunks)
+
+************************************************************/
+
+typedef struct {
+  void       *d;
+  const void *s;
+  vsize_t     n, chunk;
+  VEC_kind    k;
+  bool        excl, sums;
+  VEC_scalar  c[MVPG_MAXTHREADS]; /* Sum (first pass), then offset (second pass) of each chunk */
+} scanJob;
+
+/* F: member of VEC_scalar holding a T */
+#define SCAN_CHUNK(T, F)						\
+  static void scanChunk_##T(scanJob *j, size_t i) {			\
+    const vsize_t lo = i * j->chunk, n = ((j->n - lo) < j->chunk) ? (j->n - lo) : j->chunk; \
+    T *d = (T *)j->d + lo;						\
+    const T *s = (const T *)j->s + lo;					\
+    vsize_t k;								\
+    T c;								\
+									\
+    if (j->sums) {							\
+      j->c[i].F = scanSum_##T(s, n);					\
+      return;								\
+    }									\
+    c = (T)j->c[i].F;							\
+    k = scanSimd_##T(d, s, n, &c, j->excl);				\
+    scanSerial_##T(d + k, s + k, n - k, c, j->excl);			\
+  }									\
+									\
+  static void scanOffsets_##T(scanJob *j, size_t nt) {			\
+    size_t i;								\
+    T c, x;								\
+									\
+    for (i = 0, c = 0; i < nt; i++) {					\
+      x = (T)j->c[i].F;							\
+      j->c[i].F = c;							\
+      c += x;								\
+    }									\
+  }
+
+SCAN_CHUNK(u8, u)
+SCAN_CHUNK(u16, u)
+SCAN_CHUNK(u32, u)
+SCAN_CHUNK(u64, u)
+SCAN_CHUNK(f32, f)
+SCAN_CHUNK(f64, f)
+
+static void scanChunk(void *a, size_t i) {
+  scanJob *j = a;
+
+  switch (j->k) {
+  case VEC_I8:
+  case VEC_U8:
+    scanChunk_u8(j, i);
+    break;
+  case VEC_I16:
+  case VEC_U16:
+    scanChunk_u16(j, i);
+    break;
+  case VEC_I32:
+  case VEC_U32:
+    scanChunk_u32(j, i);
+    break;
+  case VEC_I64:
+  case VEC_U64:
+    scanChunk_u64(j, i);
+    break;
+  case VEC_F32:
+    scanChunk_f32(j, i);
+    break;
+  default:
+    scanChunk_f64(j, i);
+    break;
+  }
+}
+
+static void scanOffsets(scanJob *j, size_t nt) {
+  switch (j->k) {
+  case VEC_I8:
+  case VEC_U8:
+    scanOffsets_u8(j, nt);
+    break;
+  case VEC_I16:
+  case VEC_U16:
+    scanOffsets_u16(j, nt);
+    break;
+  case VEC_I32:
+  case VEC_U32:
+    scanOffsets_u32(j, nt);
+    break;
+  case VEC_I64:
+  case VEC_U64:
+    scanOffsets_u64(j, nt);
+    break;
+  case VEC_F32:
+    scanOffsets_f32(j, nt);
+    break;
+  default:
+    scanOffsets_f64(j, nt);
+    break;
+  }
+}
+
+static size_t scanThreads(vsize_t bytes) {
+  size_t nt, max;
+
+  max = VEC_SCAN_THREADS ? VEC_SCAN_THREADS : MvpgInclude_Ncpu();
+  max = (max < MVPG_MAXTHREADS) ? max : MVPG_MAXTHREADS;
+  nt  = bytes / VEC_SCAN_PARMIN;
+
+  return nt < 1 ? 1 : (nt < max ? nt : max);
+}
+
+static void *scanRun(void *dst, const void *src, VEC_kind k, bool excl) {
+  const vsize_t n = VEC_used(src), dt = VEC_vdtype(src);
+  scanJob j;
+  size_t nt;
+
+  VEC_assert(VEC_kindSize(k) == dt, "VEC_scan: kind does not match the item size");
+
+  if (dst == NULL) {
+    dst = VEC_newFrmSize(n, dt);
+  }
+  else if (dst != src) {
+    VEC_assert(VEC_vdtype(dst) == dt, "VEC_scan: type mismatch");
+    VEC_vusedSet(dst, 0);
+    if (VEC_vsize(dst) < n)
+      dst = VEC_INTERNAL_resize(dst, n);
+  }
+
+  nt = scanThreads(n * dt);
+  j.d     = dst;
+  j.s     = src;
+  j.n     = n;
+  j.k     = k;
+  j.excl  = excl;
+  j.chunk = NXTMUL((n + nt - 1) / nt, SCAN_ALIGN);
+  nt      = j.chunk ? (n + j.chunk - 1) / j.chunk : 1;
+
+  memset(j.c, 0, sizeof(j.c));
+  if (nt > 1) {
+    /* The last chunk's sum is not needed */
+    j.sums = true;
+    MvpgInclude_Parallel(scanChunk, &j, nt - 1);
+    scanOffsets(&j, nt);
+  }
+  j.sums = false;
+  MvpgInclude_Parallel(scanChunk, &j, nt);
+
+  VEC_vusedSet(dst, n);
+  return dst;
+}
+
+
+/***********************************************************
+
+ * API
+
+************************************************************/
+
+void *VEC_inclusiveScan(void *dst, const void *src, VEC_kind k) {
+  return scanRun(dst, src, k, false);
+}
+
+void *VEC_exclusiveScan(void *dst, const void *src, VEC_kind k) {
+  return scanRun(dst, src, k, true);
+}
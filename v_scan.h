@@ -0,0 +1,40 @@
+/* MVPG API Vector Type: Scan
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_SCAN_H
+#define V_SCAN_H
+
+#include "v_base.h"
+
+/*                    PREFIX SUM (SCAN)
+ *
+ * VEC_inclusiveScan(D, S, K): D[i] = S[0] + ... + S[i]
+ * VEC_exclusiveScan(D, S, K): D[i] = S[0] + ... + S[i - 1], D[0] = 0
+ *
+ * K is the kind of the items of S. Integers wrap (modulo 2^bits), for signed kinds too.
+ * D may be S (in place), or NULL, in which case it is created; else it is overwritten and grown if needed. D is returned, as with VEC_INTERNAL_resize.
+ *
+ * Blocks are scanned in SIMD registers (AVX2/AVX-512 at compile time, for 4 and 8 bytes items; VEC_SCAN_NOSIMD disables it).
+ * Vectors of more than VEC_SCAN_PARMIN bytes per thread are scanned by up to VEC_SCAN_THREADS threads (0: one per processor) in two passes:
+ * each thread sums its chunk, then scans it from the sum of the preceding chunks.
+ * Float sums are therefore associated differently by the SIMD and threaded paths, so they may differ from a sequential loop in the last bits.
+ */
+
+#ifndef VEC_SCAN_THREADS
+    #define VEC_SCAN_THREADS 0
+#endif
+#ifndef VEC_SCAN_PARMIN
+    #define VEC_SCAN_PARMIN (4ul << 20)
+#endif
+
+void *VEC_inclusiveScan (void *dst, const void *src, VEC_kind k);
+void *VEC_exclusiveScan (void *dst, const void *src, VEC_kind k);
+
+#endif /* V_SCAN_H */
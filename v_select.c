@@ -0,0 +1,123 @@
+/* MVPG API Vector Type: Selection
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_select.h"
+#include "v_define.h"
+
+/* Floats: NaNs rank after every number, so that the order is total */
+#define SELECT_FLT_LT(a, b) (((a) < (b)) || (((b) != (b)) && ((a) == (a))))
+
+VEC_DEFINE(selI8, int8_t);
+VEC_DEFINE(selU8, uint8_t);
+VEC_DEFINE(selI16, int16_t);
+VEC_DEFINE(selU16, uint16_t);
+VEC_DEFINE(selI32, int32_t);
+VEC_DEFINE(selU32, uint32_t);
+VEC_DEFINE(selI64, int64_t);
+VEC_DEFINE(selU64, uint64_t);
+VEC_DEFINE_CMP(selF32, float, SELECT_FLT_LT);
+VEC_DEFINE_CMP(selF64, double, SELECT_FLT_LT);
+
+/* Expands CASE(name, T, member of VEC_scalar) for kind k */
+#define SELECT_DISPATCH(k, CASE)			\
+  switch (k) {						\
+  case VEC_I8:  CASE(selI8,  int8_t,   i); break;	\
+  case VEC_U8:  CASE(selU8,  uint8_t,  u); break;	\
+  case VEC_I16: CASE(selI16, int16_t,  i); break;	\
+  case VEC_U16: CASE(selU16, uint16_t, u); break;	\
+  case VEC_I32: CASE(selI32, int32_t,  i); break;	\
+  case VEC_U32: CASE(selU32, uint32_t, u); break;	\
+  case VEC_I64: CASE(selI64, int64_t,  i); break;	\
+  case VEC_U64: CASE(selU64, uint64_t, u); break;	\
+  case VEC_F32: CASE(selF32, float,    f); break;	\
+  case VEC_F64: CASE(selF64, double,   f); break;	\
+  default: break; /* selectCheck rejects it */		\
+  }
+
+static void selectCheck(const void *v, VEC_kind k) {
+  MvpgMacro_Ignore(v);
+  MvpgMacro_Ignore(k);
+  VEC_assert(VEC_kindValid(k), "VEC_select: unknown kind");
+  VEC_assert(v != NULL, "VEC_select: NULL vector");
+  VEC_assert(VEC_vdtype(v) == VEC_kindSize(k), "VEC_select: dtype does not match kind");
+}
+
+/*****************************************************************************************
+
+ * NTH ELEMENT
+
+*****************************************************************************************/
+
+void VEC_nthElement(void *v, vsize_t r, VEC_kind k) {
+  selectCheck(v, k);
+
+#define SELECT_NTH(name, T, m) VEC_DEFINE_FN(name, _nth)((T *)v, r)
+  SELECT_DISPATCH(k, SELECT_NTH);
+#undef SELECT_NTH
+}
+
+/*****************************************************************************************
+
+ * TOP-K
+
+*****************************************************************************************/
+
+void *VEC_topk(void *dst, const void *src, vsize_t n, VEC_kind k) {
+  void *t;
+
+  selectCheck(src, k);
+  t = NULL;
+
+#define SELECT_TOPK(name, T, m) t = VEC_DEFINE_FN(name, _topk)((T *)src, n)
+  SELECT_DISPATCH(k, SELECT_TOPK);
+#undef SELECT_TOPK
+
+  if (dst == NULL)
+    return t;
+
+  /* Copy into the caller's vector */
+  VEC_assert(VEC_vdtype(dst) == VEC_vdtype(t), "VEC_topk: type mismatch");
+  VEC_vusedSet(dst, 0);
+  if (VEC_vsize(dst) < VEC_vused(t))
+    dst = VEC_INTERNAL_resize(dst, VEC_vused(t));
+  mvpgMemcpy(dst, t, VEC_vused(t) * VEC_vdtype(t));
+  VEC_vusedSet(dst, VEC_vused(t));
+  VEC_destroy(t);
+
+  return dst;
+}
+
+/*****************************************************************************************
+
+ * QUANTILES
+
+*****************************************************************************************/
+
+void VEC_quantiles(void *v, const double *q, vsize_t m, VEC_kind k, VEC_scalar *out) {
+  vsize_t i;
+
+  selectCheck(v, k);
+  if (! m)
+    return;
+  VEC_assert((q != NULL) && (out != NULL), "VEC_quantiles: NULL argument");
+
+  /* Computed as T, then widened */
+#define SELECT_QUANT(name, T, mb)					\
+  do {									\
+    T *qt = (T *)malloc(m * sizeof(T));					\
+    VEC_assert(qt != NULL, "VEC_quantiles: out of memory");		\
+    VEC_DEFINE_FN(name, _quantiles)((T *)v, q, m, qt);			\
+    for (i = 0; i < m; i++)						\
+      out[i].mb = qt[i];						\
+    free(qt);								\
+  } while (0)
+  SELECT_DISPATCH(k, SELECT_QUANT);
+#undef SELECT_QUANT
+}
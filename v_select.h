@@ -0,0 +1,36 @@
+/* MVPG API Vector Type: Selection
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_SELECT_H
+#define V_SELECT_H
+
+#include "v_base.h"
+
+/*                    SELECTION (NTH ELEMENT, TOP-K, QUANTILES)
+ *
+ * VEC_nthElement(V, R, K):        reorder V so that V[R] is the item of rank R, with no greater item before it and no lesser item after it
+ * VEC_topk(D, S, N, K):           D = the N greatest items of S (all of them if S has fewer), in descending order
+ * VEC_quantiles(V, Q, M, K, OUT): OUT[i] = item of rank round(Q[i] * (VEC_used(V) - 1)), Q[i] clamped to [0, 1]; V is reordered
+ *
+ * K is the kind of the items. Float NaNs rank after every number. Quantiles are widened to VEC_scalar as for VEC_groupby
+ * (member i for signed kinds, u for unsigned kinds, f for floats) and are not interpolated.
+ * D may be NULL, in which case it is created; else it is overwritten and grown if needed.
+ *
+ * These are the name_nth, name_topk and name_quantiles functions of VEC_DEFINE (v_define.h), instantiated for every kind:
+ * introselect (Hoare partitioning around a median of 3, heapsort past 2 log2(n) partitions), a min-heap of the N greatest items
+ * (blocks of items not greater than its root are skipped by a vectorized test), and one recursive partitioning for all the ranks
+ * of the quantiles, recursing only into the sides holding a requested rank.
+ */
+
+void  VEC_nthElement (void *v, vsize_t r, VEC_kind k);
+void *VEC_topk       (void *dst, const void *src, vsize_t n, VEC_kind k);
+void  VEC_quantiles  (void *v, const double *q, vsize_t m, VEC_kind k, VEC_scalar *out);
+
+#endif /* V_SELECT_H */
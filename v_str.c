@@ -0,0 +1,150 @@
+/* MVPG API Vector Type: String Builder
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_str.h"
+#include "dtoa.h"
+#if !__WINDOWS__
+    #include <sys/uio.h>
+    #include <limits.h>
+    #include <unistd.h>
+#endif
+
+/* Longest integer: sign, 0x, 64 bits in decimal (20 digits), '\0' */
+#define STR_INTMAX 24
+
+/* Longest "%g" double, '\0' */
+#define STR_FLTMAX (MVPG_DTOA_LEN + 1)
+
+/* writev batches */
+#if !__WINDOWS__
+    #ifdef IOV_MAX
+        #define STR_IOVMAX IOV_MAX
+    #else
+        #define STR_IOVMAX 1024
+    #endif
+#endif
+
+
+/***********************************************************
+
+ * APPEND
+
+************************************************************/
+
+VEC_str VEC_strNew(vsize_t cap) {
+  /* The block is zeroed: the string is "" */
+  return VEC_new(cap + 1, char);
+}
+
+void VEC_strAppend(VEC_str *s, const void *p, vsize_t n) {
+  VEC_strReserve(s, n);
+  mvpgMemcpy(*s + VEC_vused(*s), p, n);
+  VEC_vusedSet(*s, VEC_vused(*s) + n);
+  (*s)[VEC_vused(*s)] = '\0';
+}
+
+void VEC_strCat(VEC_str *s, const char *c) {
+  VEC_strAppend(s, c, strlen(c));
+}
+
+void VEC_strAppendInt(VEC_str *s, intmax_t i) {
+  VEC_strReserve(s, STR_INTMAX);
+  VEC_vusedSet(*s, VEC_vused(*s) + MvpgInclude_Itoa((uintmax_t)i, *s + VEC_vused(*s), 10, i < 0));
+}
+
+void VEC_strAppendUint(VEC_str *s, uintmax_t u, bool hex) {
+  VEC_strReserve(s, STR_INTMAX);
+  VEC_vusedSet(*s, VEC_vused(*s) + MvpgInclude_Itoa(u, *s + VEC_vused(*s), hex ? 16 : 10, 0));
+}
+
+void VEC_strAppendFlt(VEC_str *s, double f) {
+  VEC_strReserve(s, STR_FLTMAX);
+  VEC_vusedSet(*s, VEC_vused(*s) + mvpgDtoa(f, *s + VEC_vused(*s), 'g'));
+}
+
+void VEC_strAppendf(VEC_str *s, const char *fmt, ...) {
+  /* Format into the spare capacity; on overflow, reserve the reported length and format again */
+  va_list ap;
+  vsize_t room;
+  int n;
+
+  room = VEC_vsize(*s) - VEC_vused(*s);
+  va_start(ap, fmt);
+  n = vsnprintf(*s + VEC_vused(*s), room, fmt, ap);
+  va_end(ap);
+  VEC_assert(n >= 0, "VEC_strAppendf: format error");
+
+  if ((vsize_t)n >= room) {
+    VEC_strReserve(s, n);
+    va_start(ap, fmt);
+    vsnprintf(*s + VEC_vused(*s), n + 1, fmt, ap);
+    va_end(ap);
+  }
+  VEC_vusedSet(*s, VEC_vused(*s) + n);
+}
+
+
+/***********************************************************
+
+ * OUTPUT
+
+************************************************************/
+
+#if !__WINDOWS__
+ssize_t VEC_strWrite(int fd, const VEC_str s) {
+  const vsize_t n = VEC_vused(s);
+  vsize_t w;
+  ssize_t r;
+
+  for (w = 0; w < n; w += r) {
+    r = write(fd, s + w, n - w);
+    if (r < 0) {
+      if (errno == EINTR) {
+	r = 0;
+	continue;
+      }
+      return -1;
+    }
+  }
+  return n;
+}
+
+ssize_t VEC_strWritev(int fd, const VEC_str *ss, size_t n) {
+  /* Up to STR_IOVMAX strings per call; a partial write resumes from the first byte not written */
+  struct iovec iov[STR_IOVMAX];
+  size_t i, j, m;
+  ssize_t r, total;
+
+  for (total = 0, i = 0; i < n; ) {
+    m = (n - i < STR_IOVMAX) ? n - i : STR_IOVMAX;
+    for (j = 0; j < m; j++) {
+      iov[j].iov_base = ss[i + j];
+      iov[j].iov_len  = VEC_vused(ss[i + j]);
+    }
+
+    for (j = 0; j < m; ) {
+      r = writev(fd, iov + j, m - j);
+      if (r < 0) {
+	if (errno == EINTR)
+	  continue;
+	return -1;
+      }
+      for (total += r; (j < m) && ((size_t)r >= iov[j].iov_len); j++)
+	r -= iov[j].iov_len;
+      if (j < m) {
+	iov[j].iov_base = (char *)iov[j].iov_base + r;
+	iov[j].iov_len -= r;
+      }
+    }
+    i += m;
+  }
+  return total;
+}
+#endif
@@ -0,0 +1,72 @@
+/* MVPG API Vector Type: String Builder
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_STR_H
+#define V_STR_H
+
+#include "v_base.h"
+#include <stdarg.h>
+#if !__WINDOWS__
+    #include <sys/types.h>
+#endif
+
+/*                    VEC_str (STRING BUILDER)
+ *
+ * A growable byte string: a VEC vector of char whose used count is the length. One byte of the capacity is kept for a '\0'
+ * after the last byte, so that the string is always a C string (which may hold other '\0' bytes).
+ * Appends reserve ahead and grow the capacity by doubling (VEC_INTERNAL_resize), so n appends cost O(n) copies in all.
+ *
+ * VEC_strNew(CAP):             empty string with room for CAP bytes
+ * VEC_strReserve(&S, N):       room for N more bytes
+ * VEC_strAppend(&S, P, N):     append the N bytes at P
+ * VEC_strCat(&S, C):           append the C string C
+ * VEC_strPutc(&S, C):          append the byte C
+ * VEC_strAppendInt(&S, I):     append I in decimal; VEC_strAppendUint(&S, U, HEX) in decimal, or hexadecimal (0x prefixed) if HEX
+ * VEC_strAppendFlt(&S, F):     append F in "%g" form, with the fewest digits (up to 17) that read back as F
+ * VEC_strAppendf(&S, FMT, ...): append as printf
+ * VEC_strWrite(FD, S):         write S to the file descriptor FD, resuming partial writes; returns the bytes written, or -1
+ * VEC_strWritev(FD, SS, N):    write the N strings SS[0..N) with writev, from their own buffers (no copy)
+ */
+
+typedef VEC_type(char) VEC_str;
+
+#define VEC_strLen(S)				\
+  VEC_vused(S)
+
+#define VEC_strClear(S)				\
+  ( VEC_vusedSet(S, 0), (S)[0] = '\0' )
+
+#define VEC_strDestroy(S)			\
+  VEC_destroy(S)
+
+VEC_str  VEC_strNew       (vsize_t cap);
+void     VEC_strAppend    (VEC_str *s, const void *p, vsize_t n);
+void     VEC_strCat       (VEC_str *s, const char *c);
+void     VEC_strAppendInt (VEC_str *s, intmax_t i);
+void     VEC_strAppendUint(VEC_str *s, uintmax_t u, bool hex);
+void     VEC_strAppendFlt (VEC_str *s, double f);
+void     VEC_strAppendf   (VEC_str *s, const char *fmt, ...);
+#if !__WINDOWS__
+ssize_t  VEC_strWrite     (int fd, const VEC_str s);
+ssize_t  VEC_strWritev    (int fd, const VEC_str *ss, size_t n);
+#endif
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void VEC_strReserve(VEC_str *s, vsize_t n) {
+  if (LIKELY___(VEC_vsize(*s) - VEC_vused(*s) <= n, 0))
+    *s = VEC_INTERNAL_resize(*s, n + 1);
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void VEC_strPutc(VEC_str *s, char c) {
+  VEC_strReserve(s, 1);
+  (*s)[VEC_vusedPostIncr(*s)] = c;
+  (*s)[VEC_vused(*s)] = '\0';
+}
+
+#endif /* V_STR_H */
@@ -0,0 +1,180 @@
+/* MVPG API Vector Type: String Pool
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "v_strpool.h"
+
+#define STRPOOL_SEED      0x9e3779b97f4a7c15ull
+#define STRPOOL_MINBYTES  64
+#define STRPOOL_MININDEX  16
+
+/* Intern table slots hold (id + 1) of the first copy of a string; 0 is an empty slot */
+
+__STATIC_FORCE_INLINE_F __NONNULL__ void strpoolReserve(VEC_type(char) *v, vsize_t n) {
+  if (VEC_free(*v) < n)
+    *v = VEC_INTERNAL_resize(*v, n);
+}
+
+__STATIC_FORCE_INLINE_F __NONNULL__ bool strpoolOwns(const VEC_strpool *sp, const char *s) {
+  /* s lies in the byte vector (a string of the pool, as VEC_strpoolGet returns): it moves when the vector grows */
+  return ((uintptr_t)s >= (uintptr_t)sp->sp_bytes) && ((uintptr_t)s < (uintptr_t)(sp->sp_bytes + VEC_used(sp->sp_bytes)));
+}
+
+__NONNULL__ static VEC_stroff_t *strpoolSlot(const VEC_strpool *sp, const char *s, size_t len, uint64_t h) {
+  /* Slot of string s in the intern table: the slot holding s, or the empty slot s hashes to */
+
+  const vsize_t mask = VEC_used(sp->sp_index) - 1;
+  VEC_stroff_t *slot, off;
+
+  for (h &= mask; *(slot = sp->sp_index + h); h = (h + 1) & mask) {
+    off = sp->sp_offs[*slot - 1];
+
+    if ((VEC_strpoolLenAt(sp, off) == len) && !memcmp(sp->sp_bytes + off, s, len))
+      break;
+  }
+  return slot;
+}
+
+__NONNULL__ static void strpoolRehash(VEC_strpool *sp, vsize_t cap) {
+  /* Rebuild the intern table with cap (power of 2) slots */
+
+  VEC_type(VEC_stroff_t) old;
+  vsize_t i, h, off;
+
+  old = sp->sp_index;
+  sp->sp_index = VEC_new(cap, VEC_stroff_t);
+  VEC_vusedSet(sp->sp_index, cap);
+
+  for (i = 0; i < VEC_used(old); i++) {
+    if (! old[i])
+      continue;
+
+    off = sp->sp_offs[old[i] - 1];
+    h = MvpgInclude_Hash64(sp->sp_bytes + off, VEC_strpoolLenAt(sp, off), STRPOOL_SEED) & (cap - 1);
+    while (sp->sp_index[h])
+      h = (h + 1) & (cap - 1);
+    sp->sp_index[h] = old[i];
+  }
+  VEC_destroy(old);
+}
+
+__NONNULL__ void VEC_strpoolInit(VEC_strpool *sp, vsize_t nstr, vsize_t nbytes, uint8_t flags) {
+  /* nstr and nbytes are the expected number of strings and total bytes (a hint) */
+
+  vsize_t cap;
+
+  sp->sp_bytes = VEC_new(nbytes > STRPOOL_MINBYTES ? nbytes : STRPOOL_MINBYTES, char);
+  sp->sp_offs  = VEC_new(nstr | !nstr, VEC_stroff_t);
+  sp->sp_index = NULL;
+  sp->sp_ndist = 0;
+
+  if (flags & VEC_STRPOOL_INTERN) {
+    for (cap = STRPOOL_MININDEX; cap < 2*nstr; cap <<= 1)
+      PASS;
+    sp->sp_index = VEC_new(cap, VEC_stroff_t);
+    VEC_vusedSet(sp->sp_index, cap);
+  }
+}
+
+__NONNULL__ void VEC_strpoolDestroy(VEC_strpool *sp) {
+  VEC_destroy(sp->sp_bytes);
+  VEC_destroy(sp->sp_offs);
+  VEC_destroy(sp->sp_index);
+  sp->sp_ndist = 0;
+}
+
+__NONNULL__ vsize_t VEC_strpoolPush(VEC_strpool *sp, const char *s, size_t len) {
+  /* Append string s of len bytes; returns its index */
+
+  VEC_stroff_t off, *slot, lenv;
+  const vsize_t id = VEC_used(sp->sp_offs);
+  const bool own = strpoolOwns(sp, s);
+  const vsize_t at = own ? (vsize_t)(s - sp->sp_bytes) : 0;
+
+  slot = NULL;
+  if (sp->sp_index != NULL) {
+    if (((sp->sp_ndist + 1) << 1) > VEC_used(sp->sp_index))
+      strpoolRehash(sp, VEC_used(sp->sp_index) << 1);
+
+    slot = strpoolSlot(sp, s, len, MvpgInclude_Hash64(s, len, STRPOOL_SEED));
+    if (*slot) {
+      /* Interned: share the first copy */
+      off = sp->sp_offs[*slot - 1];
+      VEC_push(sp->sp_offs, off);
+
+      return id;
+    }
+  }
+
+  strpoolReserve(&sp->sp_bytes, VEC_STRPOOL_HDR + len + 1);
+  if (own)
+    s = sp->sp_bytes + at;
+  VEC_assert((VEC_used(sp->sp_bytes) + VEC_STRPOOL_HDR + len) < VEC_STROFF_MAX, "VEC_strpool: offset overflow (see VEC_STRPOOL_WIDE)");
+
+  lenv = len;
+  off  = VEC_used(sp->sp_bytes) + VEC_STRPOOL_HDR;
+  memcpy(sp->sp_bytes + off - VEC_STRPOOL_HDR, &lenv, VEC_STRPOOL_HDR);
+  memcpy(sp->sp_bytes + off, s, len);
+  sp->sp_bytes[off + len] = 0;
+  VEC_vusedSet(sp->sp_bytes, off + len + 1);
+
+  VEC_push(sp->sp_offs, off);
+  if (slot != NULL) {
+    *slot = id + 1;
+    sp->sp_ndist++;
+  }
+  return id;
+}
+
+__NONNULL__ vsize_t VEC_strpoolPushN(VEC_strpool *sp, const char *const *s, const size_t *lens, vsize_t n) {
+  /* Append n strings (lens may be NULL for nul-terminated strings); returns the index of the first.
+   * Space for all of them is reserved once, so that no string allocates. A string of the pool is found again by its offset
+   * in the byte vector as it was on entry, since the reserve moves it.
+   */
+  const uintptr_t base = (uintptr_t)sp->sp_bytes, end = (uintptr_t)(sp->sp_bytes + VEC_used(sp->sp_bytes));
+  const char *p;
+  vsize_t i, total;
+  size_t len;
+
+  for (i = total = 0; i < n; i++)
+    total += VEC_STRPOOL_HDR + (lens ? lens[i] : strlen(s[i])) + 1;
+
+  strpoolReserve(&sp->sp_bytes, total);
+  if (VEC_free(sp->sp_offs) < n)
+    sp->sp_offs = VEC_INTERNAL_resize(sp->sp_offs, n);
+  if ((sp->sp_index != NULL) && (((sp->sp_ndist + n) << 1) > VEC_used(sp->sp_index))) {
+    for (total = VEC_used(sp->sp_index); total < ((sp->sp_ndist + n) << 1); total <<= 1)
+      PASS;
+    strpoolRehash(sp, total);
+  }
+
+  for (i = 0; i < n; i++) {
+    p   = (((uintptr_t)s[i] >= base) && ((uintptr_t)s[i] < end)) ? sp->sp_bytes + ((uintptr_t)s[i] - base) : s[i];
+    len = lens ? lens[i] : strlen(p);
+    VEC_strpoolPush(sp, p, len);
+  }
+  return VEC_used(sp->sp_offs) - n;
+}
+
+__NONNULL__ long VEC_strpoolFind(const VEC_strpool *sp, const char *s, size_t len) {
+  /* Index of the first string equal to s, or -1. Linear without interning */
+
+  VEC_stroff_t *slot;
+  vsize_t i;
+
+  if (sp->sp_index != NULL) {
+    slot = strpoolSlot(sp, s, len, MvpgInclude_Hash64(s, len, STRPOOL_SEED));
+    return (long)*slot - 1;
+  }
+
+  for (i = 0; i < VEC_used(sp->sp_offs); i++)
+    if ((VEC_strpoolLenAt(sp, sp->sp_offs[i]) == len) && !memcmp(sp->sp_bytes + sp->sp_offs[i], s, len))
+      return i;
+  return -1;
+}
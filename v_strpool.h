@@ -0,0 +1,81 @@
+/* MVPG API Vector Type: String Pool
+Copyright (C) 2025 Michael Saviour
+
+This program is free software: you can redistribute it and/or modify it under the terms of the GNU General Public License as published by the Free Software Foundation, either version 3 of the License, or (at your option) any later version.
+
+This program is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License along with this program. If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef V_STRPOOL_H
+#define V_STRPOOL_H
+
+#include "v_base.h"
+
+/*                    VEC_strpool (CONTIGUOUS STRING VECTOR)
+ *
+ * All strings live in one growing byte vector (sp_bytes); string i starts at sp_bytes + sp_offs[i].
+ * Each string is stored as [length][bytes]['\0'], so that a string is read without strlen and is still a C string.
+ *
+ * With interning (sp_index != NULL), a duplicate string is not stored again: its offset entry refers to the first copy,
+ * so it costs sizeof(VEC_stroff_t) bytes. sp_index is an open-addressing table of offsets (0 is an empty slot).
+ *
+ * Offsets are 32 bits, which limits the byte vector to 4GB. Define VEC_STRPOOL_WIDE for 64 bits offsets.
+ */
+
+#ifndef VEC_STRPOOL_WIDE
+typedef uint32_t VEC_stroff_t;
+    #define VEC_STROFF_MAX UINT32_MAX
+#else
+typedef uint64_t VEC_stroff_t;
+    #define VEC_STROFF_MAX UINT64_MAX
+#endif
+
+typedef struct {
+  VEC_type(char)         sp_bytes; /* String bytes */
+  VEC_type(VEC_stroff_t) sp_offs;  /* Offset of each string in sp_bytes */
+  VEC_type(VEC_stroff_t) sp_index; /* Intern table (NULL if interning is disabled) */
+  vsize_t                sp_ndist; /* Distinct strings in sp_index */
+} VEC_strpool;
+
+#define VEC_STRPOOL_INTERN 0x01
+
+/* Length prefix of each string */
+#define VEC_STRPOOL_HDR sizeof(VEC_stroff_t)
+
+void    VEC_strpoolInit    (VEC_strpool *sp, vsize_t nstr, vsize_t nbytes, uint8_t flags);
+void    VEC_strpoolDestroy (VEC_strpool *sp);
+vsize_t VEC_strpoolPush    (VEC_strpool *sp, const char *s, size_t len);
+vsize_t VEC_strpoolPushN   (VEC_strpool *sp, const char *const *s, const size_t *lens, vsize_t n);
+long    VEC_strpoolFind    (const VEC_strpool *sp, const char *s, size_t len);
+
+#define VEC_strpoolSize(SP)			\
+  VEC_used((SP)->sp_offs)
+
+#define VEC_strpoolBytes(SP)			\
+  VEC_used((SP)->sp_bytes)
+
+__STATIC_FORCE_INLINE_F __NONNULL__ size_t VEC_strpoolLenAt(const VEC_strpool *sp, VEC_stroff_t off) {
+  VEC_stroff_t len;
+
+  memcpy(&len, sp->sp_bytes + off - VEC_STRPOOL_HDR, VEC_STRPOOL_HDR);
+  return len;
+}
+
+/* String i and its length (len may be NULL) */
+__STATIC_FORCE_INLINE_F __NONNULL__ const char *VEC_strpoolGet(const VEC_strpool *sp, vsize_t i, size_t *len) {
+  VEC_assert(i < VEC_used(sp->sp_offs), "VEC_strpool: index out of range");
+
+  if (len != NULL)
+    *len = VEC_strpoolLenAt(sp, sp->sp_offs[i]);
+  return sp->sp_bytes + sp->sp_offs[i];
+}
+
+/* Iterate strings: S (const char *) and L (size_t) are declared by the loop */
+#define VEC_strpoolForeach(S, L, SP)					\
+  for (vsize_t I_ = 0; I_ < VEC_strpoolSize(SP); I_++)			\
+    for (size_t L = VEC_strpoolLenAt(SP, (SP)->sp_offs[I_]), K_ = 1; K_; K_ = 0) \
+      for (const char *S = (SP)->sp_bytes + (SP)->sp_offs[I_]; K_; K_ = 0)
+
+#endif /* V_STRPOOL_H */